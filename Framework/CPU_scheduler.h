@@ -10,7 +10,7 @@
  * 2. SJF:  Burst time → Arrival time → Process ID  
  * 3. SRT:  Remaining time → Arrival time → Process ID
  * 4. Priority: Priority value → Arrival time → Process ID
- * 5. Round Robin: Process order in array (no tie-breaking needed)
+ * 5. Round Robin: Arrival time → Process ID (queue order, no reordering of the array)
  * 
  * ===============================================================================
  */
@@ -23,9 +23,10 @@
 #include <string.h>
 #include <stdbool.h>
 #include <limits.h>
+#include <stdint.h>
 
-// Max allowed processess
-#define MAX_PROCESSES 100
+// Initial capacity of the process store (grown by doubling as rows are added)
+#define INITIAL_PROCESS_CAPACITY 64
 
 /* ========================================================================================*/
 // Structure to store process information
@@ -36,30 +37,80 @@ typedef struct
     int burst_time;
     int arrival_time;
     int remaining_time;
-    int waiting_time;
-    int turnaround_time;
-    int completion_time;
+    long long waiting_time;     // Times are 64-bit: Σ burst can exceed INT_MAX
+    long long turnaround_time;
+    long long completion_time;
+    long long start_time;       // First time the process got the CPU, -1 before that
     bool is_completed;
 } Process;
 
+/* ========================================================================================*/
+// display_results options (SchedulerContext.report_flags)
+#define REPORT_TAIL_METRICS 0x1u    // Also print waiting time percentiles and max response time
+#define REPORT_SUMMARY_ONLY 0x2u    // Skip the per-process rows, print the averages only
+#define REPORT_SWITCH_STATS 0x4u    // Also print context switches, switch overhead and CPU utilization
+
+// display_results output layouts (see result_writer.h)
+typedef enum
+{
+    RESULT_FORMAT_TEXT,     // Fixed-width table (autograder format)
+    RESULT_FORMAT_CSV,
+    RESULT_FORMAT_NDJSON,
+    RESULT_FORMAT_BINARY
+} ResultFormat;
+
+/* ========================================================================================*/
+// Reusable per-thread engine buffers (defined in scheduler_scratch.h)
+typedef struct SchedulerScratch SchedulerScratch;
+
+// Execution trace recorder (defined in trace_recorder.c)
+typedef struct TraceRecorder TraceRecorder;
+
+// Read-only mapping of a binary workload file (defined in workload_binary.h)
+typedef struct MappedWorkload MappedWorkload;
+
+// Averages and statistics of one run (defined in schedule_metrics.h)
+typedef struct ScheduleMetrics ScheduleMetrics;
+
 /* ========================================================================================*/
 // Structure to hold scheduler context 
 typedef struct
 {
-    Process processes[MAX_PROCESSES];
-    int num_processes;
+    Process *processes;     // Heap-allocated process store
+    int num_processes;      // Number of processes currently stored
+    int capacity;           // Number of slots allocated in processes[]
+    int *arrival_order;     // Cached arrival index (see get_arrival_order), NULL until built
+    MappedWorkload *mapped_input;   // Binary workload the input fields are read from, NULL = the rows
+    bool rows_pending;      // processes[] not filled from mapped_input yet (see materialize_process_rows)
+    FILE *output;           // Stream display_results writes to (stdout by default, NULL = quiet)
+    SchedulerScratch *scratch;  // Optional buffers reused across runs, NULL = allocate per run
+    int num_threads;        // Threads the metrics pass may use (1 = serial)
+    unsigned report_flags;  // REPORT_* options of display_results
+    ResultFormat output_format; // Layout display_results writes
+    TraceRecorder *trace;   // Receives the engines' TRACE_POINT events, NULL = off
+    int switch_cost;        // Time charged per context switch (0 = free switches)
+    int warmup_cost;        // Extra time charged when a process that already ran resumes
+    long long num_switches;     // Context switches of the last run (see charge_context_switch)
+    long long switch_overhead;  // Time the last run spent switching
+    char *report_buffer;    // display_results' formatting buffer, allocated by the first report
+    bool output_failed;     // A display_results report could not be written to output
+    ScheduleMetrics *last_metrics;  // Receives the metrics display_results computed, NULL = not kept
 } SchedulerContext;
 
 /* ========================================================================================*/
 // Core utility function prototypes
+bool read_processes_from_stdin(SchedulerContext *ctx);
 bool read_processes_from_file(const char *filename, SchedulerContext *ctx);
 void reset_process_states(SchedulerContext *ctx);
 bool validate_input_data(const SchedulerContext *ctx);
 void calculate_turnaround_times(SchedulerContext *ctx);
 void calculate_average_times(const SchedulerContext *ctx);
-void display_results(const SchedulerContext *ctx, const char *algorithm_name);
+void compute_average_times(const SchedulerContext *ctx, double *avg_turnaround, double *avg_waiting);
+bool display_results(SchedulerContext *ctx, const char *algorithm_name);
 void clear_input_buffer(void);
 int min_value(int a, int b);
+int charge_context_switch(SchedulerContext *ctx, bool resumed);
+long long schedule_horizon(const SchedulerContext *ctx, long long cost_per_switch);
 
 /* ========================================================================================*/
 // Scheduling algorithm function prototypes
@@ -70,8 +121,43 @@ void round_robin(SchedulerContext *ctx, int time_quantum);
 void priority_non_preemptive(SchedulerContext *ctx);
 void priority_preemptive_rr(SchedulerContext *ctx, int time_quantum);
 
+// The core engines in report order
+typedef enum
+{
+    ALGORITHM_FCFS,
+    ALGORITHM_SJF,
+    ALGORITHM_SRTF,
+    ALGORITHM_RR,
+    ALGORITHM_PRIORITY_NP,
+    ALGORITHM_PRIORITY_RR,
+    NUM_ALGORITHMS
+} AlgorithmId;
+
+// One engine of a report: short name, display_results() title and adapter
+typedef struct
+{
+    const char *name;
+    const char *title;
+    bool uses_quantum;
+    void (*run)(SchedulerContext *ctx, int time_quantum);
+} AlgorithmEntry;
+
+// Algorithm table (algorithms.c), indexed by AlgorithmId
+extern const AlgorithmEntry SCHEDULER_ALGORITHMS[NUM_ALGORITHMS];
+void run_first_come_first_served(SchedulerContext *ctx, int time_quantum);
+void run_shortest_job_first(SchedulerContext *ctx, int time_quantum);
+void run_shortest_remaining_time_first(SchedulerContext *ctx, int time_quantum);
+void run_priority_non_preemptive(SchedulerContext *ctx, int time_quantum);
+
 /* ========================================================================================*/
 // Helper function prototypes for modular design
 void init_scheduler_context(SchedulerContext *ctx);
+void free_scheduler_context(SchedulerContext *ctx);
+bool clone_scheduler_context(SchedulerContext *dst, const SchedulerContext *src);
+bool reserve_process_capacity(SchedulerContext *ctx, int capacity);
+Process *append_process(SchedulerContext *ctx);
+void *scheduler_alloc(size_t count, size_t size);
+const int *get_arrival_order(SchedulerContext *ctx);
+void materialize_process_rows(SchedulerContext *ctx);
 
 #endif // SCHEDULER_H
\ No newline at end of file
@@ -0,0 +1,55 @@
+/**
+ * ===============================================================================
+ * ALGORITHM TABLE
+ * ===============================================================================
+ * @file algorithms.c
+ * @brief The six core engines behind one (ctx, time_quantum) signature
+ *
+ * The default report, the partitioned runner, the benchmark and the
+ * differential harness all run the engines through this table, and the
+ * engines report under its titles, so a name or title is defined only here.
+ * ===============================================================================
+ */
+
+#include "CPU_scheduler.h"
+
+/* ========================================================================================*/
+/* ADAPTERS */
+/* ========================================================================================*/
+
+void run_first_come_first_served(SchedulerContext *ctx, int time_quantum)
+{
+    (void)time_quantum;
+    first_come_first_served(ctx);
+}
+
+void run_shortest_job_first(SchedulerContext *ctx, int time_quantum)
+{
+    (void)time_quantum;
+    shortest_job_first(ctx);
+}
+
+void run_shortest_remaining_time_first(SchedulerContext *ctx, int time_quantum)
+{
+    (void)time_quantum;
+    shortest_remaining_time_first(ctx);
+}
+
+void run_priority_non_preemptive(SchedulerContext *ctx, int time_quantum)
+{
+    (void)time_quantum;
+    priority_non_preemptive(ctx);
+}
+
+/* ========================================================================================*/
+/* TABLE */
+/* ========================================================================================*/
+
+const AlgorithmEntry SCHEDULER_ALGORITHMS[NUM_ALGORITHMS] = {
+    [ALGORITHM_FCFS] = {"FCFS", "First-Come-First-Served (FCFS)", false, run_first_come_first_served},
+    [ALGORITHM_SJF] = {"SJF", "Shortest-Job-First (SJF)", false, run_shortest_job_first},
+    [ALGORITHM_SRTF] = {"SRTF", "Shortest-Remaining_Time-First (SRTF)", false, run_shortest_remaining_time_first},
+    [ALGORITHM_RR] = {"RR", "Round-Robin (RR)", true, round_robin},
+    [ALGORITHM_PRIORITY_NP] = {"PRIORITY_NP", "PRIORITY_NON_PREEMPTIVE", false, run_priority_non_preemptive},
+    [ALGORITHM_PRIORITY_RR] = {"PRIORITY_RR", "PRIORITY_PREEMPTIVE_WITH_RR", true, priority_preemptive_rr},
+};
@@ -0,0 +1,489 @@
+/**
+ * ===============================================================================
+ * BATCH RUNNER
+ * ===============================================================================
+ * @file batch_runner.c
+ * @brief Manifest/directory pipeline: parse and simulate on workers, format in order
+ *
+ * Every file is a BatchItem that moves PENDING → LOADING → LOADED → RUNNING →
+ * DONE under one mutex. Workers prefer simulating the oldest loaded file over
+ * parsing a new one, so the format stage (which consumes files in order) is
+ * fed first; parsing only runs ahead while the window has room.
+ * ===============================================================================
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "batch_runner.h"
+#include "scheduler_scratch.h"
+#include "result_writer.h"
+
+/* ========================================================================================*/
+// Pipeline stage of one file
+typedef enum
+{
+    BATCH_PENDING,
+    BATCH_LOADING,
+    BATCH_LOADED,
+    BATCH_RUNNING,
+    BATCH_DONE
+} BatchState;
+
+// One workload file and what the stages produced for it
+typedef struct
+{
+    char *path;
+    BatchState state;
+    bool ok;                    // Parsed and simulated (report is valid)
+    SchedulerContext ctx;       // Between parse and the end of simulate
+    char *report;               // Captured output of all algorithms
+    size_t report_size;
+    int num_processes;
+    double *averages;           // Average TAT, WT per algorithm
+} BatchItem;
+
+// Shared pipeline state
+typedef struct
+{
+    const BatchOptions *options;
+    BatchItem *items;
+    int num_items;
+    int next_load;              // First file not yet claimed by the parse stage
+    int next_write;             // First file not yet formatted
+    int window;                 // Files allowed between parse and format
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+} BatchPipeline;
+
+/* ========================================================================================*/
+/* FILE LIST */
+/* ========================================================================================*/
+
+static char *join_path(const char *dir, size_t dir_length, const char *name)
+{
+    size_t name_length = strlen(name);
+    char *path = scheduler_alloc(dir_length + name_length + 2, 1);
+    memcpy(path, dir, dir_length);
+    path[dir_length] = '/';
+    memcpy(path + dir_length + 1, name, name_length + 1);
+    return path;
+}
+
+/* ========================================================================================*/
+
+static void append_path(char ***paths, int *count, int *capacity, char *path)
+{
+    if (*count == *capacity)
+    {
+        *capacity = (*capacity > 0) ? *capacity * 2 : 64;
+        char **grown = realloc(*paths, (size_t)*capacity * sizeof(char *));
+        if (grown == NULL)
+        {
+            fprintf(stderr, "Error: Out of memory.\n");
+            exit(EXIT_FAILURE);
+        }
+        *paths = grown;
+    }
+    (*paths)[(*count)++] = path;
+}
+
+/* ========================================================================================*/
+
+static int compare_paths(const void *lhs, const void *rhs)
+{
+    return strcmp(*(char *const *)lhs, *(char *const *)rhs);
+}
+
+/* ========================================================================================*/
+
+static bool list_directory(const char *dir, char ***paths, int *count)
+{
+    DIR *handle = opendir(dir);
+    if (handle == NULL)
+    {
+        fprintf(stderr, "Error: Cannot open directory '%s': %s.\n", dir, strerror(errno));
+        return false;
+    }
+
+    int capacity = 0;
+    struct dirent *entry;
+    while ((entry = readdir(handle)) != NULL)
+    {
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+        char *path = join_path(dir, strlen(dir), entry->d_name);
+        struct stat info;
+        if (stat(path, &info) != 0 || !S_ISREG(info.st_mode))
+        {
+            free(path);
+            continue;
+        }
+        append_path(paths, count, &capacity, path);
+    }
+    closedir(handle);
+
+    if (*count > 1)
+    {
+        qsort(*paths, (size_t)*count, sizeof(char *), compare_paths);
+    }
+    return true;
+}
+
+/* ========================================================================================*/
+
+static bool read_manifest(const char *manifest, char ***paths, int *count)
+{
+    FILE *file = fopen(manifest, "r");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: Cannot open manifest '%s': %s.\n", manifest, strerror(errno));
+        return false;
+    }
+
+    // Relative entries are resolved against the manifest's directory
+    const char *slash = strrchr(manifest, '/');
+    size_t dir_length = (slash != NULL) ? (size_t)(slash - manifest) : 0;
+
+    int capacity = 0;
+    char *line = NULL;
+    size_t line_capacity = 0;
+    ssize_t length;
+    while ((length = getline(&line, &line_capacity, file)) >= 0)
+    {
+        char *start = line;
+        while (*start == ' ' || *start == '\t')
+        {
+            start++;
+        }
+        char *end = line + length;
+        while (end > start && (end[-1] == '\n' || end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t'))
+        {
+            end--;
+        }
+        *end = '\0';
+        if (*start == '\0' || *start == '#')
+        {
+            continue;
+        }
+
+        char *path;
+        if (*start == '/' || slash == NULL)
+        {
+            path = scheduler_alloc((size_t)(end - start) + 1, 1);
+            memcpy(path, start, (size_t)(end - start) + 1);
+        }
+        else
+        {
+            path = join_path(manifest, dir_length, start);
+        }
+        append_path(paths, count, &capacity, path);
+    }
+    free(line);
+    fclose(file);
+    return true;
+}
+
+/* ========================================================================================*/
+/* STAGES */
+/* ========================================================================================*/
+
+// Parse stage: the file becomes a validated context with its arrival index built
+static void parse_item(const BatchOptions *options, BatchItem *item)
+{
+    SchedulerContext *ctx = &item->ctx;
+    init_scheduler_context(ctx);
+    ctx->report_flags = options->report_flags;
+    ctx->output_format = options->output_format;
+    ctx->switch_cost = options->switch_cost;
+    ctx->warmup_cost = options->warmup_cost;
+
+    item->ok = read_processes_from_file(item->path, ctx);
+    if (!item->ok)
+    {
+        fprintf(stderr, "Error: Invalid input data format in '%s'.\n", item->path);
+        free_scheduler_context(ctx);
+        return;
+    }
+    item->num_processes = ctx->num_processes;
+    get_arrival_order(ctx);
+}
+
+/* ========================================================================================*/
+
+// Simulate stage: every algorithm in report order into an in-memory report
+static void simulate_item(const BatchOptions *options, BatchItem *item)
+{
+    SchedulerContext *ctx = &item->ctx;
+    ctx->output = open_memstream(&item->report, &item->report_size);
+    if (ctx->output == NULL)
+    {
+        item->ok = false;
+        free_scheduler_context(ctx);
+        return;
+    }
+
+    // One scratch per file: the columns are shared by all of its algorithms
+    SchedulerScratch scratch;
+    init_scheduler_scratch(&scratch);
+    ctx->scratch = &scratch;
+
+    item->averages = scheduler_alloc((size_t)options->num_algorithms * 2, sizeof(double));
+    write_report_prologue(ctx->output, ctx->output_format);
+    for (int i = 0; i < options->num_algorithms; i++)
+    {
+        reset_scheduler_scratch(&scratch);
+        options->algorithms[i].run(ctx, options->time_quantum);
+        write_report_separator(ctx->output, ctx->output_format);
+        compute_average_times(ctx, &item->averages[2 * i], &item->averages[2 * i + 1]);
+    }
+
+    item->ok = (fclose(ctx->output) == 0) && !ctx->output_failed;
+    ctx->output = NULL;
+    ctx->scratch = NULL;
+    free_scheduler_scratch(&scratch);
+    free_scheduler_context(ctx);
+}
+
+/* ========================================================================================*/
+
+static void *batch_worker(void *arg)
+{
+    BatchPipeline *pipeline = arg;
+    pthread_mutex_lock(&pipeline->lock);
+    for (;;)
+    {
+        // The oldest loaded file first, so the format stage is never starved
+        int claimed = -1;
+        bool loading = false;
+        for (int i = pipeline->next_write; i < pipeline->next_load; i++)
+        {
+            BatchState state = pipeline->items[i].state;
+            loading |= (state == BATCH_LOADING);
+            if (state == BATCH_LOADED)
+            {
+                claimed = i;
+                break;
+            }
+        }
+
+        if (claimed >= 0)
+        {
+            BatchItem *item = &pipeline->items[claimed];
+            item->state = BATCH_RUNNING;
+            pthread_mutex_unlock(&pipeline->lock);
+            simulate_item(pipeline->options, item);
+            pthread_mutex_lock(&pipeline->lock);
+            item->state = BATCH_DONE;
+            pthread_cond_broadcast(&pipeline->changed);
+        }
+        else if (pipeline->next_load < pipeline->num_items &&
+                 pipeline->next_load - pipeline->next_write < pipeline->window)
+        {
+            BatchItem *item = &pipeline->items[pipeline->next_load++];
+            item->state = BATCH_LOADING;
+            pthread_mutex_unlock(&pipeline->lock);
+            parse_item(pipeline->options, item);
+            pthread_mutex_lock(&pipeline->lock);
+            item->state = item->ok ? BATCH_LOADED : BATCH_DONE;
+            pthread_cond_broadcast(&pipeline->changed);
+        }
+        else if (pipeline->next_load == pipeline->num_items && !loading)
+        {
+            break;
+        }
+        else
+        {
+            pthread_cond_wait(&pipeline->changed, &pipeline->lock);
+        }
+    }
+    pthread_mutex_unlock(&pipeline->lock);
+    return NULL;
+}
+
+/* ========================================================================================*/
+
+static const char *file_name(const char *path)
+{
+    const char *slash = strrchr(path, '/');
+    return (slash != NULL) ? slash + 1 : path;
+}
+
+/* ========================================================================================*/
+
+// Format stage: per-file report and summary row
+static bool format_item(const BatchOptions *options, const BatchItem *item, FILE *summary)
+{
+    if (!item->ok)
+    {
+        fprintf(summary, "%s,error,0", item->path);
+        for (int i = 0; i < options->num_algorithms; i++)
+        {
+            fprintf(summary, ",,");
+        }
+        fputc('\n', summary);
+        return false;
+    }
+
+    bool ok = true;
+    if (options->output_dir != NULL)
+    {
+        char *name = scheduler_alloc(strlen(file_name(item->path)) + 5, 1);
+        sprintf(name, "%s.out", file_name(item->path));
+        char *path = join_path(options->output_dir, strlen(options->output_dir), name);
+        FILE *output = fopen(path, "wb");
+        if (output == NULL || fwrite(item->report, 1, item->report_size, output) != item->report_size)
+        {
+            fprintf(stderr, "Error: Cannot write '%s': %s.\n", path, strerror(errno));
+            ok = false;
+        }
+        if (output != NULL && fclose(output) != 0)
+        {
+            ok = false;
+        }
+        free(path);
+        free(name);
+    }
+
+    fprintf(summary, "%s,%s,%d", item->path, ok ? "ok" : "error", item->num_processes);
+    for (int i = 0; i < options->num_algorithms; i++)
+    {
+        fprintf(summary, ",%.2f,%.2f", item->averages[2 * i], item->averages[2 * i + 1]);
+    }
+    fputc('\n', summary);
+    return ok;
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+/**
+ * Runs every file of options->source and writes the summary CSV. Returns false
+ * if the file list could not be read or any file failed; the other files are
+ * still processed.
+ */
+bool run_batch(const BatchOptions *options, FILE *summary)
+{
+    struct stat info;
+    if (stat(options->source, &info) != 0)
+    {
+        fprintf(stderr, "Error: Cannot open '%s': %s.\n", options->source, strerror(errno));
+        return false;
+    }
+
+    char **paths = NULL;
+    int num_items = 0;
+    bool listed = S_ISDIR(info.st_mode) ? list_directory(options->source, &paths, &num_items)
+                                        : read_manifest(options->source, &paths, &num_items);
+    if (!listed)
+    {
+        return false;
+    }
+    if (options->output_dir != NULL && mkdir(options->output_dir, 0777) != 0 && errno != EEXIST)
+    {
+        fprintf(stderr, "Error: Cannot create '%s': %s.\n", options->output_dir, strerror(errno));
+        for (int i = 0; i < num_items; i++)
+        {
+            free(paths[i]);
+        }
+        free(paths);
+        return false;
+    }
+
+    BatchPipeline pipeline;
+    pipeline.options = options;
+    pipeline.items = scheduler_alloc((size_t)(num_items > 0 ? num_items : 1), sizeof(BatchItem));
+    pipeline.num_items = num_items;
+    pipeline.next_load = 0;
+    pipeline.next_write = 0;
+    pipeline.window = BATCH_WINDOW_PER_THREAD * options->num_threads;
+    pthread_mutex_init(&pipeline.lock, NULL);
+    pthread_cond_init(&pipeline.changed, NULL);
+    for (int i = 0; i < num_items; i++)
+    {
+        pipeline.items[i].path = paths[i];
+        pipeline.items[i].state = BATCH_PENDING;
+    }
+    free(paths);
+
+    int num_workers = (options->num_threads < num_items) ? options->num_threads : num_items;
+    pthread_t *workers = scheduler_alloc((size_t)(num_workers > 0 ? num_workers : 1), sizeof(pthread_t));
+    int started = 0;
+    for (; started < num_workers; started++)
+    {
+        if (pthread_create(&workers[started], NULL, batch_worker, &pipeline) != 0)
+        {
+            break;
+        }
+    }
+    if (started == 0 && num_items > 0)
+    {
+        // No thread could be started: run the stages on this thread, unbounded
+        pipeline.window = num_items;
+        batch_worker(&pipeline);
+    }
+
+    fprintf(summary, "file,status,processes");
+    for (int i = 0; i < options->num_algorithms; i++)
+    {
+        fprintf(summary, ",%s_avg_tat,%s_avg_wt", options->algorithms[i].name, options->algorithms[i].name);
+    }
+    fputc('\n', summary);
+
+    int failed = 0;
+    long long total_processes = 0;
+    double *weighted = scheduler_alloc((size_t)options->num_algorithms * 2, sizeof(double));
+    for (int i = 0; i < num_items; i++)
+    {
+        BatchItem *item = &pipeline.items[i];
+        pthread_mutex_lock(&pipeline.lock);
+        while (item->state != BATCH_DONE)
+        {
+            pthread_cond_wait(&pipeline.changed, &pipeline.lock);
+        }
+        pthread_mutex_unlock(&pipeline.lock);
+
+        if (format_item(options, item, summary))
+        {
+            total_processes += item->num_processes;
+            for (int k = 0; k < options->num_algorithms * 2; k++)
+            {
+                weighted[k] += item->averages[k] * item->num_processes;
+            }
+        }
+        else
+        {
+            failed++;
+        }
+        free(item->report);
+        free(item->averages);
+        free(item->path);
+
+        pthread_mutex_lock(&pipeline.lock);
+        pipeline.next_write++;
+        pthread_cond_broadcast(&pipeline.changed);
+        pthread_mutex_unlock(&pipeline.lock);
+    }
+
+    fprintf(summary, "ALL,%s,%lld", (failed == 0) ? "ok" : "error", total_processes);
+    for (int k = 0; k < options->num_algorithms * 2; k++)
+    {
+        fprintf(summary, ",%.2f", (total_processes > 0) ? weighted[k] / (double)total_processes : 0.0);
+    }
+    fputc('\n', summary);
+    fprintf(stderr, "Batch: %d file%s, %d failed\n", num_items, (num_items == 1) ? "" : "s", failed);
+
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+    free(weighted);
+    free(pipeline.items);
+    pthread_cond_destroy(&pipeline.changed);
+    pthread_mutex_destroy(&pipeline.lock);
+    return failed == 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * ===============================================================================
+ * BATCH RUNNER HEADER FILE
+ * ===============================================================================
+ *
+ * Schedules many workload files in one process instead of one ./scheduler
+ * launch per testcase. The files come from a manifest (one path per line,
+ * blank lines and '#' comments skipped, relative paths taken from the
+ * manifest's directory) or from a directory (every regular file not starting
+ * with '.', in name order).
+ *
+ * The files flow through a three-stage pipeline:
+ *
+ * 1. Parse:    read and validate the file, build the arrival index
+ * 2. Simulate: run every algorithm, capturing the report in memory
+ * 3. Format:   write the report to OUTPUT_DIR/<file name>.out and the
+ *              file's row of the summary, in manifest order
+ *
+ * Worker threads pick up parse and simulate work; the calling thread is the
+ * format stage. At most BATCH_WINDOW_PER_THREAD files per worker are between
+ * parse and format at any time, which bounds memory on large batches.
+ *
+ * The summary is CSV on stdout: one row per file with the average TAT and
+ * WT of every algorithm, then an ALL row weighted by process count.
+ *
+ * ===============================================================================
+ */
+
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include "CPU_scheduler.h"
+
+#define BATCH_WINDOW_PER_THREAD 2
+
+/* ========================================================================================*/
+// Structure to hold the batch settings
+typedef struct
+{
+    const char *source;                 // Manifest file or directory
+    const char *output_dir;             // Per-file reports, NULL = summary only
+    int num_threads;                    // Parse/simulate workers
+    const AlgorithmEntry *algorithms;   // Engines in report order
+    int num_algorithms;
+    int time_quantum;
+    unsigned report_flags;              // Report settings of every file's context
+    ResultFormat output_format;
+    int switch_cost;
+    int warmup_cost;
+} BatchOptions;
+
+/* ========================================================================================*/
+// Batch function prototypes
+bool run_batch(const BatchOptions *options, FILE *summary);
+
+#endif // BATCH_RUNNER_H
@@ -0,0 +1,403 @@
+/**
+ * ===============================================================================
+ * SCHEDULER BENCHMARK
+ * ===============================================================================
+ * @file bench.c
+ * @brief Scaling curves of the six schedulers over workload size and quantum
+ *
+ * Every (size, algorithm, quantum) point runs in a forked child, so the peak
+ * RSS reported for a point is that of its own workload and engine buffers.
+ * The child generates the workload (see workload_generator.h), does one
+ * untimed warm-up run and then times the requested number of repetitions with
+ * output disabled, i.e. the engine plus the metrics pass of display_results().
+ * The parent prints a table and appends one CSV row per point to --csv, tagged
+ * with --label (make bench passes the git revision) so runs of different
+ * commits can be compared from the same file.
+ * ===============================================================================
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "CPU_scheduler.h"
+#include "workload_generator.h"
+
+#define BENCH_MAX_REPS 100
+#define BENCH_MAX_VALUES 32
+
+static const char BENCH_CSV_HEADER[] =
+    "label,algorithm,quantum,num_processes,repetitions,median_ns,mean_ns,stddev_ns,min_ns,max_ns,"
+    "ns_per_job,jobs_per_second,peak_rss_kb\n";
+
+/* ========================================================================================*/
+// What a child reports back through its pipe
+typedef struct
+{
+    bool ok;
+    int repetitions;
+    double elapsed_ns[BENCH_MAX_REPS];
+    long peak_rss_kb;
+} BenchSample;
+
+// Structure to hold the benchmark settings
+typedef struct
+{
+    long long sizes[BENCH_MAX_VALUES];
+    int num_sizes;
+    long long quanta[BENCH_MAX_VALUES];
+    int num_quanta;
+    int repetitions;
+    const char *label;
+    const char *csv_path;       // NULL = table only
+    GeneratorConfig generator;
+} BenchOptions;
+
+/* ========================================================================================*/
+/* MEASUREMENT */
+/* ========================================================================================*/
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* ========================================================================================*/
+
+// Child side of one point: generate, warm up, time
+static void measure_point(const BenchOptions *options, const AlgorithmEntry *algorithm, long long size,
+                          int quantum, BenchSample *sample)
+{
+    memset(sample, 0, sizeof(*sample));
+
+    GeneratorConfig generator = options->generator;
+    generator.num_processes = size;
+
+    SchedulerContext ctx;
+    init_scheduler_context(&ctx);
+    ctx.output = NULL;
+    if (!generate_processes(&generator, &ctx))
+    {
+        free_scheduler_context(&ctx);
+        return;
+    }
+
+    algorithm->run(&ctx, quantum);
+    for (int rep = 0; rep < options->repetitions; rep++)
+    {
+        double start = now_ns();
+        algorithm->run(&ctx, quantum);
+        sample->elapsed_ns[rep] = now_ns() - start;
+    }
+    free_scheduler_context(&ctx);
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    sample->peak_rss_kb = usage.ru_maxrss;
+    sample->repetitions = options->repetitions;
+    sample->ok = true;
+}
+
+/* ========================================================================================*/
+
+// Runs measure_point in a child process and collects its sample
+static bool run_point(const BenchOptions *options, const AlgorithmEntry *algorithm, long long size,
+                      int quantum, BenchSample *sample)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        fprintf(stderr, "Error: Cannot create a pipe: %s.\n", strerror(errno));
+        return false;
+    }
+
+    fflush(stdout);
+    pid_t child = fork();
+    if (child < 0)
+    {
+        fprintf(stderr, "Error: Cannot fork: %s.\n", strerror(errno));
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (child == 0)
+    {
+        close(fds[0]);
+        BenchSample result;
+        measure_point(options, algorithm, size, quantum, &result);
+        bool sent = write(fds[1], &result, sizeof(result)) == (ssize_t)sizeof(result);
+        _exit(sent ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    close(fds[1]);
+    size_t received = 0;
+    while (received < sizeof(*sample))
+    {
+        ssize_t got = read(fds[0], (char *)sample + received, sizeof(*sample) - received);
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            break;
+        }
+        received += (size_t)got;
+    }
+    close(fds[0]);
+
+    int status = 0;
+    while (waitpid(child, &status, 0) < 0 && errno == EINTR)
+    {
+    }
+    if (received != sizeof(*sample) || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS || !sample->ok)
+    {
+        fprintf(stderr, "Error: %s on %lld jobs failed (workload generation or out of memory).\n",
+                algorithm->name, size);
+        return false;
+    }
+    return true;
+}
+
+/* ========================================================================================*/
+/* REPORTING */
+/* ========================================================================================*/
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* ========================================================================================*/
+
+static void report_point(const BenchOptions *options, FILE *csv, const AlgorithmEntry *algorithm,
+                         long long size, int quantum, BenchSample *sample)
+{
+    int reps = sample->repetitions;
+    double *t = sample->elapsed_ns;
+    qsort(t, (size_t)reps, sizeof(double), compare_doubles);
+
+    double mean = 0.0;
+    for (int i = 0; i < reps; i++)
+    {
+        mean += t[i];
+    }
+    mean /= reps;
+    double variance = 0.0;
+    for (int i = 0; i < reps; i++)
+    {
+        variance += (t[i] - mean) * (t[i] - mean);
+    }
+    double stddev = (reps > 1) ? sqrt(variance / (reps - 1)) : 0.0;
+    double median = (reps % 2 != 0) ? t[reps / 2] : (t[reps / 2 - 1] + t[reps / 2]) / 2.0;
+    double ns_per_job = (size > 0) ? median / (double)size : 0.0;
+    double jobs_per_second = (median > 0.0) ? (double)size * 1e9 / median : 0.0;
+
+    char quantum_text[16];
+    snprintf(quantum_text, sizeof(quantum_text), algorithm->uses_quantum ? "%d" : "-", quantum);
+    printf("%-13s%-9s%-11lld%-13.3f%-10.1f%-11.1f%-15.0f%.1f\n", algorithm->name, quantum_text, size,
+           median / 1e6, (mean > 0.0) ? 100.0 * stddev / mean : 0.0, ns_per_job, jobs_per_second,
+           (double)sample->peak_rss_kb / 1024.0);
+
+    if (csv != NULL)
+    {
+        fprintf(csv, "%s,%s,%d,%lld,%d,%.0f,%.0f,%.0f,%.0f,%.0f,%.3f,%.0f,%ld\n", options->label, algorithm->name,
+                algorithm->uses_quantum ? quantum : 0, size, reps, median, mean, stddev, t[0], t[reps - 1],
+                ns_per_job, jobs_per_second, sample->peak_rss_kb);
+        fflush(csv);
+    }
+}
+
+/* ========================================================================================*/
+/* COMMAND LINE OPTIONS */
+/* ========================================================================================*/
+
+static void print_usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --sizes=N,...    Workload sizes (default: 100,1000,...,10000000)\n"
+            "  --quanta=Q,...   Time quanta of RR and PRIORITY_RR (default: 1,3,10)\n"
+            "  --reps=N         Timed repetitions per point, after one warm-up run (default: 5)\n"
+            "  --label=TEXT     Value of the label column, e.g. the git revision (default: local)\n"
+            "  --csv=FILE       Append one row per point to FILE (header if it is new)\n"
+            "  --seed=S, --arrivals=MODEL, --bursts=MODEL, --priorities=W0,W1,...\n"
+            "                   Workload generator settings, as for scheduler --generate\n"
+            "  --help           Show this message\n",
+            program);
+}
+
+/* ========================================================================================*/
+
+// Comma-separated positive integers up to max
+static bool parse_value_list(const char *spec, long long max, long long *values, int *count)
+{
+    *count = 0;
+    const char *p = spec;
+    for (;;)
+    {
+        char *end = NULL;
+        errno = 0;
+        long long value = strtoll(p, &end, 10);
+        if (end == p || errno != 0 || value < 1 || value > max || *count == BENCH_MAX_VALUES)
+        {
+            return false;
+        }
+        values[(*count)++] = value;
+        if (*end == '\0')
+        {
+            return true;
+        }
+        if (*end != ',')
+        {
+            return false;
+        }
+        p = end + 1;
+    }
+}
+
+/* ========================================================================================*/
+
+static bool parse_bench_options(int argc, char *argv[], BenchOptions *options)
+{
+    options->num_sizes = 0;
+    for (long long size = 100; size <= 10000000; size *= 10)
+    {
+        options->sizes[options->num_sizes++] = size;
+    }
+    options->num_quanta = 3;
+    options->quanta[0] = 1;
+    options->quanta[1] = 3;
+    options->quanta[2] = 10;
+    options->repetitions = 5;
+    options->label = "local";
+    options->csv_path = NULL;
+    generator_config_init(&options->generator);
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        bool valid = true;
+        if (strncmp(arg, "--sizes=", 8) == 0)
+        {
+            valid = parse_value_list(arg + 8, INT_MAX, options->sizes, &options->num_sizes);
+        }
+        else if (strncmp(arg, "--quanta=", 9) == 0)
+        {
+            valid = parse_value_list(arg + 9, INT_MAX, options->quanta, &options->num_quanta);
+        }
+        else if (strncmp(arg, "--reps=", 7) == 0)
+        {
+            long long reps;
+            int count;
+            valid = parse_value_list(arg + 7, BENCH_MAX_REPS, &reps, &count) && count == 1;
+            options->repetitions = (int)reps;
+        }
+        else if (strncmp(arg, "--label=", 8) == 0)
+        {
+            options->label = arg + 8;
+            valid = strpbrk(options->label, ",\"\n") == NULL;
+        }
+        else if (strncmp(arg, "--csv=", 6) == 0 && arg[6] != '\0')
+        {
+            options->csv_path = arg + 6;
+        }
+        else if (strncmp(arg, "--seed=", 7) == 0)
+        {
+            char *end = NULL;
+            options->generator.seed = strtoull(arg + 7, &end, 10);
+            valid = end != arg + 7 && *end == '\0';
+        }
+        else if (strncmp(arg, "--arrivals=", 11) == 0)
+        {
+            valid = parse_arrival_model(arg + 11, &options->generator);
+        }
+        else if (strncmp(arg, "--bursts=", 9) == 0)
+        {
+            valid = parse_burst_model(arg + 9, &options->generator);
+        }
+        else if (strncmp(arg, "--priorities=", 13) == 0)
+        {
+            valid = parse_priority_weights(arg + 13, &options->generator);
+        }
+        else
+        {
+            if (strcmp(arg, "--help") != 0)
+            {
+                fprintf(stderr, "Error: Unknown option '%s'.\n", arg);
+            }
+            print_usage(argv[0]);
+            return false;
+        }
+
+        if (!valid)
+        {
+            fprintf(stderr, "Error: Invalid value in '%s'.\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* ========================================================================================*/
+/* MAIN */
+/* ========================================================================================*/
+
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+    if (!parse_bench_options(argc, argv, &options))
+    {
+        return EXIT_FAILURE;
+    }
+
+    FILE *csv = NULL;
+    if (options.csv_path != NULL)
+    {
+        csv = fopen(options.csv_path, "a");
+        if (csv == NULL)
+        {
+            fprintf(stderr, "Error: Cannot open '%s': %s.\n", options.csv_path, strerror(errno));
+            return EXIT_FAILURE;
+        }
+        if (fseek(csv, 0, SEEK_END) == 0 && ftell(csv) == 0)
+        {
+            fputs(BENCH_CSV_HEADER, csv);
+        }
+    }
+
+    printf("Benchmark '%s': %d repetitions per point after one warm-up run\n", options.label, options.repetitions);
+    printf("Algorithm    Quantum  Jobs       Median_ms    Stddev_%%  ns/job     Jobs/s         Peak_RSS_MB\n");
+
+    bool ok = true;
+    for (int s = 0; s < options.num_sizes && ok; s++)
+    {
+        for (int a = 0; a < NUM_ALGORITHMS && ok; a++)
+        {
+            const AlgorithmEntry *algorithm = &SCHEDULER_ALGORITHMS[a];
+            int num_quanta = algorithm->uses_quantum ? options.num_quanta : 1;
+            for (int q = 0; q < num_quanta && ok; q++)
+            {
+                int quantum = algorithm->uses_quantum ? (int)options.quanta[q] : 0;
+                BenchSample sample;
+                ok = run_point(&options, algorithm, options.sizes[s], quantum, &sample);
+                if (ok)
+                {
+                    report_point(&options, csv, algorithm, options.sizes[s], quantum, &sample);
+                }
+            }
+        }
+    }
+
+    if (csv != NULL && fclose(csv) != 0)
+    {
+        fprintf(stderr, "Error: Failed to write '%s'.\n", options.csv_path);
+        ok = false;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
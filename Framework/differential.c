@@ -0,0 +1,667 @@
+/**
+ * ===============================================================================
+ * DIFFERENTIAL TESTING
+ * ===============================================================================
+ * @file differential.c
+ * @brief Random workloads through the optimized and the reference engines
+ *
+ * The harness owns its randomness (splitmix64 over the seed) and only uses
+ * the workload generator for the row values, so an iteration is reproducible
+ * from the seed alone. Runs are quiet (ctx->output == NULL); only completion
+ * times are compared, since turnaround and waiting time follow from them.
+ * ===============================================================================
+ */
+
+#include "differential.h"
+#include "reference_engines.h"
+#include "scheduler_scratch.h"
+#include "smp_scheduler.h"
+#include "workload_generator.h"
+#include "sched_library.h"
+#include "feedback_scheduler.h"
+#include "partitioned_scheduler.h"
+
+/* ========================================================================================*/
+// One engine under test and its oracle
+typedef struct
+{
+    const char *name;
+    ReferencePolicy reference;
+    void (*run)(SchedulerContext *ctx, int time_quantum);
+} DifferentialEngine;
+
+// A workload together with the quantum it is scheduled with
+typedef struct
+{
+    Process *rows;
+    int n;
+    int quantum;
+} Workload;
+
+// Where an engine disagreed with the reference
+typedef struct
+{
+    const char *mode;           // Scratch state of the failing run
+    long long *expected;        // Reference completion times
+    long long *actual;
+} Mismatch;
+
+static const char *const RUN_MODES[] = {"no scratch", "fresh scratch", "reused scratch"};
+#define NUM_RUN_MODES ((int)(sizeof(RUN_MODES) / sizeof(RUN_MODES[0])))
+
+/* ========================================================================================*/
+/* ENGINES */
+/* ========================================================================================*/
+
+static void run_smp(SchedulerContext *ctx, SmpPolicy policy, int time_quantum)
+{
+    SmpConfig config = {1, time_quantum, true, 0, 0};
+    smp_scheduler(ctx, policy, &config);
+}
+
+static void run_smp_fcfs(SchedulerContext *ctx, int time_quantum)
+{
+    run_smp(ctx, SMP_FCFS, time_quantum);
+}
+
+static void run_smp_rr(SchedulerContext *ctx, int time_quantum)
+{
+    run_smp(ctx, SMP_RR, time_quantum);
+}
+
+static void run_smp_srtf(SchedulerContext *ctx, int time_quantum)
+{
+    run_smp(ctx, SMP_SRTF, time_quantum);
+}
+
+static void run_smp_priority_rr(SchedulerContext *ctx, int time_quantum)
+{
+    run_smp(ctx, SMP_PRIORITY_RR, time_quantum);
+}
+
+static void run_mlfq(SchedulerContext *ctx, int time_quantum)
+{
+    MlfqConfig config;
+    mlfq_config_init(&config, time_quantum);
+    mlfq_scheduler(ctx, &config);
+}
+
+static void run_priority_np_aging(SchedulerContext *ctx, int time_quantum)
+{
+    (void)time_quantum;
+    AgingConfig config;
+    aging_config_init(&config, 0);
+    priority_aging_scheduler(ctx, &config);
+}
+
+static void run_priority_rr_aging(SchedulerContext *ctx, int time_quantum)
+{
+    AgingConfig config;
+    aging_config_init(&config, time_quantum);
+    priority_aging_scheduler(ctx, &config);
+}
+
+// Two workers and many small chunks, so most workloads split
+static void run_partitioned(SchedulerContext *ctx, PartitionPolicy policy, int time_quantum)
+{
+    PartitionConfig config = {2, 4, time_quantum};
+    if (!partitioned_scheduler(ctx, policy, &config))
+    {
+        for (int i = 0; i < ctx->num_processes; i++)
+        {
+            ctx->processes[i].completion_time = -1;
+        }
+    }
+}
+
+static void run_partitioned_fcfs(SchedulerContext *ctx, int time_quantum)
+{
+    run_partitioned(ctx, PARTITION_FCFS, time_quantum);
+}
+
+static void run_partitioned_sjf(SchedulerContext *ctx, int time_quantum)
+{
+    run_partitioned(ctx, PARTITION_SJF, time_quantum);
+}
+
+static void run_partitioned_srtf(SchedulerContext *ctx, int time_quantum)
+{
+    run_partitioned(ctx, PARTITION_SRTF, time_quantum);
+}
+
+static void run_partitioned_rr(SchedulerContext *ctx, int time_quantum)
+{
+    run_partitioned(ctx, PARTITION_RR, time_quantum);
+}
+
+static void run_partitioned_priority_np(SchedulerContext *ctx, int time_quantum)
+{
+    run_partitioned(ctx, PARTITION_PRIORITY_NP, time_quantum);
+}
+
+static void run_partitioned_priority_rr(SchedulerContext *ctx, int time_quantum)
+{
+    run_partitioned(ctx, PARTITION_PRIORITY_RR, time_quantum);
+}
+
+// Runs a library policy on a read-only copy of the rows and stores the results in ctx
+static void run_library(SchedulerContext *ctx, const SchedPolicy *policy, int time_quantum)
+{
+    int n = ctx->num_processes;
+    SchedJob *jobs = scheduler_alloc((size_t)n, sizeof(SchedJob));
+    SchedJobResult *results = scheduler_alloc((size_t)n, sizeof(SchedJobResult));
+    for (int i = 0; i < n; i++)
+    {
+        const Process *p = &ctx->processes[i];
+        jobs[i] = (SchedJob){p->pid, p->arrival_time, p->burst_time, p->priority};
+    }
+
+    // Policies without a quantum must accept 0, so they are not given one
+    SchedWorkload workload = {jobs, n};
+    SchedParams params = {policy->uses_quantum ? time_quantum : 0};
+    SchedStatus status = sched_run(policy, &workload, &params, results, NULL);
+    for (int i = 0; i < n; i++)
+    {
+        ctx->processes[i].completion_time = (status == SCHED_OK) ? results[i].completion_time : -1;
+    }
+    free(jobs);
+    free(results);
+}
+
+static void run_library_fcfs(SchedulerContext *ctx, int time_quantum)
+{
+    run_library(ctx, &SCHED_POLICY_FCFS, time_quantum);
+}
+
+static void run_library_sjf(SchedulerContext *ctx, int time_quantum)
+{
+    run_library(ctx, &SCHED_POLICY_SJF, time_quantum);
+}
+
+static void run_library_srtf(SchedulerContext *ctx, int time_quantum)
+{
+    run_library(ctx, &SCHED_POLICY_SRTF, time_quantum);
+}
+
+static void run_library_rr(SchedulerContext *ctx, int time_quantum)
+{
+    run_library(ctx, &SCHED_POLICY_RR, time_quantum);
+}
+
+static void run_library_priority(SchedulerContext *ctx, int time_quantum)
+{
+    run_library(ctx, &SCHED_POLICY_PRIORITY, time_quantum);
+}
+
+static void run_library_priority_rr(SchedulerContext *ctx, int time_quantum)
+{
+    run_library(ctx, &SCHED_POLICY_PRIORITY_RR, time_quantum);
+}
+
+// Builds a session on a perturbed copy of the rows, then asks for the real
+// rows as a what-if; small checkpoint spacing exercises resume and convergence.
+// The reference has no start times, so those are checked against sched_run()
+// on the real rows, and any difference fails the whole run.
+static void run_what_if(SchedulerContext *ctx, const SchedPolicy *policy, int time_quantum)
+{
+    int n = ctx->num_processes;
+    SchedJob *jobs = scheduler_alloc((size_t)n, sizeof(SchedJob));
+    SchedJobResult *results = scheduler_alloc((size_t)n, sizeof(SchedJobResult));
+    SchedJobResult *expected = scheduler_alloc((size_t)n, sizeof(SchedJobResult));
+    SchedJobChange changes[3];
+    for (int i = 0; i < n; i++)
+    {
+        const Process *p = &ctx->processes[i];
+        jobs[i] = (SchedJob){p->pid, p->arrival_time, p->burst_time, p->priority};
+    }
+    SchedWorkload workload = {jobs, n};
+    SchedParams params = {time_quantum};
+    SchedStatus status = sched_run(policy, &workload, &params, expected, NULL);
+    int num_changes = min_value(n, 3);
+    int step = (n >= 3) ? n / 3 : 1;
+    for (int j = 0; j < num_changes; j++)
+    {
+        int i = j * step;
+        const Process *p = &ctx->processes[i];
+        changes[j] = (SchedJobChange){i, p->arrival_time, p->burst_time, p->priority};
+        jobs[i].arrival_time += 1 + p->pid % 7;
+        jobs[i].burst_time += p->pid % 3;
+        jobs[i].priority = ctx->processes[(i + 1) % n].priority;
+    }
+
+    SchedSession *session = NULL;
+    if (status == SCHED_OK)
+    {
+        status = sched_session_create(policy, &workload, &params, 2, &session);
+    }
+    if (status == SCHED_OK)
+    {
+        status = sched_session_what_if(session, changes, num_changes, results, NULL, NULL);
+    }
+    bool ok = (status == SCHED_OK);
+    for (int i = 0; ok && i < n; i++)
+    {
+        ok = (results[i].start_time == expected[i].start_time);
+    }
+    for (int i = 0; i < n; i++)
+    {
+        ctx->processes[i].completion_time = ok ? results[i].completion_time : -1;
+    }
+    sched_session_free(session);
+    free(jobs);
+    free(results);
+    free(expected);
+}
+
+static void run_what_if_fcfs(SchedulerContext *ctx, int time_quantum)
+{
+    run_what_if(ctx, &SCHED_POLICY_FCFS, time_quantum);
+}
+
+static void run_what_if_sjf(SchedulerContext *ctx, int time_quantum)
+{
+    run_what_if(ctx, &SCHED_POLICY_SJF, time_quantum);
+}
+
+static void run_what_if_srtf(SchedulerContext *ctx, int time_quantum)
+{
+    run_what_if(ctx, &SCHED_POLICY_SRTF, time_quantum);
+}
+
+static void run_what_if_rr(SchedulerContext *ctx, int time_quantum)
+{
+    run_what_if(ctx, &SCHED_POLICY_RR, time_quantum);
+}
+
+static void run_what_if_priority(SchedulerContext *ctx, int time_quantum)
+{
+    run_what_if(ctx, &SCHED_POLICY_PRIORITY, time_quantum);
+}
+
+static void run_what_if_priority_rr(SchedulerContext *ctx, int time_quantum)
+{
+    run_what_if(ctx, &SCHED_POLICY_PRIORITY_RR, time_quantum);
+}
+
+static const DifferentialEngine ENGINES[] = {
+    {"FCFS", REFERENCE_FCFS, run_first_come_first_served},
+    {"SJF", REFERENCE_SJF, run_shortest_job_first},
+    {"SRTF", REFERENCE_SRTF, run_shortest_remaining_time_first},
+    {"RR", REFERENCE_RR, round_robin},
+    {"PRIORITY_NP", REFERENCE_PRIORITY_NP, run_priority_non_preemptive},
+    {"PRIORITY_RR", REFERENCE_PRIORITY_RR, priority_preemptive_rr},
+    {"MLFQ", REFERENCE_MLFQ, run_mlfq},
+    {"PRIORITY_NP with aging", REFERENCE_PRIORITY_NP_AGING, run_priority_np_aging},
+    {"PRIORITY_RR with aging", REFERENCE_PRIORITY_RR_AGING, run_priority_rr_aging},
+    {"Partitioned FCFS", REFERENCE_FCFS, run_partitioned_fcfs},
+    {"Partitioned SJF", REFERENCE_SJF, run_partitioned_sjf},
+    {"Partitioned SRTF", REFERENCE_SRTF, run_partitioned_srtf},
+    {"Partitioned RR", REFERENCE_RR, run_partitioned_rr},
+    {"Partitioned PRIORITY_NP", REFERENCE_PRIORITY_NP, run_partitioned_priority_np},
+    {"Partitioned PRIORITY_RR", REFERENCE_PRIORITY_RR, run_partitioned_priority_rr},
+    {"SMP FCFS on 1 core", REFERENCE_FCFS, run_smp_fcfs},
+    {"SMP RR on 1 core", REFERENCE_RR, run_smp_rr},
+    {"SMP SRTF on 1 core", REFERENCE_SRTF, run_smp_srtf},
+    {"SMP PRIORITY_RR on 1 core", REFERENCE_PRIORITY_RR_ROTATING, run_smp_priority_rr},
+    {"Library FCFS", REFERENCE_FCFS, run_library_fcfs},
+    {"Library SJF", REFERENCE_SJF, run_library_sjf},
+    {"Library SRTF", REFERENCE_SRTF, run_library_srtf},
+    {"Library RR", REFERENCE_RR, run_library_rr},
+    {"Library PRIORITY_NP", REFERENCE_PRIORITY_NP, run_library_priority},
+    {"Library PRIORITY_RR", REFERENCE_PRIORITY_RR, run_library_priority_rr},
+    {"What-if FCFS", REFERENCE_FCFS, run_what_if_fcfs},
+    {"What-if SJF", REFERENCE_SJF, run_what_if_sjf},
+    {"What-if SRTF", REFERENCE_SRTF, run_what_if_srtf},
+    {"What-if RR", REFERENCE_RR, run_what_if_rr},
+    {"What-if PRIORITY_NP", REFERENCE_PRIORITY_NP, run_what_if_priority},
+    {"What-if PRIORITY_RR", REFERENCE_PRIORITY_RR, run_what_if_priority_rr},
+};
+
+#define NUM_ENGINES ((int)(sizeof(ENGINES) / sizeof(ENGINES[0])))
+
+/* ========================================================================================*/
+/* CHECKING */
+/* ========================================================================================*/
+
+// Runs engine on w in every scratch mode; false (with mismatch filled in) on the first disagreement
+static bool engine_matches(const DifferentialEngine *engine, const Workload *w, Mismatch *mismatch)
+{
+    reference_schedule(engine->reference, w->rows, w->n, w->quantum, mismatch->expected);
+
+    SchedulerContext ctx;
+    init_scheduler_context(&ctx);
+    ctx.output = NULL;
+    if (!reserve_process_capacity(&ctx, w->n))
+    {
+        fprintf(stderr, "Error: Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(ctx.processes, w->rows, (size_t)w->n * sizeof(Process));
+    ctx.num_processes = w->n;
+
+    SchedulerScratch scratch;
+    init_scheduler_scratch(&scratch);
+
+    bool matches = true;
+    for (int mode = 0; mode < NUM_RUN_MODES && matches; mode++)
+    {
+        ctx.scratch = (mode == 0) ? NULL : &scratch;
+        reset_scheduler_scratch(&scratch);
+        engine->run(&ctx, w->quantum);
+        for (int i = 0; i < w->n; i++)
+        {
+            mismatch->actual[i] = ctx.processes[i].completion_time;
+            if (mismatch->actual[i] != mismatch->expected[i])
+            {
+                matches = false;
+            }
+        }
+        mismatch->mode = RUN_MODES[mode];
+    }
+
+    ctx.scratch = NULL;
+    free_scheduler_scratch(&scratch);
+    free_scheduler_context(&ctx);
+    return matches;
+}
+
+/* ========================================================================================*/
+/* RANDOM WORKLOADS */
+/* ========================================================================================*/
+
+static uint64_t splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/* ========================================================================================*/
+
+static int random_below(uint64_t *state, int bound)
+{
+    return (int)(splitmix64(state) % (uint64_t)bound);
+}
+
+/* ========================================================================================*/
+
+static void shuffle(uint64_t *state, void *items, int n, size_t size, void *tmp)
+{
+    char *base = items;
+    for (int i = n - 1; i > 0; i--)
+    {
+        int j = random_below(state, i + 1);
+        memcpy(tmp, base + (size_t)i * size, size);
+        memcpy(base + (size_t)i * size, base + (size_t)j * size, size);
+        memcpy(base + (size_t)j * size, tmp, size);
+    }
+}
+
+/* ========================================================================================*/
+
+// Fills w (rows has room for max_processes) with a random workload and quantum
+static void random_workload(uint64_t *state, int max_processes, Workload *w)
+{
+    GeneratorConfig config;
+    generator_config_init(&config);
+    config.seed = splitmix64(state);
+    config.num_processes = 1 + random_below(state, max_processes);
+
+    // High rates give many equal arrival times, low rates idle gaps
+    char spec[64];
+    double rate = 0.1 + random_below(state, 40) / 10.0;
+    if (random_below(state, 4) == 0)
+    {
+        snprintf(spec, sizeof(spec), "bursty:%.1f:%d:%d", rate, 1 + random_below(state, 8), 1 + random_below(state, 20));
+    }
+    else
+    {
+        snprintf(spec, sizeof(spec), "poisson:%.1f", rate);
+    }
+    parse_arrival_model(spec, &config);
+
+    switch (random_below(state, 3))
+    {
+    case 0:
+        snprintf(spec, sizeof(spec), "exp:%d", 1 + random_below(state, 8));
+        break;
+    case 1:
+        snprintf(spec, sizeof(spec), "pareto:%.2f:%d", 1.5 + random_below(state, 8) / 4.0, 1 + random_below(state, 3));
+        break;
+    default:
+        snprintf(spec, sizeof(spec), "bimodal:%d:%d:0.%02d", 1 + random_below(state, 3), 5 + random_below(state, 20),
+                 random_below(state, 50));
+        break;
+    }
+    parse_burst_model(spec, &config);
+
+    config.num_priorities = 1 + random_below(state, 4);
+    for (int i = 0; i < config.num_priorities; i++)
+    {
+        config.priority_weights[i] = 1 + random_below(state, 4);
+    }
+
+    SchedulerContext ctx;
+    init_scheduler_context(&ctx);
+    if (!generate_processes(&config, &ctx))
+    {
+        fprintf(stderr, "Error: Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    w->n = ctx.num_processes;
+    memcpy(w->rows, ctx.processes, (size_t)w->n * sizeof(Process));
+    free_scheduler_context(&ctx);
+
+    // Input order and PIDs independent of the arrival order
+    Process tmp;
+    shuffle(state, w->rows, w->n, sizeof(Process), &tmp);
+    int *pids = scheduler_alloc((size_t)w->n, sizeof(int));
+    for (int i = 0; i < w->n; i++)
+    {
+        pids[i] = i + 1;
+    }
+    int pid_tmp;
+    shuffle(state, pids, w->n, sizeof(int), &pid_tmp);
+    for (int i = 0; i < w->n; i++)
+    {
+        w->rows[i].pid = pids[i];
+    }
+    free(pids);
+
+    w->quantum = 1 + random_below(state, 5);
+}
+
+/* ========================================================================================*/
+/* SHRINKING */
+/* ========================================================================================*/
+
+// Tries value for *field (at least floor); keeps it if the workload still fails
+static bool try_field(const DifferentialEngine *engine, Workload *w, int *field, int value, int floor,
+                      Mismatch *mismatch)
+{
+    if (value < floor || value >= *field)
+    {
+        return false;
+    }
+    int original = *field;
+    *field = value;
+    if (!engine_matches(engine, w, mismatch))
+    {
+        return true;
+    }
+    *field = original;
+    return false;
+}
+
+/* ========================================================================================*/
+
+// Smaller values for one field: the floor, half, one less
+static bool simplify_field(const DifferentialEngine *engine, Workload *w, int *field, int floor,
+                           Mismatch *mismatch)
+{
+    return try_field(engine, w, field, floor, floor, mismatch) ||
+           try_field(engine, w, field, *field / 2, floor, mismatch) ||
+           try_field(engine, w, field, *field - 1, floor, mismatch);
+}
+
+/* ========================================================================================*/
+
+// Shifts the arrivals to start at 0 and renumbers the PIDs densely; kept if the workload still fails
+static bool try_normalize(const DifferentialEngine *engine, Workload *w, Mismatch *mismatch)
+{
+    Process *original = scheduler_alloc((size_t)w->n, sizeof(Process));
+    memcpy(original, w->rows, (size_t)w->n * sizeof(Process));
+
+    int first_arrival = INT_MAX;
+    for (int i = 0; i < w->n; i++)
+    {
+        first_arrival = min_value(first_arrival, original[i].arrival_time);
+    }
+    bool changed = false;
+    for (int i = 0; i < w->n; i++)
+    {
+        int smaller_pids = 0;
+        for (int j = 0; j < w->n; j++)
+        {
+            smaller_pids += (original[j].pid < original[i].pid);
+        }
+        w->rows[i].pid = smaller_pids + 1;
+        w->rows[i].arrival_time -= first_arrival;
+        changed = changed || w->rows[i].pid != original[i].pid || first_arrival != 0;
+    }
+
+    bool kept = changed && !engine_matches(engine, w, mismatch);
+    if (!kept)
+    {
+        memcpy(w->rows, original, (size_t)w->n * sizeof(Process));
+    }
+    free(original);
+    return kept;
+}
+
+/* ========================================================================================*/
+
+// Shrinks the failing workload w in place until no single step keeps it failing
+static void shrink_workload(const DifferentialEngine *engine, Workload *w, Mismatch *mismatch)
+{
+    Process *candidate_rows = scheduler_alloc((size_t)w->n, sizeof(Process));
+    bool progress = true;
+    while (progress)
+    {
+        progress = false;
+
+        // Drop chunks of rows, halving the chunk size
+        for (int chunk = w->n / 2; chunk >= 1; chunk /= 2)
+        {
+            for (int start = 0; start + chunk <= w->n && w->n > chunk;)
+            {
+                Workload candidate = {candidate_rows, w->n - chunk, w->quantum};
+                memcpy(candidate_rows, w->rows, (size_t)start * sizeof(Process));
+                memcpy(candidate_rows + start, w->rows + start + chunk,
+                       (size_t)(w->n - start - chunk) * sizeof(Process));
+                if (!engine_matches(engine, &candidate, mismatch))
+                {
+                    memcpy(w->rows, candidate_rows, (size_t)candidate.n * sizeof(Process));
+                    w->n = candidate.n;
+                    progress = true;
+                }
+                else
+                {
+                    start += chunk;
+                }
+            }
+        }
+
+        // Start at time 0 and number the PIDs 1..n, keeping their relative order
+        if (try_normalize(engine, w, mismatch))
+        {
+            progress = true;
+        }
+
+        // Smaller values, field by field
+        for (int i = 0; i < w->n; i++)
+        {
+            Process *p = &w->rows[i];
+            while (simplify_field(engine, w, &p->burst_time, 1, mismatch) ||
+                   simplify_field(engine, w, &p->arrival_time, 0, mismatch) ||
+                   simplify_field(engine, w, &p->priority, 0, mismatch))
+            {
+                progress = true;
+            }
+        }
+        while (simplify_field(engine, w, &w->quantum, 1, mismatch))
+        {
+            progress = true;
+        }
+    }
+    free(candidate_rows);
+
+    // Leave mismatch describing the final workload
+    engine_matches(engine, w, mismatch);
+}
+
+/* ========================================================================================*/
+
+static void print_repro(const DifferentialEngine *engine, const Workload *w, const Mismatch *mismatch,
+                        long long iteration, uint64_t seed)
+{
+    printf("Mismatch: %s (time quantum %d, %s) at iteration %lld of seed %llu\n", engine->name, w->quantum,
+           mismatch->mode, iteration, (unsigned long long)seed);
+    printf("Minimal workload (%d process%s):\n", w->n, (w->n == 1) ? "" : "es");
+    printf("Process     Burst Time     Priority    Arrival Time\n");
+    printf("======================================================\n");
+    for (int i = 0; i < w->n; i++)
+    {
+        const Process *p = &w->rows[i];
+        printf("P%-11d%-15d%-12d%d\n", p->pid, p->burst_time, p->priority, p->arrival_time);
+    }
+    printf("PID      Expected_Completion  Actual_Completion\n");
+    for (int i = 0; i < w->n; i++)
+    {
+        printf("%-9d%-21lld%lld%s\n", w->rows[i].pid, mismatch->expected[i], mismatch->actual[i],
+               (mismatch->expected[i] != mismatch->actual[i]) ? "  <--" : "");
+    }
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+
+/**
+ * Runs options->iterations random workloads through every engine. Returns
+ * false after printing a shrunk repro of the first mismatch.
+ */
+bool run_differential(const DifferentialOptions *options)
+{
+    int max_n = options->max_processes;
+    Workload w = {scheduler_alloc((size_t)max_n, sizeof(Process)), 0, 1};
+    Mismatch mismatch = {NULL, scheduler_alloc((size_t)max_n, sizeof(long long)),
+                         scheduler_alloc((size_t)max_n, sizeof(long long))};
+    uint64_t state = options->seed;
+    bool ok = true;
+
+    for (long long iteration = 0; iteration < options->iterations && ok; iteration++)
+    {
+        random_workload(&state, max_n, &w);
+        for (int e = 0; e < NUM_ENGINES && ok; e++)
+        {
+            if (!engine_matches(&ENGINES[e], &w, &mismatch))
+            {
+                shrink_workload(&ENGINES[e], &w, &mismatch);
+                print_repro(&ENGINES[e], &w, &mismatch, iteration, options->seed);
+                ok = false;
+            }
+        }
+    }
+
+    if (ok)
+    {
+        printf("Differential test passed: %lld workloads of up to %d processes, %d engines (seed %llu)\n",
+               options->iterations, max_n, NUM_ENGINES, (unsigned long long)options->seed);
+    }
+    free(w.rows);
+    free(mismatch.expected);
+    free(mismatch.actual);
+    return ok;
+}
@@ -0,0 +1,42 @@
+/*
+ * ===============================================================================
+ * DIFFERENTIAL TESTING HEADER FILE
+ * ===============================================================================
+ *
+ * Fuzzes the optimized engines against the reference engines (see
+ * reference_engines.h). Every iteration builds a random workload (generator
+ * models, shuffled rows, permuted PIDs, many arrival ties) and a random
+ * quantum, then runs each engine three times: without scratch buffers, and
+ * twice with one scratch attached (build, then reuse). The feedback
+ * engines (feedback_scheduler.h), the partitioned runs of the core engines
+ * (partitioned_scheduler.h), the SMP engine on one core and the library
+ * policies (sched_library.h) are checked too, the latter also as what-if
+ * queries against a perturbed session baseline. All completion times must
+ * match the reference.
+ *
+ * On the first mismatch the workload is shrunk (row removal by halving
+ * chunks, then smaller field values and quantum) while it still fails, and
+ * the minimal repro is printed as an input file with both schedules.
+ *
+ * ===============================================================================
+ */
+
+#ifndef DIFFERENTIAL_H
+#define DIFFERENTIAL_H
+
+#include "CPU_scheduler.h"
+
+/* ========================================================================================*/
+// Structure to hold the fuzzing settings
+typedef struct
+{
+    long long iterations;
+    uint64_t seed;
+    int max_processes;          // Workload sizes are drawn from 1..max_processes
+} DifferentialOptions;
+
+/* ========================================================================================*/
+// Differential function prototypes
+bool run_differential(const DifferentialOptions *options);
+
+#endif // DIFFERENTIAL_H
@@ -0,0 +1,481 @@
+/**
+ * ===============================================================================
+ * FEEDBACK SCHEDULERS
+ * ===============================================================================
+ * @file feedback_scheduler.c
+ * @brief Multilevel feedback queue and priority scheduling with aging
+ *
+ * Both engines keep the waiting jobs in PriorityBuckets and work on the
+ * rank-ordered columns (see process_columns.h). MLFQ boosts by splicing the
+ * lower levels onto level 0 and resets allotments lazily: a job's used time
+ * only counts if it was recorded after the latest boost. Aging records one
+ * (rank, stamp) entry per level entry in a RingQueue; entries are pushed in
+ * time order, so the head is always the next promotion to check, and the
+ * stamp discards entries of jobs that left their level in the meantime.
+ * ===============================================================================
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include "feedback_scheduler.h"
+#include "priority_buckets.h"
+#include "ring_queue.h"
+#include "scheduler_scratch.h"
+#include "sched_stats.h"
+#include "trace_recorder.h"
+
+/* ========================================================================================*/
+// Waiting jobs and promotion entries of the aging engine
+typedef struct
+{
+    SchedulerContext *ctx;
+    const ProcessColumns *cols;
+    PriorityBuckets *ready;
+    RingQueue *entries;         // (rank, stamp) pairs in level entry order
+    const int *base_level;      // Level of each rank's own priority
+    int *level;                 // Current level of a waiting rank
+    int *entered;               // Time it entered that level
+    int *stamp;                 // Stamp of its live entry, 0 while it runs
+    unsigned sequence;
+    int interval;
+    int next_arrival;
+} AgingQueue;
+
+/* ========================================================================================*/
+/* CONFIGURATION */
+/* ========================================================================================*/
+
+// factor quanta, saturated at INT_MAX so large quanta still give a valid setting
+static int scaled_quantum(int time_quantum, int factor)
+{
+    long long value = (long long)time_quantum * factor;
+    return (value > INT_MAX) ? INT_MAX : (int)value;
+}
+
+/* ========================================================================================*/
+/**
+ * Three levels with allotments of 1, 2 and 4 quanta, boosted every 16 quanta.
+ */
+void mlfq_config_init(MlfqConfig *config, int time_quantum)
+{
+    memset(config, 0, sizeof(*config));
+    config->num_levels = 3;
+    for (int level = 0; level < config->num_levels; level++)
+    {
+        config->quantum[level] = scaled_quantum(time_quantum, 1 << level);
+    }
+    config->boost_interval = scaled_quantum(time_quantum, 16);
+}
+
+/* ========================================================================================*/
+/**
+ * Parses "Q0,Q1,..." (one positive allotment per level, top level first).
+ */
+bool parse_mlfq_quanta(const char *spec, MlfqConfig *config)
+{
+    int num_levels = 0;
+    int quantum[MLFQ_MAX_LEVELS];
+    const char *cursor = spec;
+    for (;;)
+    {
+        char *end = NULL;
+        errno = 0;
+        long value = strtol(cursor, &end, 10);
+        if (end == cursor || errno != 0 || value <= 0 || value > INT_MAX || num_levels == MLFQ_MAX_LEVELS)
+        {
+            return false;
+        }
+        quantum[num_levels++] = (int)value;
+        if (*end == '\0')
+        {
+            break;
+        }
+        if (*end != ',')
+        {
+            return false;
+        }
+        cursor = end + 1;
+    }
+    config->num_levels = num_levels;
+    memcpy(config->quantum, quantum, sizeof(quantum));
+    return true;
+}
+
+/* ========================================================================================*/
+/**
+ * Promotes a waiting job every 4 quanta; time_quantum 0 = non-preemptive.
+ */
+void aging_config_init(AgingConfig *config, int time_quantum)
+{
+    config->aging_interval = scaled_quantum((time_quantum > 0) ? time_quantum : 3, 4);
+    config->time_quantum = time_quantum;
+}
+
+/* ========================================================================================*/
+/* MULTILEVEL FEEDBACK QUEUE */
+/* ========================================================================================*/
+
+static bool valid_mlfq_config(const MlfqConfig *config)
+{
+    if (config->num_levels <= 0 || config->num_levels > MLFQ_MAX_LEVELS || config->boost_interval < 0)
+    {
+        return false;
+    }
+    for (int level = 0; level < config->num_levels; level++)
+    {
+        if (config->quantum[level] <= 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* ========================================================================================*/
+
+// Bucket storage for a level count that does not come from the workload
+static void take_buckets(SchedulerContext *ctx, PriorityBuckets *buckets, int num_levels, int n)
+{
+    buckets->num_levels = num_levels;
+    buckets->num_words = (num_levels + 63) / 64;
+    buckets->num_summary_words = (buckets->num_words + 63) / 64;
+    buckets->head = scratch_alloc(ctx, (size_t)num_levels, sizeof(int));
+    buckets->tail = scratch_alloc(ctx, (size_t)num_levels, sizeof(int));
+    buckets->next = scratch_alloc(ctx, (size_t)n, sizeof(int));
+    buckets->prev = scratch_alloc(ctx, (size_t)n, sizeof(int));
+    buckets->level_bits = scratch_alloc(ctx, (size_t)buckets->num_words, sizeof(uint64_t));
+    buckets->word_bits = scratch_alloc(ctx, (size_t)buckets->num_summary_words, sizeof(uint64_t));
+    priority_buckets_clear(buckets);
+}
+
+static void release_buckets(SchedulerContext *ctx, PriorityBuckets *buckets)
+{
+    scratch_release(ctx, buckets->head);
+    scratch_release(ctx, buckets->tail);
+    scratch_release(ctx, buckets->next);
+    scratch_release(ctx, buckets->prev);
+    scratch_release(ctx, buckets->level_bits);
+    scratch_release(ctx, buckets->word_bits);
+}
+
+/* ========================================================================================*/
+/**
+ * @brief Multilevel feedback queue with per-level allotments and periodic boost
+ *
+ * @param ctx Pointer to the scheduler context containing all process information
+ * @param config Levels, allotments and boost interval (see feedback_scheduler.h)
+ * @return false, without running, if config is invalid
+ */
+bool mlfq_scheduler(SchedulerContext *ctx, const MlfqConfig *config)
+{
+    if (!valid_mlfq_config(config))
+    {
+        return false;
+    }
+    if (ctx->num_processes <= 0)
+    {
+        return true;
+    }
+    reset_process_states(ctx);
+
+    ProcessColumns local_columns;
+    ProcessColumns *cols = acquire_process_columns(ctx, &local_columns);
+    int n = cols->num_processes;
+    const int *arrival = cols->arrival_time;
+    int *remaining = cols->remaining_time;
+    int bottom = config->num_levels - 1;
+
+    PriorityBuckets ready;
+    take_buckets(ctx, &ready, config->num_levels, n);
+    int *used = scratch_alloc(ctx, (size_t)n, sizeof(int));     // Allotment used at the current level
+    int *epoch = scratch_alloc(ctx, (size_t)n, sizeof(int));    // Boosts done when used[] was written
+    int boosts = 0;
+    long long next_boost = config->boost_interval;
+
+    int current_time = 0;
+    int completed = 0;
+    int next_arrival = 0;
+    int last_run = -1;
+
+    while (completed < n)
+    {
+        STATS_COUNT(STAT_LOOP_ITERATIONS);
+        while (next_arrival < n && arrival[next_arrival] <= current_time)
+        {
+            used[next_arrival] = 0;
+            epoch[next_arrival] = boosts;
+            priority_buckets_push_back(&ready, 0, next_arrival);
+            next_arrival++;
+        }
+
+        // A boost is a splice per level; allotments reset when a job is next dispatched
+        if (config->boost_interval > 0 && current_time >= next_boost)
+        {
+            for (int level = 1; level <= bottom; level++)
+            {
+                priority_buckets_splice(&ready, level, 0);
+            }
+            boosts++;
+            next_boost = ((long long)current_time / config->boost_interval + 1) * config->boost_interval;
+        }
+
+        int level = priority_buckets_first_level(&ready);
+        if (level == -1)
+        {
+            STATS_COUNT(STAT_IDLE_JUMPS);
+            current_time = arrival[next_arrival];
+            continue;
+        }
+        int rank = ready.head[level];
+        priority_buckets_remove(&ready, level, rank);
+        if (epoch[rank] != boosts)
+        {
+            used[rank] = 0;
+        }
+
+        if (rank != last_run)
+        {
+            current_time += charge_context_switch(ctx, cols->start_time[rank] >= 0);
+            last_run = rank;
+        }
+        int slice_end = current_time + min_value(remaining[rank], config->quantum[level] - used[rank]);
+
+        // Arrivals enter level 0, so any arrival preempts a job running below it
+        while (next_arrival < n && arrival[next_arrival] <= slice_end)
+        {
+            if (level > 0 && arrival[next_arrival] < slice_end)
+            {
+                slice_end = (arrival[next_arrival] > current_time) ? arrival[next_arrival] : current_time;
+                break;
+            }
+            used[next_arrival] = 0;
+            epoch[next_arrival] = boosts;
+            priority_buckets_push_back(&ready, 0, next_arrival);
+            next_arrival++;
+        }
+
+        if (cols->start_time[rank] < 0 && slice_end > current_time)
+        {
+            cols->start_time[rank] = current_time;
+        }
+        TRACE_POINT(ctx, TRACE_DISPATCH, ctx->processes[cols->order[rank]].pid, current_time);
+        STATS_COUNT(STAT_DISPATCHES);
+        remaining[rank] -= slice_end - current_time;
+        used[rank] += slice_end - current_time;
+        current_time = slice_end;
+
+        // The job that ran queues behind everything that arrived by now
+        while (next_arrival < n && arrival[next_arrival] <= current_time)
+        {
+            used[next_arrival] = 0;
+            epoch[next_arrival] = boosts;
+            priority_buckets_push_back(&ready, 0, next_arrival);
+            next_arrival++;
+        }
+
+        if (remaining[rank] == 0)
+        {
+            cols->completion_time[rank] = current_time;
+            completed++;
+            TRACE_POINT(ctx, TRACE_COMPLETE, ctx->processes[cols->order[rank]].pid, current_time);
+            continue;
+        }
+        if (used[rank] >= config->quantum[level])
+        {
+            level = (level < bottom) ? level + 1 : bottom;
+            used[rank] = 0;
+        }
+        epoch[rank] = boosts;
+        priority_buckets_push_back(&ready, level, rank);
+        TRACE_POINT(ctx, TRACE_PREEMPT, ctx->processes[cols->order[rank]].pid, current_time);
+        STATS_COUNT(STAT_PREEMPTIONS);
+    }
+
+    release_buckets(ctx, &ready);
+    scratch_release(ctx, used);
+    scratch_release(ctx, epoch);
+    process_columns_store(cols, ctx);
+    release_process_columns(ctx, cols);
+
+    display_results(ctx, "Multilevel-Feedback-Queue (MLFQ)");
+    return true;
+}
+
+/* ========================================================================================*/
+/* PRIORITY WITH AGING */
+/* ========================================================================================*/
+
+static void aging_enqueue(AgingQueue *q, int rank, int level, int time)
+{
+    int stamp = (int)(++q->sequence & INT_MAX);
+    if (stamp == 0)
+    {
+        stamp = (int)(++q->sequence & INT_MAX);
+    }
+    q->level[rank] = level;
+    q->entered[rank] = time;
+    q->stamp[rank] = stamp;
+    priority_buckets_push_back(q->ready, level, rank);
+    if (level > 0)
+    {
+        ring_queue_push(q->entries, rank);
+        ring_queue_push(q->entries, stamp);
+    }
+}
+
+/* ========================================================================================*/
+
+// Applies every promotion due by time, oldest level entry first
+static void aging_promote(AgingQueue *q, int time)
+{
+    RingQueue *entries = q->entries;
+    while (entries->count > 0)
+    {
+        int rank = entries->items[entries->head];
+        int stamp = entries->items[(entries->head + 1) & entries->mask];
+        if (q->stamp[rank] == stamp && q->entered[rank] + (long long)q->interval > time)
+        {
+            return;
+        }
+        ring_queue_pop(entries);
+        ring_queue_pop(entries);
+        if (q->stamp[rank] == stamp)
+        {
+            priority_buckets_remove(q->ready, q->level[rank], rank);
+            aging_enqueue(q, rank, q->level[rank] - 1, q->entered[rank] + q->interval);
+        }
+    }
+}
+
+/* ========================================================================================*/
+
+// Promotions and arrivals up to time, in time order (promotions first at ties)
+static void aging_advance(AgingQueue *q, int time)
+{
+    const int *arrival = q->cols->arrival_time;
+    int n = q->cols->num_processes;
+    while (q->next_arrival < n && arrival[q->next_arrival] <= time)
+    {
+        aging_promote(q, arrival[q->next_arrival]);
+        aging_enqueue(q, q->next_arrival, q->base_level[q->next_arrival], arrival[q->next_arrival]);
+        q->next_arrival++;
+    }
+    aging_promote(q, time);
+}
+
+/* ========================================================================================*/
+/**
+ * @brief Priority scheduling where waiting jobs gain one level per aging interval
+ *
+ * @param ctx Pointer to the scheduler context containing all process information
+ * @param config Aging interval and slice (0 = non-preemptive, see feedback_scheduler.h)
+ * @return false, without running, if config is invalid
+ */
+bool priority_aging_scheduler(SchedulerContext *ctx, const AgingConfig *config)
+{
+    if (config->aging_interval <= 0 || config->time_quantum < 0)
+    {
+        return false;
+    }
+    if (ctx->num_processes <= 0)
+    {
+        return true;
+    }
+    reset_process_states(ctx);
+
+    ProcessColumns local_columns;
+    ProcessColumns *cols = acquire_process_columns(ctx, &local_columns);
+    int n = cols->num_processes;
+    int *remaining = cols->remaining_time;
+    int *base_level = NULL;
+    PriorityBuckets local_buckets;
+    RingQueue local_entries;
+
+    AgingQueue q;
+    memset(&q, 0, sizeof(q));
+    q.ctx = ctx;
+    q.cols = cols;
+    q.ready = acquire_priority_buckets(ctx, cols, &local_buckets, &base_level);
+    q.entries = acquire_ready_queue(ctx, &local_entries);
+    q.base_level = base_level;
+    q.level = scratch_alloc(ctx, (size_t)n, sizeof(int));
+    q.entered = scratch_alloc(ctx, (size_t)n, sizeof(int));
+    q.stamp = scratch_alloc(ctx, (size_t)n, sizeof(int));
+    q.interval = config->aging_interval;
+
+    int current_time = 0;
+    int completed = 0;
+    int last_run = -1;
+
+    while (completed < n)
+    {
+        STATS_COUNT(STAT_LOOP_ITERATIONS);
+        aging_advance(&q, current_time);
+
+        int level = priority_buckets_first_level(q.ready);
+        if (level == -1)
+        {
+            STATS_COUNT(STAT_IDLE_JUMPS);
+            current_time = cols->arrival_time[q.next_arrival];
+            continue;
+        }
+        int rank = q.ready->head[level];
+        priority_buckets_remove(q.ready, level, rank);
+        q.stamp[rank] = 0;
+
+        if (rank != last_run)
+        {
+            current_time += charge_context_switch(ctx, cols->start_time[rank] >= 0);
+            last_run = rank;
+        }
+        int slice = (config->time_quantum > 0) ? min_value(remaining[rank], config->time_quantum) : remaining[rank];
+        int slice_end = current_time + slice;
+
+        // Only an arrival above the running job's level preempts it
+        for (int k = q.next_arrival; config->time_quantum > 0 && k < n && cols->arrival_time[k] < slice_end; k++)
+        {
+            if (base_level[k] < level)
+            {
+                slice_end = (cols->arrival_time[k] > current_time) ? cols->arrival_time[k] : current_time;
+                break;
+            }
+        }
+
+        if (cols->start_time[rank] < 0 && slice_end > current_time)
+        {
+            cols->start_time[rank] = current_time;
+        }
+        TRACE_POINT(ctx, TRACE_DISPATCH, ctx->processes[cols->order[rank]].pid, current_time);
+        STATS_COUNT(STAT_DISPATCHES);
+        remaining[rank] -= slice_end - current_time;
+        current_time = slice_end;
+        aging_advance(&q, current_time);
+
+        if (remaining[rank] == 0)
+        {
+            cols->completion_time[rank] = current_time;
+            completed++;
+            TRACE_POINT(ctx, TRACE_COMPLETE, ctx->processes[cols->order[rank]].pid, current_time);
+        }
+        else
+        {
+            // Running resets the job to its own priority
+            aging_enqueue(&q, rank, base_level[rank], current_time);
+            TRACE_POINT(ctx, TRACE_PREEMPT, ctx->processes[cols->order[rank]].pid, current_time);
+            STATS_COUNT(STAT_PREEMPTIONS);
+        }
+    }
+
+    release_ready_queue(ctx, q.entries);
+    release_priority_buckets(ctx, q.ready, base_level);
+    scratch_release(ctx, q.level);
+    scratch_release(ctx, q.entered);
+    scratch_release(ctx, q.stamp);
+    process_columns_store(cols, ctx);
+    release_process_columns(ctx, cols);
+
+    display_results(ctx, (config->time_quantum > 0) ? "PRIORITY_PREEMPTIVE_RR_WITH_AGING"
+                                                    : "PRIORITY_NON_PREEMPTIVE_WITH_AGING");
+    return true;
+}
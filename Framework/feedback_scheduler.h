@@ -0,0 +1,65 @@
+/*
+ * ===============================================================================
+ * FEEDBACK SCHEDULERS HEADER FILE
+ * ===============================================================================
+ *
+ * Starvation-free alternatives to the static priority engines, both on the
+ * per-level FIFO lists of priority_buckets.h so every decision stays O(1):
+ *
+ * - MLFQ: arrivals enter level 0. The head of the highest non-empty level
+ *   runs until its level allotment (quantum[level]) is used up, then moves
+ *   one level down (the bottom level round-robins). An arrival preempts a
+ *   job below level 0; the job keeps its level and the rest of its
+ *   allotment. At the first decision after every boost_interval, all
+ *   waiting jobs return to level 0 with fresh allotments (level 0 first,
+ *   then level 1, ..., each in queue order), as whole-list splices.
+ *
+ * - Priority with aging: levels are the dense workload priorities. A job
+ *   waiting aging_interval at one level moves up to the next (to the tail);
+ *   running resets it to its own priority. Promotions are due in the order
+ *   jobs entered their levels, so a single FIFO of entries yields them in
+ *   time order. At equal times, promotions go first, then arrivals (by
+ *   rank), then the job that just ran. The non-preemptive variant runs the
+ *   chosen job to completion. With a quantum, a job runs at most one slice
+ *   before going back to its priority's tail, and only an arrival with a
+ *   higher priority than the running job's level preempts it.
+ *
+ * Both engines honour the context switch model and report through
+ * display_results(). reference_engines.h holds their oracles.
+ *
+ * ===============================================================================
+ */
+
+#ifndef FEEDBACK_SCHEDULER_H
+#define FEEDBACK_SCHEDULER_H
+
+#include "CPU_scheduler.h"
+
+// Most MLFQ levels a configuration may have
+#define MLFQ_MAX_LEVELS 16
+
+/* ========================================================================================*/
+// Structure to hold the MLFQ settings
+typedef struct
+{
+    int num_levels;
+    int quantum[MLFQ_MAX_LEVELS];   // Allotment at each level (> 0)
+    int boost_interval;             // Return every job to level 0 every N time units, 0 = never
+} MlfqConfig;
+
+// Structure to hold the aging settings
+typedef struct
+{
+    int aging_interval;         // Waiting time per promotion (> 0)
+    int time_quantum;           // Slice of the preemptive variant, 0 = non-preemptive
+} AgingConfig;
+
+/* ========================================================================================*/
+// Feedback scheduler function prototypes
+void mlfq_config_init(MlfqConfig *config, int time_quantum);
+bool parse_mlfq_quanta(const char *spec, MlfqConfig *config);
+void aging_config_init(AgingConfig *config, int time_quantum);
+bool mlfq_scheduler(SchedulerContext *ctx, const MlfqConfig *config);
+bool priority_aging_scheduler(SchedulerContext *ctx, const AgingConfig *config);
+
+#endif // FEEDBACK_SCHEDULER_H
@@ -0,0 +1,448 @@
+/**
+ * ===============================================================================
+ * ONLINE SCHEDULER
+ * ===============================================================================
+ * @file online_scheduler.c
+ * @brief Streaming FCFS, SJF, SRTF, RR and non-preemptive priority scheduling
+ *
+ * Active jobs live in a slot pool that is recycled on completion. The reader is
+ * kept one row ahead so the engines know the next arrival time exactly like the
+ * arrival cursor of the offline schedulers. The simulation clock and the totals
+ * are 64-bit so long traces cannot overflow them.
+ * ===============================================================================
+ */
+
+#include "online_scheduler.h"
+#include "ready_heap.h"
+#include "ring_queue.h"
+#include "result_writer.h"
+
+/* ========================================================================================*/
+// A newly arrived job waiting to be ordered into the ready queue or heap
+typedef struct
+{
+    int arrival_time;
+    int pid;
+    int slot;
+} StagedJob;
+
+// Structure to hold the streaming state
+typedef struct
+{
+    ProcessReader *reader;
+    Process next;               // Lookahead row, valid when has_next
+    bool has_next;
+    bool failed;
+
+    Process *jobs;              // Slot pool of active jobs
+    int capacity;
+    int *free_slots;            // Stack of unused slots
+    int num_free;
+    ReadyHeap *heap;            // Grown with the pool, NULL for queue policies
+
+    StagedJob *staged;          // Arrivals admitted together, sorted into arrival -> PID order
+    int staged_capacity;
+    long long next_rank;        // Admission counter, the heap tie-breaker
+
+    long long clock;
+    long long num_completed;
+    long long total_turnaround;
+    long long total_waiting;
+    ResultWriter writer;
+    bool print_rows;            // Cleared by REPORT_SUMMARY_ONLY
+} OnlineState;
+
+// Heap ordering of the selection-based policies
+typedef enum
+{
+    KEY_BURST_TIME,
+    KEY_REMAINING_TIME,
+    KEY_PRIORITY
+} OnlineKey;
+
+/* ========================================================================================*/
+/* STREAM AND SLOT POOL */
+/* ========================================================================================*/
+
+bool parse_online_policy(const char *name, OnlinePolicy *policy)
+{
+    static const struct
+    {
+        const char *name;
+        OnlinePolicy policy;
+    } POLICIES[] = {
+        {"FCFS", ONLINE_FCFS},
+        {"SJF", ONLINE_SJF},
+        {"SRTF", ONLINE_SRTF},
+        {"RR", ONLINE_RR},
+        {"PRIORITY_NP", ONLINE_PRIORITY_NP},
+    };
+
+    for (size_t i = 0; i < sizeof(POLICIES) / sizeof(POLICIES[0]); i++)
+    {
+        if (strcmp(name, POLICIES[i].name) == 0)
+        {
+            *policy = POLICIES[i].policy;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* ========================================================================================*/
+/**
+ * Pulls the next row into the lookahead, applying the per-row validation rules
+ * and the arrival-order requirement of the stream.
+ */
+static void pull_next(OnlineState *state)
+{
+    int previous_arrival = state->has_next ? state->next.arrival_time : 0;
+    state->has_next = false;
+
+    ReaderStatus status = process_reader_next(state->reader, &state->next);
+    if (status != READER_ROW)
+    {
+        state->failed |= (status == READER_ERROR);
+        return;
+    }
+
+    const Process *p = &state->next;
+    const char *problem = NULL;
+    if (p->burst_time <= 0)
+    {
+        problem = "burst time must be positive";
+    }
+    else if (p->arrival_time < 0 || p->priority < 0)
+    {
+        problem = "arrival time and priority must not be negative";
+    }
+    else if (p->arrival_time < previous_arrival)
+    {
+        problem = "online mode needs rows sorted by arrival time";
+    }
+
+    if (problem != NULL)
+    {
+        fprintf(stderr, "Error: Line %ld (PID %d): %s.\n", state->reader->line_number, p->pid, problem);
+        state->failed = true;
+        return;
+    }
+    state->has_next = true;
+}
+
+/* ========================================================================================*/
+
+static bool next_arrives_by(const OnlineState *state, long long time)
+{
+    return state->has_next && state->next.arrival_time <= time;
+}
+
+/* ========================================================================================*/
+/**
+ * Moves the lookahead row into a free slot (growing the pool by doubling when
+ * none is left) and pulls the next row. Returns the slot.
+ */
+static int admit_next(OnlineState *state)
+{
+    if (state->num_free == 0)
+    {
+        int grown = (state->capacity > 0) ? state->capacity * 2 : INITIAL_PROCESS_CAPACITY;
+        Process *jobs = realloc(state->jobs, (size_t)grown * sizeof(Process));
+        int *free_slots = realloc(state->free_slots, (size_t)grown * sizeof(int));
+        if (jobs == NULL || free_slots == NULL)
+        {
+            fprintf(stderr, "Error: Out of memory.\n");
+            exit(EXIT_FAILURE);
+        }
+        // Hand out the new slots lowest first
+        for (int slot = grown - 1; slot >= state->capacity; slot--)
+        {
+            free_slots[state->num_free++] = slot;
+        }
+        state->jobs = jobs;
+        state->free_slots = free_slots;
+        state->capacity = grown;
+        if (state->heap != NULL)
+        {
+            ready_heap_reserve(state->heap, state->capacity);
+        }
+    }
+
+    int slot = state->free_slots[--state->num_free];
+    state->jobs[slot] = state->next;
+    pull_next(state);
+    return slot;
+}
+
+/* ========================================================================================*/
+/**
+ * Emits the finished job (see calculate_turnaround_times for the formulas)
+ * and recycles its slot.
+ */
+static void complete_job(OnlineState *state, int slot)
+{
+    const Process *p = &state->jobs[slot];
+    long long turnaround = state->clock - p->arrival_time;
+    long long waiting = turnaround - p->burst_time;
+
+    if (state->print_rows)
+    {
+        result_writer_row(&state->writer, p->pid, state->clock, turnaround, waiting);
+    }
+    state->num_completed++;
+    state->total_turnaround += turnaround;
+    state->total_waiting += waiting;
+    state->free_slots[state->num_free++] = slot;
+}
+
+/* ========================================================================================*/
+/* ENGINES */
+/* ========================================================================================*/
+
+static int job_key(const Process *p, OnlineKey key)
+{
+    switch (key)
+    {
+    case KEY_BURST_TIME:
+        return p->burst_time;
+    case KEY_REMAINING_TIME:
+        return p->remaining_time;
+    default:
+        return p->priority;
+    }
+}
+
+/* ========================================================================================*/
+
+static int compare_staged(const void *a, const void *b)
+{
+    const StagedJob *x = a;
+    const StagedJob *y = b;
+    if (x->arrival_time != y->arrival_time)
+    {
+        return (x->arrival_time < y->arrival_time) ? -1 : 1;
+    }
+    return (x->pid > y->pid) - (x->pid < y->pid);
+}
+
+/* ========================================================================================*/
+/**
+ * Admits every job that has arrived by the clock into state->staged, in
+ * arrival -> PID order. Returns the number of staged jobs.
+ */
+static int stage_arrivals(OnlineState *state)
+{
+    int count = 0;
+    while (next_arrives_by(state, state->clock))
+    {
+        if (count == state->staged_capacity)
+        {
+            state->staged_capacity = (count > 0) ? count * 2 : INITIAL_PROCESS_CAPACITY;
+            state->staged = realloc(state->staged, (size_t)state->staged_capacity * sizeof(StagedJob));
+            if (state->staged == NULL)
+            {
+                fprintf(stderr, "Error: Out of memory.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        int slot = admit_next(state);
+        state->staged[count].arrival_time = state->jobs[slot].arrival_time;
+        state->staged[count].pid = state->jobs[slot].pid;
+        state->staged[count].slot = slot;
+        count++;
+    }
+
+    // The stream is only sorted by arrival, equal arrivals still need PID order
+    if (count > 1)
+    {
+        qsort(state->staged, (size_t)count, sizeof(StagedJob), compare_staged);
+    }
+    return count;
+}
+
+/* ========================================================================================*/
+
+static void admit_to_queue(OnlineState *state, RingQueue *queue)
+{
+    int count = stage_arrivals(state);
+    for (int i = 0; i < count; i++)
+    {
+        ring_queue_push(queue, state->staged[i].slot);
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Pushes the newly arrived jobs onto the heap. Their admission rank breaks key
+ * ties in arrival -> PID order, like the arrival rank of the offline engines.
+ */
+static void admit_to_heap(OnlineState *state, ReadyHeap *heap, OnlineKey key)
+{
+    int count = stage_arrivals(state);
+    for (int i = 0; i < count; i++)
+    {
+        int slot = state->staged[i].slot;
+        ready_heap_push(heap, slot, job_key(&state->jobs[slot], key), state->next_rank++);
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * FCFS and RR: a FIFO ready queue, FCFS being RR with an unbounded quantum.
+ * As in round_robin(), arrivals during a slice are queued before the
+ * preempted job.
+ */
+static void run_queue_policy(OnlineState *state, int time_quantum)
+{
+    RingQueue queue;
+    ring_queue_init(&queue, RING_QUEUE_MIN_CAPACITY);
+
+    while (!state->failed && (state->has_next || !ring_queue_is_empty(&queue)))
+    {
+        admit_to_queue(state, &queue);
+        if (ring_queue_is_empty(&queue))
+        {
+            // CPU idle: jump to the next arrival
+            state->clock = state->next.arrival_time;
+            continue;
+        }
+
+        int slot = ring_queue_pop(&queue);
+        int exec_time = min_value(state->jobs[slot].remaining_time, time_quantum);
+        state->clock += exec_time;
+        state->jobs[slot].remaining_time -= exec_time;
+
+        admit_to_queue(state, &queue);
+        if (state->jobs[slot].remaining_time == 0)
+        {
+            complete_job(state, slot);
+        }
+        else
+        {
+            ring_queue_push(&queue, slot);
+        }
+    }
+    ring_queue_free(&queue);
+}
+
+/* ========================================================================================*/
+/**
+ * SJF, SRTF and non-preemptive priority on the ready heap. The preemptive
+ * variant runs the best job until it completes or the next arrival, as in
+ * shortest_remaining_time_first().
+ */
+static void run_heap_policy(OnlineState *state, OnlineKey key, bool preemptive)
+{
+    ReadyHeap heap;
+    ready_heap_init(&heap, state->capacity);
+    state->heap = &heap;
+
+    while (!state->failed && (state->has_next || !ready_heap_is_empty(&heap)))
+    {
+        admit_to_heap(state, &heap, key);
+        if (ready_heap_is_empty(&heap))
+        {
+            state->clock = state->next.arrival_time;
+            continue;
+        }
+
+        int slot = ready_heap_peek(&heap);
+        long long run_time = state->jobs[slot].remaining_time;
+        if (preemptive && state->has_next && state->next.arrival_time - state->clock < run_time)
+        {
+            run_time = state->next.arrival_time - state->clock;
+        }
+
+        state->clock += run_time;
+        state->jobs[slot].remaining_time -= (int)run_time;
+        if (state->jobs[slot].remaining_time == 0)
+        {
+            ready_heap_pop(&heap);
+            complete_job(state, slot);
+        }
+        else if (key == KEY_REMAINING_TIME)
+        {
+            ready_heap_update(&heap, slot, state->jobs[slot].remaining_time);
+        }
+    }
+
+    state->heap = NULL;
+    ready_heap_free(&heap);
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+
+/**
+ * Runs policy over the rows of reader, printing each job as it completes and
+ * the averages at the end in the format of display_results(). Only
+ * REPORT_SUMMARY_ONLY of report_flags applies in online mode, and every format
+ * except RESULT_FORMAT_BINARY (its header needs the row count up front).
+ */
+bool run_online_scheduler(ProcessReader *reader, OnlinePolicy policy, int time_quantum,
+                          unsigned report_flags, ResultFormat format, FILE *output)
+{
+    static const AlgorithmId ALGORITHM_OF[] = {
+        [ONLINE_FCFS] = ALGORITHM_FCFS,
+        [ONLINE_SJF] = ALGORITHM_SJF,
+        [ONLINE_SRTF] = ALGORITHM_SRTF,
+        [ONLINE_RR] = ALGORITHM_RR,
+        [ONLINE_PRIORITY_NP] = ALGORITHM_PRIORITY_NP,
+    };
+
+    if ((policy == ONLINE_RR && time_quantum <= 0) || format == RESULT_FORMAT_BINARY)
+    {
+        return false;
+    }
+
+    OnlineState state;
+    memset(&state, 0, sizeof(state));
+    state.reader = reader;
+    state.print_rows = !(report_flags & REPORT_SUMMARY_ONLY);
+
+    pull_next(&state);
+    if (!state.has_next)
+    {
+        return false;
+    }
+
+    result_writer_init(&state.writer, output, format, NULL);
+    result_writer_begin(&state.writer, SCHEDULER_ALGORITHMS[ALGORITHM_OF[policy]].title, NULL, 0, state.print_rows ? -1 : 0);
+
+    switch (policy)
+    {
+    case ONLINE_FCFS:
+        run_queue_policy(&state, INT_MAX);
+        break;
+    case ONLINE_RR:
+        run_queue_policy(&state, time_quantum);
+        break;
+    case ONLINE_SJF:
+        run_heap_policy(&state, KEY_BURST_TIME, false);
+        break;
+    case ONLINE_SRTF:
+        run_heap_policy(&state, KEY_REMAINING_TIME, true);
+        break;
+    case ONLINE_PRIORITY_NP:
+        run_heap_policy(&state, KEY_PRIORITY, false);
+        break;
+    }
+
+    if (!state.failed)
+    {
+        ScheduleMetrics metrics;
+        memset(&metrics, 0, sizeof(metrics));
+        metrics.total_turnaround = state.total_turnaround;
+        metrics.total_waiting = state.total_waiting;
+        metrics.avg_turnaround = (double)state.total_turnaround / (double)state.num_completed;
+        metrics.avg_waiting = (double)state.total_waiting / (double)state.num_completed;
+        result_writer_summary(&state.writer, &metrics, state.num_completed, 0);
+    }
+    bool written = result_writer_finish(&state.writer);
+
+    free(state.jobs);
+    free(state.free_slots);
+    free(state.staged);
+    return !state.failed && written;
+}
@@ -0,0 +1,43 @@
+/*
+ * ===============================================================================
+ * ONLINE SCHEDULER HEADER FILE
+ * ===============================================================================
+ *
+ * Streaming variants of the schedulers: rows are pulled from a ProcessReader
+ * only when the simulation clock reaches them, completed jobs are printed
+ * (PID, turnaround, waiting time, in completion order) and their slot is
+ * recycled. Memory is bounded by the number of jobs that have arrived but not
+ * completed, not by the trace length.
+ *
+ * The stream must be sorted by arrival time; rows with equal arrival times may
+ * come in any PID order. The tie-breaking rules match the offline schedulers.
+ * PRIORITY_RR needs the full set of priority levels up front and therefore
+ * has no online variant.
+ *
+ * ===============================================================================
+ */
+
+#ifndef ONLINE_SCHEDULER_H
+#define ONLINE_SCHEDULER_H
+
+#include "CPU_scheduler.h"
+#include "workload_reader.h"
+
+/* ========================================================================================*/
+// Algorithms available in online mode
+typedef enum
+{
+    ONLINE_FCFS,
+    ONLINE_SJF,
+    ONLINE_SRTF,
+    ONLINE_RR,
+    ONLINE_PRIORITY_NP
+} OnlinePolicy;
+
+/* ========================================================================================*/
+// Online scheduler function prototypes
+bool parse_online_policy(const char *name, OnlinePolicy *policy);
+bool run_online_scheduler(ProcessReader *reader, OnlinePolicy policy, int time_quantum,
+                          unsigned report_flags, ResultFormat format, FILE *output);
+
+#endif // ONLINE_SCHEDULER_H
@@ -0,0 +1,237 @@
+/**
+ * ===============================================================================
+ * PARTITIONED SCHEDULER
+ * ===============================================================================
+ * @file partitioned_scheduler.c
+ * @brief Busy periods of one workload simulated in parallel and stitched together
+ *
+ * A chunk is a range of arrival ranks. Every worker owns one context that it
+ * refills with the rows of each chunk it picks up, in arrival order, so the
+ * chunk's arrival index is the identity and is never sorted again. Chunks
+ * write their results straight into the workload: their rows are disjoint.
+ * ===============================================================================
+ */
+
+#include "partitioned_scheduler.h"
+#include "thread_pool.h"
+
+/* ========================================================================================*/
+// Arrival ranks [first, last) simulated as one unit
+typedef struct
+{
+    int first;
+    int last;
+    long long end;              // Last completion of the chunk's latest run
+    long long num_switches;
+    long long switch_overhead;
+    bool dirty;                 // Not simulated since it was built or merged
+} Chunk;
+
+// Shared state of one partitioned run
+typedef struct
+{
+    SchedulerContext *ctx;
+    const int *order;
+    const AlgorithmEntry *engine;
+    int time_quantum;
+    Chunk *chunks;
+    int *pending;               // Indices of the chunks to simulate this round
+    SchedulerContext *workers;  // One reusable context per worker
+    bool *failed;               // Allocation failure per worker
+} PartitionRun;
+
+/* ========================================================================================*/
+/* CHUNKS */
+/* ========================================================================================*/
+
+/**
+ * Splits the arrival order at the gaps of the prefix scan, closing a chunk at
+ * the first gap after it reached target jobs. Returns the number of chunks.
+ */
+static int build_chunks(const SchedulerContext *ctx, const int *order, int target, Chunk *chunks)
+{
+    int num_chunks = 0;
+    int first = 0;
+    long long end = LLONG_MIN;
+    for (int rank = 0; rank < ctx->num_processes; rank++)
+    {
+        const Process *p = &ctx->processes[order[rank]];
+        if (p->arrival_time > end && rank - first >= target)
+        {
+            chunks[num_chunks++] = (Chunk){first, rank, 0, 0, 0, true};
+            first = rank;
+        }
+        end = ((p->arrival_time > end) ? p->arrival_time : end) + ctx->switch_cost + p->burst_time;
+    }
+    chunks[num_chunks++] = (Chunk){first, ctx->num_processes, 0, 0, 0, true};
+    return num_chunks;
+}
+
+/* ========================================================================================*/
+
+// Grows a worker context to n rows with an identity arrival index
+static bool reserve_worker(SchedulerContext *worker, int n)
+{
+    if (n <= worker->capacity)
+    {
+        return true;
+    }
+    int *order = realloc(worker->arrival_order, (size_t)n * sizeof(int));
+    if (order == NULL)
+    {
+        return false;
+    }
+    worker->arrival_order = order;
+    for (int i = 0; i < n; i++)
+    {
+        order[i] = i;
+    }
+    return reserve_process_capacity(worker, n);
+}
+
+/* ========================================================================================*/
+
+static void simulate_chunk_task(void *arg, int index, int worker_index)
+{
+    PartitionRun *run = arg;
+    Chunk *chunk = &run->chunks[run->pending[index]];
+    SchedulerContext *worker = &run->workers[worker_index];
+    int n = chunk->last - chunk->first;
+    if (!reserve_worker(worker, n))
+    {
+        run->failed[worker_index] = true;
+        return;
+    }
+
+    const int *order = run->order + chunk->first;
+    for (int i = 0; i < n; i++)
+    {
+        worker->processes[i] = run->ctx->processes[order[i]];
+    }
+    worker->num_processes = n;
+    run->engine->run(worker, run->time_quantum);
+
+    chunk->end = LLONG_MIN;
+    for (int i = 0; i < n; i++)
+    {
+        const Process *src = &worker->processes[i];
+        Process *dst = &run->ctx->processes[order[i]];
+        dst->remaining_time = src->remaining_time;
+        dst->completion_time = src->completion_time;
+        dst->start_time = src->start_time;
+        dst->is_completed = src->is_completed;
+        chunk->end = (src->completion_time > chunk->end) ? src->completion_time : chunk->end;
+    }
+    chunk->num_switches = worker->num_switches;
+    chunk->switch_overhead = worker->switch_overhead;
+    chunk->dirty = false;
+}
+
+/* ========================================================================================*/
+
+/**
+ * Merges every clean chunk that ran into the next chunk's first arrival with
+ * that chunk. Returns the new chunk count; dirty chunks are checked next round.
+ */
+static int merge_overlapping_chunks(const SchedulerContext *ctx, const int *order, Chunk *chunks, int num_chunks)
+{
+    int kept = 0;
+    for (int i = 0; i < num_chunks; i++)
+    {
+        Chunk *previous = (kept > 0) ? &chunks[kept - 1] : NULL;
+        if (previous != NULL && !previous->dirty &&
+            previous->end >= ctx->processes[order[chunks[i].first]].arrival_time)
+        {
+            previous->last = chunks[i].last;
+            previous->dirty = true;
+            continue;
+        }
+        chunks[kept++] = chunks[i];
+    }
+    return kept;
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+
+/**
+ * Runs policy on ctx as parallel chunks of busy periods and reports the
+ * stitched schedule. A workload that does not split runs sequentially.
+ * Returns false if a worker context could not be allocated.
+ */
+bool partitioned_scheduler(SchedulerContext *ctx, PartitionPolicy policy, const PartitionConfig *config)
+{
+    const AlgorithmEntry *engine = &SCHEDULER_ALGORITHMS[policy];
+    int n = ctx->num_processes;
+    int num_threads = (config->num_threads > 0) ? config->num_threads : 1;
+    long long pieces = (long long)num_threads * config->chunks_per_thread;
+    int target = (int)((n + pieces - 1) / pieces);
+
+    reset_process_states(ctx);
+    const int *order = get_arrival_order(ctx);
+    Chunk *chunks = scheduler_alloc((size_t)(n > 0 ? n : 1), sizeof(Chunk));
+    int num_chunks = (n > 0) ? build_chunks(ctx, order, target, chunks) : 1;
+    if (num_chunks == 1)
+    {
+        free(chunks);
+        engine->run(ctx, config->time_quantum);
+        return true;
+    }
+
+    PartitionRun run = {ctx, order, engine, config->time_quantum, chunks, NULL, NULL, NULL};
+    run.pending = scheduler_alloc((size_t)num_chunks, sizeof(int));
+    run.workers = scheduler_alloc((size_t)num_threads, sizeof(SchedulerContext));
+    run.failed = scheduler_alloc((size_t)num_threads, sizeof(bool));
+    for (int i = 0; i < num_threads; i++)
+    {
+        init_scheduler_context(&run.workers[i]);
+        run.workers[i].output = NULL;
+        run.workers[i].switch_cost = ctx->switch_cost;
+        run.workers[i].warmup_cost = ctx->warmup_cost;
+    }
+
+    // Simulate the new chunks, then merge where a boundary did not hold
+    bool ok = true;
+    while (ok)
+    {
+        int num_pending = 0;
+        for (int i = 0; i < num_chunks; i++)
+        {
+            if (chunks[i].dirty)
+            {
+                run.pending[num_pending++] = i;
+            }
+        }
+        if (num_pending == 0)
+        {
+            break;
+        }
+        run_parallel_tasks(num_pending, num_threads, simulate_chunk_task, &run);
+        for (int i = 0; i < num_threads; i++)
+        {
+            ok = ok && !run.failed[i];
+        }
+        num_chunks = merge_overlapping_chunks(ctx, order, chunks, num_chunks);
+    }
+
+    if (ok)
+    {
+        for (int i = 0; i < num_chunks; i++)
+        {
+            ctx->num_switches += chunks[i].num_switches;
+            ctx->switch_overhead += chunks[i].switch_overhead;
+        }
+        display_results(ctx, engine->title);
+    }
+
+    for (int i = 0; i < num_threads; i++)
+    {
+        free_scheduler_context(&run.workers[i]);
+    }
+    free(run.failed);
+    free(run.workers);
+    free(run.pending);
+    free(chunks);
+    return ok;
+}
@@ -0,0 +1,56 @@
+/*
+ * ===============================================================================
+ * PARTITIONED SCHEDULER HEADER FILE
+ * ===============================================================================
+ *
+ * Runs a single-core engine as independent pieces in parallel. All six
+ * engines are work-conserving and keep no state across an idle gap, so the
+ * schedule splits into busy periods that can be simulated on their own:
+ *
+ * 1. a prefix scan over the arrival order (end = max(end, arrival) + burst,
+ *    plus switch_cost per job) finds the gaps, i.e. arrivals after the end
+ * 2. consecutive busy periods are grouped into chunks of similar job counts,
+ *    which run on their own contexts on the thread pool (see thread_pool.h)
+ * 3. completion and start times and the switch counters are stitched back
+ *    into the workload, and the run reports through display_results()
+ *
+ * Without switch costs and for the non-preemptive engines the scan is exact.
+ * Otherwise it is a lower bound (preemptions and warm-ups add time), so each
+ * chunk that ends on or after the next chunk's first arrival is merged with
+ * it and simulated again, until every boundary holds. The report is then
+ * identical to the sequential engine's.
+ *
+ * ===============================================================================
+ */
+
+#ifndef PARTITIONED_SCHEDULER_H
+#define PARTITIONED_SCHEDULER_H
+
+#include "CPU_scheduler.h"
+
+/* ========================================================================================*/
+// Engines that can be partitioned: the core engines, as indices into SCHEDULER_ALGORITHMS
+typedef enum
+{
+    PARTITION_FCFS = ALGORITHM_FCFS,
+    PARTITION_SJF = ALGORITHM_SJF,
+    PARTITION_SRTF = ALGORITHM_SRTF,
+    PARTITION_RR = ALGORITHM_RR,
+    PARTITION_PRIORITY_NP = ALGORITHM_PRIORITY_NP,
+    PARTITION_PRIORITY_RR = ALGORITHM_PRIORITY_RR,
+    PARTITION_NUM_POLICIES = NUM_ALGORITHMS
+} PartitionPolicy;
+
+// Structure to hold the partitioning settings
+typedef struct
+{
+    int num_threads;            // Workers simulating the chunks
+    int chunks_per_thread;      // Chunks to aim for per worker (> 0), for load balance
+    int time_quantum;           // RR / PRIORITY_RR slice length
+} PartitionConfig;
+
+/* ========================================================================================*/
+// Partitioned scheduler function prototypes
+bool partitioned_scheduler(SchedulerContext *ctx, PartitionPolicy policy, const PartitionConfig *config);
+
+#endif // PARTITIONED_SCHEDULER_H
@@ -0,0 +1,269 @@
+/**
+ * ===============================================================================
+ * PRIORITY BUCKET QUEUE
+ * ===============================================================================
+ * @file priority_buckets.c
+ * @brief Per-priority FIFO lists with a find-first-set bitmap of non-empty levels
+ *
+ * Used by priority_preemptive_rr to select the highest non-empty level in O(1)
+ * (one scan of the summary word plus two count-trailing-zeros) instead of
+ * rebuilding the ready set with a full scan.
+ * ===============================================================================
+ */
+
+#include "priority_buckets.h"
+#include "sched_stats.h"
+
+/* ========================================================================================*/
+/* HELPERS */
+/* ========================================================================================*/
+
+static void mark_level(PriorityBuckets *buckets, int level)
+{
+    int word = level >> 6;
+    buckets->level_bits[word] |= UINT64_C(1) << (level & 63);
+    buckets->word_bits[word >> 6] |= UINT64_C(1) << (word & 63);
+}
+
+/* ========================================================================================*/
+
+static void clear_level(PriorityBuckets *buckets, int level)
+{
+    int word = level >> 6;
+    buckets->level_bits[word] &= ~(UINT64_C(1) << (level & 63));
+    if (buckets->level_bits[word] == 0)
+    {
+        buckets->word_bits[word >> 6] &= ~(UINT64_C(1) << (word & 63));
+    }
+}
+
+/* ========================================================================================*/
+
+static void *alloc_array(int count, size_t size)
+{
+    return calloc((size_t)(count > 0 ? count : 1), size);
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+
+/**
+ * Sets up empty levels 0 .. num_levels - 1 for process indices below
+ * num_processes. Returns false, with nothing allocated, on allocation failure.
+ */
+bool priority_buckets_try_init(PriorityBuckets *buckets, int num_levels, int num_processes)
+{
+    buckets->num_levels = num_levels;
+    buckets->num_words = (num_levels + 63) / 64;
+    buckets->num_summary_words = (buckets->num_words + 63) / 64;
+
+    buckets->head = alloc_array(num_levels, sizeof(int));
+    buckets->tail = alloc_array(num_levels, sizeof(int));
+    buckets->next = alloc_array(num_processes, sizeof(int));
+    buckets->prev = alloc_array(num_processes, sizeof(int));
+    buckets->level_bits = alloc_array(buckets->num_words, sizeof(uint64_t));
+    buckets->word_bits = alloc_array(buckets->num_summary_words, sizeof(uint64_t));
+    if (buckets->head == NULL || buckets->tail == NULL || buckets->next == NULL || buckets->prev == NULL ||
+        buckets->level_bits == NULL || buckets->word_bits == NULL)
+    {
+        priority_buckets_free(buckets);
+        return false;
+    }
+
+    priority_buckets_clear(buckets);
+    return true;
+}
+
+/* ========================================================================================*/
+/**
+ * Empties every level without releasing the storage, so it can be reused.
+ */
+void priority_buckets_clear(PriorityBuckets *buckets)
+{
+    for (int level = 0; level < buckets->num_levels; level++)
+    {
+        buckets->head[level] = -1;
+        buckets->tail[level] = -1;
+    }
+    memset(buckets->level_bits, 0, (size_t)buckets->num_words * sizeof(uint64_t));
+    memset(buckets->word_bits, 0, (size_t)buckets->num_summary_words * sizeof(uint64_t));
+}
+
+/* ========================================================================================*/
+
+void priority_buckets_free(PriorityBuckets *buckets)
+{
+    free(buckets->head);
+    free(buckets->tail);
+    free(buckets->next);
+    free(buckets->prev);
+    free(buckets->level_bits);
+    free(buckets->word_bits);
+    memset(buckets, 0, sizeof(*buckets));
+}
+
+/* ========================================================================================*/
+
+void priority_buckets_push_back(PriorityBuckets *buckets, int level, int idx)
+{
+    STATS_COUNT(STAT_BUCKET_PUSHES);
+    buckets->next[idx] = -1;
+    buckets->prev[idx] = buckets->tail[level];
+
+    if (buckets->tail[level] == -1)
+    {
+        buckets->head[level] = idx;
+        mark_level(buckets, level);
+    }
+    else
+    {
+        buckets->next[buckets->tail[level]] = idx;
+    }
+    buckets->tail[level] = idx;
+}
+
+/* ========================================================================================*/
+
+void priority_buckets_remove(PriorityBuckets *buckets, int level, int idx)
+{
+    STATS_COUNT(STAT_BUCKET_REMOVALS);
+    int before = buckets->prev[idx];
+    int after = buckets->next[idx];
+
+    if (before == -1)
+    {
+        buckets->head[level] = after;
+    }
+    else
+    {
+        buckets->next[before] = after;
+    }
+
+    if (after == -1)
+    {
+        buckets->tail[level] = before;
+    }
+    else
+    {
+        buckets->prev[after] = before;
+    }
+
+    if (buckets->head[level] == -1)
+    {
+        clear_level(buckets, level);
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Appends every process of level from, in order, to the tail of level to in O(1).
+ */
+void priority_buckets_splice(PriorityBuckets *buckets, int from, int to)
+{
+    int first = buckets->head[from];
+    if (first == -1 || from == to)
+    {
+        return;
+    }
+    if (buckets->tail[to] == -1)
+    {
+        buckets->head[to] = first;
+        mark_level(buckets, to);
+    }
+    else
+    {
+        buckets->next[buckets->tail[to]] = first;
+        buckets->prev[first] = buckets->tail[to];
+    }
+    buckets->tail[to] = buckets->tail[from];
+    buckets->head[from] = -1;
+    buckets->tail[from] = -1;
+    clear_level(buckets, from);
+}
+
+/* ========================================================================================*/
+/**
+ * Returns the highest-priority (lowest-numbered) non-empty level, or -1.
+ */
+int priority_buckets_first_level(const PriorityBuckets *buckets)
+{
+    for (int s = 0; s < buckets->num_summary_words; s++)
+    {
+        if (buckets->word_bits[s] != 0)
+        {
+            int word = s * 64 + __builtin_ctzll(buckets->word_bits[s]);
+            return word * 64 + __builtin_ctzll(buckets->level_bits[word]);
+        }
+    }
+    return -1;
+}
+
+/* ========================================================================================*/
+
+static int compare_ints(const void *lhs, const void *rhs)
+{
+    int a = *(const int *)lhs;
+    int b = *(const int *)rhs;
+    return (a > b) - (a < b);
+}
+
+/**
+ * Maps priorities[0 .. n - 1] to dense levels (0 = lowest priority number)
+ * without allocating: distinct needs room for n and receives the sorted
+ * distinct values. Returns their count, the number of levels.
+ */
+int priority_buckets_fill_levels(const int *priorities, int n, int *distinct, int *levels)
+{
+    memcpy(distinct, priorities, (size_t)n * sizeof(int));
+    qsort(distinct, (size_t)n, sizeof(int), compare_ints);
+
+    int count = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (count == 0 || distinct[count - 1] != distinct[i])
+        {
+            distinct[count++] = distinct[i];
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        int lo = 0, hi = count - 1;
+        while (lo < hi)
+        {
+            int mid = lo + (hi - lo) / 2;
+            if (distinct[mid] < priorities[i])
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        levels[i] = lo;
+    }
+    return count;
+}
+
+/* ========================================================================================*/
+/**
+ * Same mapping into a new level array, owned by the caller; stores the number
+ * of distinct levels in *num_levels. Returns NULL if out of memory.
+ */
+int *priority_buckets_try_map_levels(const int *priorities, int n, int *num_levels)
+{
+    int *distinct = alloc_array(n, sizeof(int));
+    int *levels = alloc_array(n, sizeof(int));
+    if (distinct == NULL || levels == NULL)
+    {
+        free(distinct);
+        free(levels);
+        return NULL;
+    }
+
+    *num_levels = priority_buckets_fill_levels(priorities, n, distinct, levels);
+    free(distinct);
+    return levels;
+}
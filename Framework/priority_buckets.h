@@ -0,0 +1,59 @@
+/*
+ * ===============================================================================
+ * PRIORITY BUCKET QUEUE HEADER FILE
+ * ===============================================================================
+ *
+ * Multi-level ready structure: one FIFO list per priority level plus a
+ * two-level bitmap of non-empty levels. Level 0 is the highest priority.
+ *
+ * - push_back / remove are O(1) (intrusive doubly-linked lists)
+ * - splice moves a whole level behind another in O(1)
+ * - first_level is a find-first-set over the bitmap
+ *
+ * Priority values are mapped to dense levels with priority_buckets_map_levels()
+ * (or priority_buckets_fill_levels() into caller memory)
+ * so arbitrary priority numbers do not inflate the bitmap.
+ *
+ * The try_ functions report allocation failure to the caller; the plain init
+ * and map_levels treat it as fatal and are defined with the other driver-only
+ * allocators in scheduler_alloc.c.
+ *
+ * ===============================================================================
+ */
+
+#ifndef PRIORITY_BUCKETS_H
+#define PRIORITY_BUCKETS_H
+
+#include <stdint.h>
+#include "CPU_scheduler.h"
+
+/* ========================================================================================*/
+// Structure to hold the bucket queue state
+typedef struct
+{
+    int *head;              // head[level] = first process index, -1 if empty
+    int *tail;              // tail[level] = last process index, -1 if empty
+    int *next;              // next[idx] = following process in the same level, -1 at tail
+    int *prev;              // prev[idx] = preceding process in the same level, -1 at head
+    uint64_t *level_bits;   // Bit per non-empty level
+    uint64_t *word_bits;    // Bit per non-zero word of level_bits
+    int num_levels;
+    int num_words;
+    int num_summary_words;
+} PriorityBuckets;
+
+/* ========================================================================================*/
+// Bucket queue function prototypes
+bool priority_buckets_try_init(PriorityBuckets *buckets, int num_levels, int num_processes);
+int priority_buckets_fill_levels(const int *priorities, int n, int *distinct, int *levels);
+int *priority_buckets_try_map_levels(const int *priorities, int n, int *num_levels);
+void priority_buckets_init(PriorityBuckets *buckets, int num_levels, int num_processes);
+void priority_buckets_free(PriorityBuckets *buckets);
+void priority_buckets_clear(PriorityBuckets *buckets);
+void priority_buckets_push_back(PriorityBuckets *buckets, int level, int idx);
+void priority_buckets_remove(PriorityBuckets *buckets, int level, int idx);
+void priority_buckets_splice(PriorityBuckets *buckets, int from, int to);
+int priority_buckets_first_level(const PriorityBuckets *buckets);
+int *priority_buckets_map_levels(const int *priorities, int n, int *num_levels);
+
+#endif // PRIORITY_BUCKETS_H
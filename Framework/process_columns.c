@@ -0,0 +1,113 @@
+/**
+ * ===============================================================================
+ * PROCESS COLUMNS
+ * ===============================================================================
+ * @file process_columns.c
+ * @brief Conversion between the Process array and the rank-ordered columns
+ * ===============================================================================
+ */
+
+#include "process_columns.h"
+#include "workload_binary.h"
+
+/* ========================================================================================*/
+/**
+ * Gathers the input fields of ctx into columns in arrival order and resets the
+ * per-run state. A mapped workload is read from its file columns, which are
+ * used in place when they are already in arrival order.
+ */
+void process_columns_build(ProcessColumns *columns, SchedulerContext *ctx)
+{
+    int n = ctx->num_processes;
+    const int *order = get_arrival_order(ctx);
+    const MappedWorkload *map = ctx->mapped_input;
+
+    columns->num_processes = n;
+    columns->order = order;
+    columns->remaining_time = scheduler_alloc((size_t)n, sizeof(int));
+    columns->completion_time = scheduler_alloc((size_t)n, sizeof(long long));
+    columns->start_time = scheduler_alloc((size_t)n, sizeof(long long));
+
+    columns->borrows_inputs = (map != NULL && (map->flags & WORKLOAD_FLAG_SORTED_BY_ARRIVAL) != 0);
+    if (columns->borrows_inputs)
+    {
+        columns->arrival_time = map->columns[WORKLOAD_COLUMN_ARRIVAL_TIME];
+        columns->burst_time = map->columns[WORKLOAD_COLUMN_BURST_TIME];
+        columns->priority = map->columns[WORKLOAD_COLUMN_PRIORITY];
+        process_columns_reset(columns);
+        return;
+    }
+
+    int *arrival_time = scheduler_alloc((size_t)n, sizeof(int));
+    int *burst_time = scheduler_alloc((size_t)n, sizeof(int));
+    int *priority = scheduler_alloc((size_t)n, sizeof(int));
+    if (map != NULL)
+    {
+        for (int k = 0; k < n; k++)
+        {
+            arrival_time[k] = map->columns[WORKLOAD_COLUMN_ARRIVAL_TIME][order[k]];
+            burst_time[k] = map->columns[WORKLOAD_COLUMN_BURST_TIME][order[k]];
+            priority[k] = map->columns[WORKLOAD_COLUMN_PRIORITY][order[k]];
+        }
+    }
+    else
+    {
+        for (int k = 0; k < n; k++)
+        {
+            const Process *p = &ctx->processes[order[k]];
+            arrival_time[k] = p->arrival_time;
+            burst_time[k] = p->burst_time;
+            priority[k] = p->priority;
+        }
+    }
+    columns->arrival_time = arrival_time;
+    columns->burst_time = burst_time;
+    columns->priority = priority;
+    process_columns_reset(columns);
+}
+
+/* ========================================================================================*/
+
+void process_columns_reset(ProcessColumns *columns)
+{
+    size_t n = (size_t)columns->num_processes;
+    memcpy(columns->remaining_time, columns->burst_time, n * sizeof(int));
+    memset(columns->completion_time, 0, n * sizeof(long long));
+    for (int k = 0; k < columns->num_processes; k++)
+    {
+        columns->start_time[k] = -1;
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Writes the outcome of a run back into ctx->processes.
+ */
+void process_columns_store(const ProcessColumns *columns, SchedulerContext *ctx)
+{
+    materialize_process_rows(ctx);
+    for (int k = 0; k < columns->num_processes; k++)
+    {
+        Process *p = &ctx->processes[columns->order[k]];
+        p->remaining_time = columns->remaining_time[k];
+        p->completion_time = columns->completion_time[k];
+        p->start_time = columns->start_time[k];
+        p->is_completed = (columns->remaining_time[k] == 0);
+    }
+}
+
+/* ========================================================================================*/
+
+void process_columns_free(ProcessColumns *columns)
+{
+    if (!columns->borrows_inputs)
+    {
+        free((void *)columns->arrival_time);
+        free((void *)columns->burst_time);
+        free((void *)columns->priority);
+    }
+    free(columns->remaining_time);
+    free(columns->completion_time);
+    free(columns->start_time);
+    memset(columns, 0, sizeof(*columns));
+}
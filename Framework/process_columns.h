@@ -0,0 +1,49 @@
+/*
+ * ===============================================================================
+ * PROCESS COLUMNS HEADER FILE
+ * ===============================================================================
+ *
+ * Structure-of-arrays view of a workload for the scheduling kernels. Entry k of
+ * every column belongs to the process of arrival rank k (order[k], see
+ * get_arrival_order), so:
+ *
+ * - admission cursors scan arrival_time[] sequentially
+ * - a rank doubles as the arrival time → process ID tie-breaker
+ * - loops that need one or two fields only pull those fields into the cache
+ *
+ * The public Process array stays the API: process_columns_build() gathers the
+ * input fields and process_columns_store() scatters the results back before
+ * display_results(). A workload loaded from an arrival-sorted binary file
+ * already has this layout, so its input columns point into the mapping.
+ *
+ * ===============================================================================
+ */
+
+#ifndef PROCESS_COLUMNS_H
+#define PROCESS_COLUMNS_H
+
+#include "CPU_scheduler.h"
+
+/* ========================================================================================*/
+// Structure to hold the columns, indexed by arrival rank
+typedef struct
+{
+    int num_processes;
+    const int *order;       // order[k] = index in ctx->processes of rank k
+    const int *arrival_time;    // Input fields (depend only on the workload)
+    const int *burst_time;
+    const int *priority;
+    bool borrows_inputs;    // Input fields point into ctx->mapped_input (not freed)
+    int *remaining_time;    // Per-run state (see process_columns_reset)
+    long long *completion_time;
+    long long *start_time;  // -1 until the process first runs
+} ProcessColumns;
+
+/* ========================================================================================*/
+// Column function prototypes
+void process_columns_build(ProcessColumns *columns, SchedulerContext *ctx);
+void process_columns_reset(ProcessColumns *columns);
+void process_columns_store(const ProcessColumns *columns, SchedulerContext *ctx);
+void process_columns_free(ProcessColumns *columns);
+
+#endif // PROCESS_COLUMNS_H
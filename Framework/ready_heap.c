@@ -0,0 +1,201 @@
+/**
+ * ===============================================================================
+ * READY QUEUE MIN-HEAP
+ * ===============================================================================
+ * @file ready_heap.c
+ * @brief Indexed binary min-heap used by SJF, SRTF and Priority scheduling
+ *
+ * Processes are pushed as they arrive and the best candidate is always at the
+ * root, so each scheduling decision costs O(log n) instead of a full scan.
+ * ===============================================================================
+ */
+
+#include "ready_heap.h"
+#include "sched_stats.h"
+
+/* ========================================================================================*/
+/* HEAP PRIMITIVES */
+/* ========================================================================================*/
+
+static bool entry_less(const ReadyEntry *a, const ReadyEntry *b)
+{
+    if (a->key != b->key)
+    {
+        return a->key < b->key;
+    }
+    return a->rank < b->rank;
+}
+
+/* ========================================================================================*/
+
+static void sift_up(ReadyHeap *heap, int slot)
+{
+    ReadyEntry moving = heap->entries[slot];
+    while (slot > 0)
+    {
+        int parent = (slot - 1) / 2;
+        if (!entry_less(&moving, &heap->entries[parent]))
+        {
+            break;
+        }
+        heap->entries[slot] = heap->entries[parent];
+        heap->position[heap->entries[slot].idx] = slot;
+        slot = parent;
+    }
+    heap->entries[slot] = moving;
+    heap->position[moving.idx] = slot;
+}
+
+/* ========================================================================================*/
+
+static void sift_down(ReadyHeap *heap, int slot)
+{
+    ReadyEntry moving = heap->entries[slot];
+    for (;;)
+    {
+        int best = 2 * slot + 1;
+        if (best >= heap->size)
+        {
+            break;
+        }
+        if (best + 1 < heap->size && entry_less(&heap->entries[best + 1], &heap->entries[best]))
+        {
+            best++;
+        }
+        if (!entry_less(&heap->entries[best], &moving))
+        {
+            break;
+        }
+        heap->entries[slot] = heap->entries[best];
+        heap->position[heap->entries[slot].idx] = slot;
+        slot = best;
+    }
+    heap->entries[slot] = moving;
+    heap->position[moving.idx] = slot;
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+
+/**
+ * Sets up an empty heap for indices 0 .. capacity - 1. Returns false if the
+ * storage could not be allocated (the heap is then empty and can be freed).
+ */
+bool ready_heap_try_init(ReadyHeap *heap, int capacity)
+{
+    heap->entries = NULL;
+    heap->position = NULL;
+    heap->size = 0;
+    heap->capacity = 0;
+    return ready_heap_try_reserve(heap, capacity > 0 ? capacity : 1);
+}
+
+/* ========================================================================================*/
+
+void ready_heap_free(ReadyHeap *heap)
+{
+    free(heap->entries);
+    free(heap->position);
+    heap->entries = NULL;
+    heap->position = NULL;
+    heap->size = 0;
+    heap->capacity = 0;
+}
+
+/* ========================================================================================*/
+/**
+ * Grows the heap so it can hold process indices 0 .. capacity - 1. Entries
+ * already in the heap are kept, also when it returns false (out of memory).
+ */
+bool ready_heap_try_reserve(ReadyHeap *heap, int capacity)
+{
+    if (capacity <= heap->capacity)
+    {
+        return true;
+    }
+
+    ReadyEntry *entries = realloc(heap->entries, (size_t)capacity * sizeof(ReadyEntry));
+    if (entries == NULL)
+    {
+        return false;
+    }
+    heap->entries = entries;
+    int *position = realloc(heap->position, (size_t)capacity * sizeof(int));
+    if (position == NULL)
+    {
+        return false;
+    }
+    for (int i = heap->capacity; i < capacity; i++)
+    {
+        position[i] = -1;
+    }
+
+    heap->position = position;
+    heap->capacity = capacity;
+    return true;
+}
+
+/* ========================================================================================*/
+
+void ready_heap_push(ReadyHeap *heap, int idx, int key, long long rank)
+{
+    STATS_COUNT(STAT_HEAP_PUSHES);
+    int slot = heap->size++;
+    heap->entries[slot].rank = rank;
+    heap->entries[slot].key = key;
+    heap->entries[slot].idx = idx;
+    sift_up(heap, slot);
+}
+
+/* ========================================================================================*/
+
+int ready_heap_pop(ReadyHeap *heap)
+{
+    if (heap->size == 0)
+    {
+        return -1;
+    }
+
+    STATS_COUNT(STAT_HEAP_POPS);
+    int top = heap->entries[0].idx;
+    heap->size--;
+    if (heap->size > 0)
+    {
+        heap->entries[0] = heap->entries[heap->size];
+        sift_down(heap, 0);
+    }
+    heap->position[top] = -1;
+    return top;
+}
+
+/* ========================================================================================*/
+
+int ready_heap_peek(const ReadyHeap *heap)
+{
+    return (heap->size > 0) ? heap->entries[0].idx : -1;
+}
+
+/* ========================================================================================*/
+/**
+ * Changes the key of process idx and restores the heap order.
+ */
+void ready_heap_update(ReadyHeap *heap, int idx, int key)
+{
+    int slot = heap->position[idx];
+    if (slot < 0)
+    {
+        return;
+    }
+    STATS_COUNT(STAT_HEAP_UPDATES);
+    heap->entries[slot].key = key;
+    sift_up(heap, slot);
+    sift_down(heap, heap->position[idx]);
+}
+
+/* ========================================================================================*/
+
+bool ready_heap_is_empty(const ReadyHeap *heap)
+{
+    return heap->size == 0;
+}
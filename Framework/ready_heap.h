@@ -0,0 +1,65 @@
+/*
+ * ===============================================================================
+ * READY QUEUE MIN-HEAP HEADER FILE
+ * ===============================================================================
+ *
+ * Indexed binary min-heap shared by the selection-based schedulers (SJF, SRTF,
+ * Priority). Every entry carries its own (key, rank) pair, so sifting only
+ * touches the heap array and never the process records:
+ *
+ * 1. SJF:      key = burst time
+ * 2. SRT:      key = remaining time
+ * 3. Priority: key = priority value
+ *
+ * Ties on the key go to the lower rank. The offline schedulers use the arrival
+ * rank (arrival time → process ID, see get_arrival_order), which gives the
+ * tie-breaking chain documented in CPU_scheduler.h.
+ *
+ * The heap also tracks the position of every index so a key change can be
+ * repaired in O(log n) with ready_heap_update().
+ *
+ * The try_ functions report allocation failure to the caller; ready_heap_init
+ * and ready_heap_reserve treat it as fatal and are defined with the other
+ * driver-only allocators in scheduler_alloc.c.
+ *
+ * ===============================================================================
+ */
+
+#ifndef READY_HEAP_H
+#define READY_HEAP_H
+
+#include "CPU_scheduler.h"
+
+/* ========================================================================================*/
+// One heap slot: the ordering key and tie-break rank of process index idx
+typedef struct
+{
+    long long rank;
+    int key;
+    int idx;
+} ReadyEntry;
+
+/* ========================================================================================*/
+// Structure to hold the heap state
+typedef struct
+{
+    ReadyEntry *entries;        // Heap array
+    int *position;              // position[idx] = slot of idx in entries[], -1 if absent
+    int size;                   // Number of entries currently in the heap
+    int capacity;               // Number of indices entries[] / position[] can hold
+} ReadyHeap;
+
+/* ========================================================================================*/
+// Heap function prototypes
+bool ready_heap_try_init(ReadyHeap *heap, int capacity);
+bool ready_heap_try_reserve(ReadyHeap *heap, int capacity);
+void ready_heap_init(ReadyHeap *heap, int capacity);
+void ready_heap_reserve(ReadyHeap *heap, int capacity);
+void ready_heap_free(ReadyHeap *heap);
+void ready_heap_push(ReadyHeap *heap, int idx, int key, long long rank);
+int ready_heap_pop(ReadyHeap *heap);
+int ready_heap_peek(const ReadyHeap *heap);
+void ready_heap_update(ReadyHeap *heap, int idx, int key);
+bool ready_heap_is_empty(const ReadyHeap *heap);
+
+#endif // READY_HEAP_H
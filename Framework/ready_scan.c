@@ -0,0 +1,181 @@
+/**
+ * ===============================================================================
+ * READY SCAN KERNEL
+ * ===============================================================================
+ * @file ready_scan.c
+ * @brief Masked argmin over the rank-ordered columns
+ *
+ * Two passes: a vectorized minimum of the masked keys (complete ranks count as
+ * INT_MAX), then a scalar search for the first incomplete rank holding that
+ * minimum. The first match is the lowest rank, which is the tie-breaker.
+ * ===============================================================================
+ */
+
+#include "ready_scan.h"
+#include "sched_stats.h"
+
+// With GCC or Clang the AVX2 kernel is built even when the compiler does not
+// target AVX2, and masked_min() picks it at run time if the CPU supports it
+#if defined(__AVX2__) || (defined(__SSE2__) && defined(__GNUC__))
+#define READY_SCAN_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/* ========================================================================================*/
+/* MASKED MINIMUM */
+/* ========================================================================================*/
+
+static int masked_min_scalar(const int *key, const int *remaining, int from, int count, int best)
+{
+    for (int k = from; k < count; k++)
+    {
+        if (remaining[k] > 0 && key[k] < best)
+        {
+            best = key[k];
+        }
+    }
+    return best;
+}
+
+/* ========================================================================================*/
+
+#if defined(__SSE2__)
+
+static int lane_min(const int *lanes, int num_lanes, int best)
+{
+    for (int i = 0; i < num_lanes; i++)
+    {
+        if (lanes[i] < best)
+        {
+            best = lanes[i];
+        }
+    }
+    return best;
+}
+
+#endif
+
+/* ========================================================================================*/
+
+#if defined(READY_SCAN_AVX2)
+
+__attribute__((target("avx2")))
+static int masked_min_avx2(const int *key, const int *remaining, int from, int count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i none = _mm256_set1_epi32(INT_MAX);
+    __m256i best = none;
+
+    int k = from;
+    for (; k + 8 <= count; k += 8)
+    {
+        __m256i keys = _mm256_loadu_si256((const __m256i *)(key + k));
+        __m256i live = _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i *)(remaining + k)), zero);
+        best = _mm256_min_epi32(best, _mm256_blendv_epi8(none, keys, live));
+    }
+
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, best);
+    return lane_min(lanes, 8, masked_min_scalar(key, remaining, k, count, INT_MAX));
+}
+
+#endif
+
+/* ========================================================================================*/
+
+#if defined(__AVX2__)
+
+static int masked_min(const int *key, const int *remaining, int from, int count)
+{
+    return masked_min_avx2(key, remaining, from, count);
+}
+
+#elif defined(__SSE2__)
+
+static int masked_min_sse2(const int *key, const int *remaining, int from, int count)
+{
+    // SSE2 has no 32-bit min or blend, so both are built from compare masks
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i none = _mm_set1_epi32(INT_MAX);
+    __m128i best = none;
+
+    int k = from;
+    for (; k + 4 <= count; k += 4)
+    {
+        __m128i keys = _mm_loadu_si128((const __m128i *)(key + k));
+        __m128i live = _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i *)(remaining + k)), zero);
+        __m128i masked = _mm_or_si128(_mm_and_si128(live, keys), _mm_andnot_si128(live, none));
+        __m128i lower = _mm_cmpgt_epi32(best, masked);
+        best = _mm_or_si128(_mm_and_si128(lower, masked), _mm_andnot_si128(lower, best));
+    }
+
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, best);
+    return lane_min(lanes, 4, masked_min_scalar(key, remaining, k, count, INT_MAX));
+}
+
+static int masked_min(const int *key, const int *remaining, int from, int count)
+{
+#if defined(READY_SCAN_AVX2)
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return masked_min_avx2(key, remaining, from, count);
+    }
+#endif
+    return masked_min_sse2(key, remaining, from, count);
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+static int masked_min(const int *key, const int *remaining, int from, int count)
+{
+    const int32x4_t zero = vdupq_n_s32(0);
+    const int32x4_t none = vdupq_n_s32(INT_MAX);
+    int32x4_t best = none;
+
+    int k = from;
+    for (; k + 4 <= count; k += 4)
+    {
+        uint32x4_t live = vcgtq_s32(vld1q_s32(remaining + k), zero);
+        best = vminq_s32(best, vbslq_s32(live, vld1q_s32(key + k), none));
+    }
+
+    int tail = masked_min_scalar(key, remaining, k, count, INT_MAX);
+    int lanes = vminvq_s32(best);
+    return (lanes < tail) ? lanes : tail;
+}
+
+#else
+
+static int masked_min(const int *key, const int *remaining, int from, int count)
+{
+    return masked_min_scalar(key, remaining, from, count, INT_MAX);
+}
+
+#endif
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+
+int ready_scan_argmin(const int *key, const int *remaining, int from, int count)
+{
+    STATS_COUNT(STAT_SCANS);
+    STATS_ADD(STAT_SCAN_ENTRIES, count - from);
+    int best = masked_min(key, remaining, from, count);
+
+    // A key of INT_MAX is indistinguishable from the mask, so the search also
+    // decides whether any incomplete rank exists at all
+    for (int k = from; k < count; k++)
+    {
+        if (remaining[k] > 0 && key[k] == best)
+        {
+            return k;
+        }
+    }
+    return -1;
+}
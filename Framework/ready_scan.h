@@ -0,0 +1,37 @@
+/*
+ * ===============================================================================
+ * READY SCAN KERNEL HEADER FILE
+ * ===============================================================================
+ *
+ * Vectorized selection over the rank-ordered columns (see process_columns.h)
+ * for workloads small enough that a linear scan beats maintaining a heap.
+ *
+ * ready_scan_argmin(key, remaining, from, count) returns the rank k in
+ * [from, count) with the smallest (key[k], k) among the incomplete ranks
+ * (remaining[k] > 0), or -1 when all of them are complete. Ranks below the
+ * arrival cursor are exactly the arrived processes and the rank orders arrival
+ * time → process ID, so this is the masked lexicographic minimum over
+ * (key, arrival_time, pid). from lets callers skip a completed prefix.
+ *
+ * The kernel uses AVX2, SSE2 or NEON when the compiler targets them and plain
+ * C otherwise; all variants return the same rank. On x86 with GCC or Clang the
+ * AVX2 variant is always built and chosen at run time when the CPU has AVX2.
+ *
+ * ===============================================================================
+ */
+
+#ifndef READY_SCAN_H
+#define READY_SCAN_H
+
+#include "CPU_scheduler.h"
+
+// Largest workload the selection-based engines schedule by scanning
+#ifndef READY_SCAN_MAX_PROCESSES
+#define READY_SCAN_MAX_PROCESSES 32
+#endif
+
+/* ========================================================================================*/
+// Ready scan function prototypes
+int ready_scan_argmin(const int *key, const int *remaining, int from, int count);
+
+#endif // READY_SCAN_H
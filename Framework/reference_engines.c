@@ -0,0 +1,641 @@
+/**
+ * ===============================================================================
+ * REFERENCE ENGINES
+ * ===============================================================================
+ * @file reference_engines.c
+ * @brief Straightforward scheduling loops used as a correctness oracle
+ *
+ * These are the tick and scan based loops the Skeleton_codes engines started
+ * from, moved onto a private job array of any size. The only intended change
+ * is that Priority RR visits equal-priority jobs in arrival time → PID order
+ * (rule 4 in CPU_scheduler.h) instead of input order, as the optimized engine
+ * does. Keep them simple: their value is that they are obviously right.
+ * ===============================================================================
+ */
+
+#include "reference_engines.h"
+#include "feedback_scheduler.h"
+
+/* ========================================================================================*/
+// One job of the private copy
+typedef struct
+{
+    int pid;
+    int arrival_time;
+    int burst_time;
+    int priority;
+    int remaining_time;
+    int completion_time;
+    int input_index;        // Position in the caller's array
+} ReferenceJob;
+
+/* ========================================================================================*/
+
+static bool arrives_before(const ReferenceJob *a, const ReferenceJob *b)
+{
+    return a->arrival_time < b->arrival_time || (a->arrival_time == b->arrival_time && a->pid < b->pid);
+}
+
+/* ========================================================================================*/
+
+// Copies the rows, sorted by arrival time → PID (insertion sort)
+static ReferenceJob *copy_jobs(const Process *processes, int n)
+{
+    ReferenceJob *jobs = scheduler_alloc((size_t)n, sizeof(ReferenceJob));
+    for (int i = 0; i < n; i++)
+    {
+        ReferenceJob job = {processes[i].pid, processes[i].arrival_time, processes[i].burst_time,
+                            processes[i].priority, processes[i].burst_time, -1, i};
+        int j = i;
+        while (j > 0 && arrives_before(&job, &jobs[j - 1]))
+        {
+            jobs[j] = jobs[j - 1];
+            j--;
+        }
+        jobs[j] = job;
+    }
+    return jobs;
+}
+
+/* ========================================================================================*/
+
+// Earliest arrival after time among unfinished jobs, INT_MAX if none
+static int next_arrival_after(const ReferenceJob *jobs, int n, int time)
+{
+    int next = INT_MAX;
+    for (int i = 0; i < n; i++)
+    {
+        if (jobs[i].remaining_time > 0 && jobs[i].arrival_time > time && jobs[i].arrival_time < next)
+        {
+            next = jobs[i].arrival_time;
+        }
+    }
+    return next;
+}
+
+/* ========================================================================================*/
+/* NON-PREEMPTIVE */
+/* ========================================================================================*/
+
+static void reference_fcfs(ReferenceJob *jobs, int n)
+{
+    int time = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (time < jobs[i].arrival_time)
+        {
+            time = jobs[i].arrival_time;
+        }
+        time += jobs[i].burst_time;
+        jobs[i].completion_time = time;
+        jobs[i].remaining_time = 0;
+    }
+}
+
+/* ========================================================================================*/
+
+// SJF (by_priority = false) or Priority non-preemptive: repeatedly run the best arrived job
+static void reference_select_to_completion(ReferenceJob *jobs, int n, bool by_priority)
+{
+    int time = 0;
+    for (int completed = 0; completed < n;)
+    {
+        int best = -1;
+        for (int i = 0; i < n; i++)
+        {
+            ReferenceJob *p = &jobs[i];
+            if (p->remaining_time == 0 || p->arrival_time > time)
+            {
+                continue;
+            }
+            int key = by_priority ? p->priority : p->burst_time;
+            int best_key = (best < 0) ? INT_MAX : (by_priority ? jobs[best].priority : jobs[best].burst_time);
+            if (best < 0 || key < best_key || (key == best_key && arrives_before(p, &jobs[best])))
+            {
+                best = i;
+            }
+        }
+
+        if (best < 0)
+        {
+            time = next_arrival_after(jobs, n, time);
+            continue;
+        }
+        time += jobs[best].burst_time;
+        jobs[best].completion_time = time;
+        jobs[best].remaining_time = 0;
+        completed++;
+    }
+}
+
+/* ========================================================================================*/
+/* PREEMPTIVE */
+/* ========================================================================================*/
+
+// One time unit at a time for the arrived job with the least remaining time
+static void reference_srtf(ReferenceJob *jobs, int n)
+{
+    int time = 0;
+    for (int completed = 0; completed < n;)
+    {
+        int shortest = -1;
+        for (int i = 0; i < n; i++)
+        {
+            ReferenceJob *p = &jobs[i];
+            if (p->remaining_time > 0 && p->arrival_time <= time &&
+                (shortest < 0 || p->remaining_time < jobs[shortest].remaining_time ||
+                 (p->remaining_time == jobs[shortest].remaining_time && arrives_before(p, &jobs[shortest]))))
+            {
+                shortest = i;
+            }
+        }
+
+        if (shortest < 0)
+        {
+            time = next_arrival_after(jobs, n, time);
+            continue;
+        }
+        jobs[shortest].remaining_time--;
+        time++;
+        if (jobs[shortest].remaining_time == 0)
+        {
+            jobs[shortest].completion_time = time;
+            completed++;
+        }
+    }
+}
+
+/* ========================================================================================*/
+
+// FIFO of job indices; every job is queued at most once at a time
+static void reference_rr(ReferenceJob *jobs, int n, int time_quantum)
+{
+    int *queue = scheduler_alloc((size_t)n, sizeof(int));
+    bool *queued = scheduler_alloc((size_t)n, sizeof(bool));
+    int head = 0, count = 0;
+    int time = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        queued[i] = (jobs[i].arrival_time == 0);
+        if (queued[i])
+        {
+            queue[(head + count++) % n] = i;
+        }
+    }
+
+    for (int completed = 0; completed < n;)
+    {
+        if (count == 0)
+        {
+            time = next_arrival_after(jobs, n, time);
+            for (int i = 0; i < n; i++)
+            {
+                if (jobs[i].remaining_time > 0 && jobs[i].arrival_time == time && !queued[i])
+                {
+                    queue[(head + count++) % n] = i;
+                    queued[i] = true;
+                }
+            }
+            continue;
+        }
+
+        int idx = queue[head];
+        head = (head + 1) % n;
+        count--;
+        queued[idx] = false;
+
+        ReferenceJob *p = &jobs[idx];
+        int start = time;
+        int slice = (p->remaining_time < time_quantum) ? p->remaining_time : time_quantum;
+        time += slice;
+        p->remaining_time -= slice;
+
+        // Arrivals during the slice go in before the preempted job
+        for (int i = 0; i < n; i++)
+        {
+            if (i != idx && jobs[i].remaining_time > 0 && !queued[i] && jobs[i].arrival_time > start &&
+                jobs[i].arrival_time <= time)
+            {
+                queue[(head + count++) % n] = i;
+                queued[i] = true;
+            }
+        }
+
+        if (p->remaining_time == 0)
+        {
+            p->completion_time = time;
+            completed++;
+        }
+        else
+        {
+            queue[(head + count++) % n] = idx;
+            queued[idx] = true;
+        }
+    }
+    free(queue);
+    free(queued);
+}
+
+/* ========================================================================================*/
+
+// Cycles over the highest-priority jobs present at the start of the cycle; a
+// higher-priority arrival ends the cycle after the current time unit
+static void reference_priority_rr(ReferenceJob *jobs, int n, int time_quantum)
+{
+    int *cycle = scheduler_alloc((size_t)n, sizeof(int));
+    int time = 0;
+    int completed = 0;
+
+    while (completed < n)
+    {
+        int highest = INT_MAX;
+        int cycle_length = 0;
+        for (int i = 0; i < n; i++)
+        {
+            if (jobs[i].arrival_time <= time && jobs[i].remaining_time > 0)
+            {
+                if (jobs[i].priority < highest)
+                {
+                    highest = jobs[i].priority;
+                    cycle_length = 0;
+                }
+                if (jobs[i].priority == highest)
+                {
+                    cycle[cycle_length++] = i;
+                }
+            }
+        }
+
+        if (cycle_length == 0)
+        {
+            time = next_arrival_after(jobs, n, time);
+            continue;
+        }
+
+        bool higher_priority_arrived = false;
+        for (int r = 0; r < cycle_length && !higher_priority_arrived; r++)
+        {
+            ReferenceJob *p = &jobs[cycle[r]];
+            int slice = (p->remaining_time < time_quantum) ? p->remaining_time : time_quantum;
+            for (int t = 0; t < slice && !higher_priority_arrived; t++)
+            {
+                time++;
+                p->remaining_time--;
+                if (p->remaining_time == 0)
+                {
+                    p->completion_time = time;
+                    completed++;
+                }
+                for (int j = 0; j < n; j++)
+                {
+                    if (jobs[j].arrival_time == time && jobs[j].remaining_time > 0 && jobs[j].priority < highest)
+                    {
+                        higher_priority_arrived = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    free(cycle);
+}
+
+/* ========================================================================================*/
+
+// Priority RR as smp_scheduler() runs it on one core: ready jobs are ordered by
+// (priority, queue order), an arrival is queued at once and a strictly higher
+// priority one preempts; an expired quantum is queued behind the arrivals
+static void reference_priority_rr_rotating(ReferenceJob *jobs, int n, int time_quantum)
+{
+    long long *order = scheduler_alloc((size_t)n, sizeof(long long));
+    bool *queued = scheduler_alloc((size_t)n, sizeof(bool));
+    long long next_order = 0;
+    int running = -1;
+    int slice_end = 0;
+    int time = 0;
+
+    for (int completed = 0; completed < n;)
+    {
+        int expired = -1;
+        if (running >= 0 && time == slice_end)
+        {
+            if (jobs[running].remaining_time == 0)
+            {
+                jobs[running].completion_time = time;
+                completed++;
+            }
+            else
+            {
+                expired = running;
+            }
+            running = -1;
+        }
+
+        // Arrivals in arrival time → PID order; a preempted job keeps its queue order
+        for (int i = 0; i < n; i++)
+        {
+            if (jobs[i].arrival_time == time)
+            {
+                order[i] = next_order++;
+                queued[i] = true;
+                if (running >= 0 && jobs[i].priority < jobs[running].priority)
+                {
+                    queued[running] = true;
+                    running = -1;
+                }
+            }
+        }
+        if (expired >= 0)
+        {
+            order[expired] = next_order++;
+            queued[expired] = true;
+        }
+
+        if (running < 0)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                if (queued[i] && (running < 0 || jobs[i].priority < jobs[running].priority ||
+                                  (jobs[i].priority == jobs[running].priority && order[i] < order[running])))
+                {
+                    running = i;
+                }
+            }
+            if (running < 0)
+            {
+                time = next_arrival_after(jobs, n, time);
+                continue;
+            }
+            queued[running] = false;
+            ReferenceJob *p = &jobs[running];
+            slice_end = time + ((p->remaining_time < time_quantum) ? p->remaining_time : time_quantum);
+        }
+
+        time++;
+        jobs[running].remaining_time--;
+    }
+    free(order);
+    free(queued);
+}
+
+/* ========================================================================================*/
+/* FEEDBACK */
+/* ========================================================================================*/
+
+// Queued job with the lowest (level, queue order), -1 if none; order 0 = not queued
+static int reference_pick_level(const int *level, const long long *order, int n)
+{
+    int best = -1;
+    for (int i = 0; i < n; i++)
+    {
+        if (order[i] > 0 && (best < 0 || level[i] < level[best] ||
+                             (level[i] == level[best] && order[i] < order[best])))
+        {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/* ========================================================================================*/
+
+// MLFQ one time unit at a time; a boost renumbers the queue in (level, order) order
+static void reference_mlfq(ReferenceJob *jobs, int n, const MlfqConfig *config)
+{
+    int *level = scheduler_alloc((size_t)n, sizeof(int));
+    int *used = scheduler_alloc((size_t)n, sizeof(int));
+    long long *order = scheduler_alloc((size_t)n, sizeof(long long));
+    long long sequence = 0;
+    long long next_boost = config->boost_interval;
+    int time = 0;
+    int admitted = 0;
+
+    for (int completed = 0; completed < n;)
+    {
+        for (; admitted < n && jobs[admitted].arrival_time <= time; admitted++)
+        {
+            level[admitted] = 0;
+            used[admitted] = 0;
+            order[admitted] = ++sequence;
+        }
+        if (config->boost_interval > 0 && time >= next_boost)
+        {
+            for (int next; (next = reference_pick_level(level, order, n)) >= 0;)
+            {
+                level[next] = 0;
+                used[next] = 0;
+                order[next] = -(++sequence);        // Parked until every job is renumbered
+            }
+            for (int i = 0; i < n; i++)
+            {
+                order[i] = (order[i] < 0) ? -order[i] : order[i];
+            }
+            next_boost = ((long long)time / config->boost_interval + 1) * config->boost_interval;
+        }
+
+        int current = reference_pick_level(level, order, n);
+        if (current < 0)
+        {
+            time = jobs[admitted].arrival_time;
+            continue;
+        }
+        ReferenceJob *p = &jobs[current];
+        order[current] = 0;
+
+        bool preempted = false;
+        while (p->remaining_time > 0 && used[current] < config->quantum[level[current]] && !preempted)
+        {
+            time++;
+            p->remaining_time--;
+            used[current]++;
+            for (; admitted < n && jobs[admitted].arrival_time <= time; admitted++)
+            {
+                level[admitted] = 0;
+                used[admitted] = 0;
+                order[admitted] = ++sequence;
+                preempted = preempted || level[current] > 0;
+            }
+        }
+
+        if (p->remaining_time == 0)
+        {
+            p->completion_time = time;
+            completed++;
+            continue;
+        }
+        if (used[current] >= config->quantum[level[current]])
+        {
+            level[current] = (level[current] + 1 < config->num_levels) ? level[current] + 1 : level[current];
+            used[current] = 0;
+        }
+        order[current] = ++sequence;
+    }
+    free(level);
+    free(used);
+    free(order);
+}
+
+/* ========================================================================================*/
+
+// Promotions due at time (oldest queue entry first), then arrivals at time
+static void reference_aging_tick(const ReferenceJob *jobs, int n, int time, int interval, const int *base_level,
+                                 int *level, int *entered, long long *order, long long *sequence)
+{
+    for (;;)
+    {
+        int due = -1;
+        for (int i = 0; i < n; i++)
+        {
+            if (order[i] > 0 && level[i] > 0 && entered[i] + interval == time &&
+                (due < 0 || order[i] < order[due]))
+            {
+                due = i;
+            }
+        }
+        if (due < 0)
+        {
+            break;
+        }
+        level[due]--;
+        entered[due] = time;
+        order[due] = ++(*sequence);
+    }
+    for (int i = 0; i < n; i++)
+    {
+        if (jobs[i].arrival_time == time)
+        {
+            level[i] = base_level[i];
+            entered[i] = time;
+            order[i] = ++(*sequence);
+        }
+    }
+}
+
+// Priority with aging one time unit at a time; time_quantum 0 = non-preemptive
+static void reference_aging(ReferenceJob *jobs, int n, const AgingConfig *config)
+{
+    int *base_level = scheduler_alloc((size_t)n, sizeof(int));
+    int *level = scheduler_alloc((size_t)n, sizeof(int));
+    int *entered = scheduler_alloc((size_t)n, sizeof(int));
+    long long *order = scheduler_alloc((size_t)n, sizeof(long long));
+    long long sequence = 0;
+    for (int i = 0; i < n; i++)
+    {
+        // Dense level: number of distinct smaller priority values
+        for (int j = 0; j < n; j++)
+        {
+            bool first = true;
+            for (int k = 0; k < j && first; k++)
+            {
+                first = jobs[k].priority != jobs[j].priority;
+            }
+            base_level[i] += first && jobs[j].priority < jobs[i].priority;
+        }
+    }
+
+    int time = 0;
+    reference_aging_tick(jobs, n, time, config->aging_interval, base_level, level, entered, order, &sequence);
+    for (int completed = 0; completed < n;)
+    {
+        int current = reference_pick_level(level, order, n);
+        if (current < 0)
+        {
+            time = next_arrival_after(jobs, n, time);
+            reference_aging_tick(jobs, n, time, config->aging_interval, base_level, level, entered, order,
+                                 &sequence);
+            continue;
+        }
+        ReferenceJob *p = &jobs[current];
+        order[current] = 0;
+
+        int dispatch_level = level[current];
+        bool preempted = false;
+        for (int t = 0; p->remaining_time > 0 && !preempted &&
+                        (config->time_quantum == 0 || t < config->time_quantum); t++)
+        {
+            time++;
+            p->remaining_time--;
+            reference_aging_tick(jobs, n, time, config->aging_interval, base_level, level, entered, order,
+                                 &sequence);
+            for (int j = 0; j < n && config->time_quantum > 0; j++)
+            {
+                preempted = preempted || (jobs[j].arrival_time == time && base_level[j] < dispatch_level);
+            }
+        }
+
+        if (p->remaining_time == 0)
+        {
+            p->completion_time = time;
+            completed++;
+            continue;
+        }
+        level[current] = base_level[current];
+        entered[current] = time;
+        order[current] = ++sequence;
+    }
+    free(base_level);
+    free(level);
+    free(entered);
+    free(order);
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+
+void reference_schedule(ReferencePolicy policy, const Process *processes, int n, int time_quantum,
+                        long long *completion_time)
+{
+    if (n <= 0)
+    {
+        return;
+    }
+    ReferenceJob *jobs = copy_jobs(processes, n);
+
+    switch (policy)
+    {
+    case REFERENCE_FCFS:
+        reference_fcfs(jobs, n);
+        break;
+    case REFERENCE_SJF:
+        reference_select_to_completion(jobs, n, false);
+        break;
+    case REFERENCE_SRTF:
+        reference_srtf(jobs, n);
+        break;
+    case REFERENCE_RR:
+        reference_rr(jobs, n, time_quantum);
+        break;
+    case REFERENCE_PRIORITY_NP:
+        reference_select_to_completion(jobs, n, true);
+        break;
+    case REFERENCE_PRIORITY_RR:
+        reference_priority_rr(jobs, n, time_quantum);
+        break;
+    case REFERENCE_PRIORITY_RR_ROTATING:
+        reference_priority_rr_rotating(jobs, n, time_quantum);
+        break;
+    case REFERENCE_MLFQ:
+    {
+        MlfqConfig config;
+        mlfq_config_init(&config, time_quantum);
+        reference_mlfq(jobs, n, &config);
+        break;
+    }
+    case REFERENCE_PRIORITY_NP_AGING:
+    case REFERENCE_PRIORITY_RR_AGING:
+    {
+        AgingConfig config;
+        aging_config_init(&config, (policy == REFERENCE_PRIORITY_RR_AGING) ? time_quantum : 0);
+        reference_aging(jobs, n, &config);
+        break;
+    }
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        completion_time[jobs[i].input_index] = jobs[i].completion_time;
+    }
+    free(jobs);
+}
@@ -0,0 +1,46 @@
+/*
+ * ===============================================================================
+ * REFERENCE ENGINES HEADER FILE
+ * ===============================================================================
+ *
+ * The original, deliberately simple scheduling loops (linear scans, one time
+ * unit at a time for SRTF and Priority RR), kept as the oracle for the
+ * differential harness (see differential.h). They follow the tie-breaking
+ * rules in CPU_scheduler.h and share nothing with the optimized engines: no
+ * heaps, buckets, columns or scratch buffers, and no context switch costs.
+ *
+ * Each engine schedules a private copy of the rows and writes the completion
+ * time of processes[i] to completion_time[i]. The feedback policies (see
+ * feedback_scheduler.h) use their default settings for the given quantum.
+ * They are O(n^2) or worse and only meant for small workloads.
+ *
+ * ===============================================================================
+ */
+
+#ifndef REFERENCE_ENGINES_H
+#define REFERENCE_ENGINES_H
+
+#include "CPU_scheduler.h"
+
+/* ========================================================================================*/
+// Reference policies
+typedef enum
+{
+    REFERENCE_FCFS,
+    REFERENCE_SJF,
+    REFERENCE_SRTF,
+    REFERENCE_RR,
+    REFERENCE_PRIORITY_NP,
+    REFERENCE_PRIORITY_RR,
+    REFERENCE_MLFQ,                 // mlfq_config_init(quantum)
+    REFERENCE_PRIORITY_NP_AGING,    // aging_config_init(0)
+    REFERENCE_PRIORITY_RR_AGING,    // aging_config_init(quantum)
+    REFERENCE_PRIORITY_RR_ROTATING  // Same-priority arrivals rotate at once, as in smp_scheduler()
+} ReferencePolicy;
+
+/* ========================================================================================*/
+// Reference function prototypes
+void reference_schedule(ReferencePolicy policy, const Process *processes, int n, int time_quantum,
+                        long long *completion_time);
+
+#endif // REFERENCE_ENGINES_H
@@ -0,0 +1,456 @@
+/**
+ * ===============================================================================
+ * RESULT WRITER
+ * ===============================================================================
+ * @file result_writer.c
+ * @brief Buffered text / CSV / NDJSON / binary result reports
+ * ===============================================================================
+ */
+
+#include "result_writer.h"
+
+// Room kept free before formatting one record or summary line; the
+// algorithm name is copied separately since its length is not bounded
+#define MAX_RECORD_LENGTH 256
+
+/* ========================================================================================*/
+/* FORMATTING PRIMITIVES */
+/* ========================================================================================*/
+
+/**
+ * Writes value in decimal at out and returns the number of characters, like
+ * "%lld" without the terminating '\0'.
+ */
+static size_t format_integer(char *out, long long value)
+{
+    char digits[20];
+    size_t count = 0, length = 0;
+
+    // Negate in unsigned arithmetic so LLONG_MIN does not overflow
+    unsigned long long magnitude = (unsigned long long)value;
+    if (value < 0)
+    {
+        out[length++] = '-';
+        magnitude = 0ULL - magnitude;
+    }
+
+    do
+    {
+        digits[count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    while (count > 0)
+    {
+        out[length++] = digits[--count];
+    }
+    return length;
+}
+
+/* ========================================================================================*/
+
+// Formats value left-justified in a field of width characters ("%-<width>lld")
+static size_t format_padded(char *out, long long value, size_t width)
+{
+    size_t length = format_integer(out, value);
+    while (length < width)
+    {
+        out[length++] = ' ';
+    }
+    return length;
+}
+
+/* ========================================================================================*/
+
+// Makes sure at least length more bytes fit into the buffer
+static char *reserve_output(ResultWriter *writer, size_t length)
+{
+    if (writer->length + length > RESULT_WRITER_BUFFER_SIZE)
+    {
+        result_writer_flush(writer);
+    }
+    return writer->buffer + writer->length;
+}
+
+/* ========================================================================================*/
+
+static void append_bytes(ResultWriter *writer, const void *bytes, size_t length)
+{
+    if (length > RESULT_WRITER_BUFFER_SIZE)
+    {
+        result_writer_flush(writer);
+        writer->failed |= (fwrite(bytes, 1, length, writer->stream) != length);
+        return;
+    }
+    memcpy(reserve_output(writer, length), bytes, length);
+    writer->length += length;
+}
+
+/* ========================================================================================*/
+
+static void append_text(ResultWriter *writer, const char *text)
+{
+    append_bytes(writer, text, strlen(text));
+}
+
+/* ========================================================================================*/
+
+// Appends text as a JSON string literal
+static void append_json_string(ResultWriter *writer, const char *text)
+{
+    static const char HEX[] = "0123456789abcdef";
+
+    append_text(writer, "\"");
+    for (const unsigned char *c = (const unsigned char *)text; *c != '\0'; c++)
+    {
+        char *out = reserve_output(writer, 6);
+        size_t length = 0;
+        if (*c == '"' || *c == '\\')
+        {
+            out[length++] = '\\';
+            out[length++] = (char)*c;
+        }
+        else if (*c < 0x20)
+        {
+            memcpy(out, "\\u00", 4);
+            out[4] = HEX[*c >> 4];
+            out[5] = HEX[*c & 0xF];
+            length = 6;
+        }
+        else
+        {
+            out[length++] = (char)*c;
+        }
+        writer->length += length;
+    }
+    append_text(writer, "\"");
+}
+
+/* ========================================================================================*/
+
+// Appends text as a CSV field, quoted only when it needs to be
+static void append_csv_field(ResultWriter *writer, const char *text)
+{
+    if (strpbrk(text, ",\"\n\r") == NULL)
+    {
+        append_text(writer, text);
+        return;
+    }
+
+    append_text(writer, "\"");
+    for (const char *c = text; *c != '\0'; c++)
+    {
+        char *out = reserve_output(writer, 2);
+        size_t length = 0;
+        if (*c == '"')
+        {
+            out[length++] = '"';
+        }
+        out[length++] = *c;
+        writer->length += length;
+    }
+    append_text(writer, "\"");
+}
+
+/* ========================================================================================*/
+
+// Appends a printf-formatted segment of at most MAX_RECORD_LENGTH bytes
+static void append_format(ResultWriter *writer, const char *format, double first, double second)
+{
+    char *out = reserve_output(writer, MAX_RECORD_LENGTH);
+    int length = snprintf(out, MAX_RECORD_LENGTH, format, first, second);
+    if (length > 0)
+    {
+        writer->length += (size_t)min_value(length, MAX_RECORD_LENGTH - 1);
+    }
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+
+/**
+ * Starts a writer on stream. buffer holds RESULT_WRITER_BUFFER_SIZE bytes and
+ * stays the caller's, so repeated reports can share one; NULL = allocate one.
+ */
+void result_writer_init(ResultWriter *writer, FILE *stream, ResultFormat format, char *buffer)
+{
+    writer->stream = stream;
+    writer->format = format;
+    writer->algorithm = "";
+    writer->owns_buffer = (buffer == NULL);
+    writer->buffer = (buffer != NULL) ? buffer : scheduler_alloc(RESULT_WRITER_BUFFER_SIZE, 1);
+    writer->length = 0;
+    writer->failed = false;
+}
+
+/* ========================================================================================*/
+/**
+ * Starts the report of one algorithm. num_records is the number of rows that
+ * follow (0 = summary only, -1 = not known up front); the binary header needs
+ * the exact count and the totals in metrics.
+ */
+void result_writer_begin(ResultWriter *writer, const char *algorithm, const ScheduleMetrics *metrics,
+                         long long num_processes, int num_records)
+{
+    writer->algorithm = algorithm;
+
+    switch (writer->format)
+    {
+    case RESULT_FORMAT_TEXT:
+        append_text(writer, algorithm);
+        append_text(writer, "\n");
+        if (num_records != 0)
+        {
+            append_text(writer, "PID      Turnaround_Time      Waiting_Time\n");
+        }
+        break;
+    case RESULT_FORMAT_CSV:
+    case RESULT_FORMAT_NDJSON:
+        break;
+    case RESULT_FORMAT_BINARY:
+    {
+        ResultBlockHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, RESULT_MAGIC, RESULT_MAGIC_SIZE);
+        header.version = RESULT_FORMAT_VERSION;
+        header.byte_order = RESULT_BYTE_ORDER_MARK;
+        header.num_records = (uint64_t)(num_records > 0 ? num_records : 0);
+        header.num_processes = (uint64_t)num_processes;
+        header.total_turnaround = metrics->total_turnaround;
+        header.total_waiting = metrics->total_waiting;
+        strncpy(header.algorithm, algorithm, RESULT_ALGORITHM_NAME_SIZE - 1);
+        append_bytes(writer, &header, sizeof(header));
+        break;
+    }
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Appends one per-process record. In text mode this is byte-for-byte what
+ * "%-9d%-21d%d\n" prints.
+ */
+void result_writer_row(ResultWriter *writer, int pid, long long completion, long long turnaround,
+                       long long waiting)
+{
+    char *out = reserve_output(writer, MAX_RECORD_LENGTH);
+    size_t length = 0;
+
+    switch (writer->format)
+    {
+    case RESULT_FORMAT_TEXT:
+        length = format_padded(out, pid, 9);
+        length += format_padded(out + length, turnaround, 21);
+        length += format_integer(out + length, waiting);
+        out[length++] = '\n';
+        break;
+    case RESULT_FORMAT_CSV:
+        append_text(writer, "process,");
+        append_csv_field(writer, writer->algorithm);
+        out = reserve_output(writer, MAX_RECORD_LENGTH);
+        out[length++] = ',';
+        length += format_integer(out + length, pid);
+        out[length++] = ',';
+        length += format_integer(out + length, completion);
+        out[length++] = ',';
+        length += format_integer(out + length, turnaround);
+        out[length++] = ',';
+        length += format_integer(out + length, waiting);
+        out[length++] = '\n';
+        break;
+    case RESULT_FORMAT_NDJSON:
+        append_text(writer, "{\"type\":\"process\",\"algorithm\":");
+        append_json_string(writer, writer->algorithm);
+        out = reserve_output(writer, MAX_RECORD_LENGTH);
+        memcpy(out, ",\"pid\":", 7);
+        length = 7;
+        length += format_integer(out + length, pid);
+        memcpy(out + length, ",\"completion_time\":", 19);
+        length += 19;
+        length += format_integer(out + length, completion);
+        memcpy(out + length, ",\"turnaround_time\":", 19);
+        length += 19;
+        length += format_integer(out + length, turnaround);
+        memcpy(out + length, ",\"waiting_time\":", 16);
+        length += 16;
+        length += format_integer(out + length, waiting);
+        memcpy(out + length, "}\n", 2);
+        length += 2;
+        break;
+    case RESULT_FORMAT_BINARY:
+    {
+        ResultRecord record = {(int32_t)pid, 0, (int64_t)completion, (int64_t)turnaround, (int64_t)waiting};
+        memcpy(out, &record, sizeof(record));
+        length = sizeof(record);
+        break;
+    }
+    }
+    writer->length += length;
+}
+
+/* ========================================================================================*/
+/**
+ * Ends the report with the averages, plus the tail metrics of
+ * measure_waiting_percentiles (REPORT_TAIL_METRICS) and the context switch
+ * statistics (REPORT_SWITCH_STATS) where the format has a place for them. The
+ * binary header already carries the totals.
+ */
+void result_writer_summary(ResultWriter *writer, const ScheduleMetrics *metrics, long long num_processes,
+                           unsigned report_flags)
+{
+    bool tail_metrics = (report_flags & REPORT_TAIL_METRICS) != 0;
+    bool switch_stats = (report_flags & REPORT_SWITCH_STATS) != 0;
+    char *out;
+    size_t length;
+
+    switch (writer->format)
+    {
+    case RESULT_FORMAT_TEXT:
+        append_format(writer, "Average Turnaround Time: %.2f\nAverage Waiting Time: %.2f\n",
+                      metrics->avg_turnaround, metrics->avg_waiting);
+        if (tail_metrics)
+        {
+            out = reserve_output(writer, MAX_RECORD_LENGTH);
+            length = (size_t)snprintf(out, MAX_RECORD_LENGTH,
+                                      "Waiting Time p50/p95/p99: %lld / %lld / %lld\nMax Response Time: %lld\n",
+                                      metrics->waiting_p50, metrics->waiting_p95, metrics->waiting_p99,
+                                      metrics->max_response);
+            writer->length += length;
+        }
+        if (switch_stats)
+        {
+            out = reserve_output(writer, MAX_RECORD_LENGTH);
+            length = (size_t)snprintf(out, MAX_RECORD_LENGTH,
+                                      "Context Switches: %lld\nSwitch Overhead: %lld\nCPU Utilization: %.2f%%\n",
+                                      metrics->num_switches, metrics->switch_overhead,
+                                      metrics->cpu_utilization * 100.0);
+            writer->length += length;
+        }
+        break;
+    case RESULT_FORMAT_CSV:
+        append_text(writer, "summary,");
+        append_csv_field(writer, writer->algorithm);
+        append_format(writer, ",,,%.6f,%.6f\n", metrics->avg_turnaround, metrics->avg_waiting);
+        break;
+    case RESULT_FORMAT_NDJSON:
+        append_text(writer, "{\"type\":\"summary\",\"algorithm\":");
+        append_json_string(writer, writer->algorithm);
+        out = reserve_output(writer, MAX_RECORD_LENGTH);
+        memcpy(out, ",\"processes\":", 13);
+        length = 13;
+        length += format_integer(out + length, num_processes);
+        memcpy(out + length, ",\"total_turnaround_time\":", 25);
+        length += 25;
+        length += format_integer(out + length, metrics->total_turnaround);
+        memcpy(out + length, ",\"total_waiting_time\":", 22);
+        length += 22;
+        length += format_integer(out + length, metrics->total_waiting);
+        writer->length += length;
+        append_format(writer, ",\"avg_turnaround_time\":%.6f,\"avg_waiting_time\":%.6f",
+                      metrics->avg_turnaround, metrics->avg_waiting);
+        if (tail_metrics)
+        {
+            out = reserve_output(writer, MAX_RECORD_LENGTH);
+            length = (size_t)snprintf(out, MAX_RECORD_LENGTH,
+                                      ",\"waiting_time_p50\":%lld,\"waiting_time_p95\":%lld,"
+                                      "\"waiting_time_p99\":%lld,\"max_response_time\":%lld",
+                                      metrics->waiting_p50, metrics->waiting_p95, metrics->waiting_p99,
+                                      metrics->max_response);
+            writer->length += length;
+        }
+        if (switch_stats)
+        {
+            out = reserve_output(writer, MAX_RECORD_LENGTH);
+            length = (size_t)snprintf(out, MAX_RECORD_LENGTH,
+                                      ",\"context_switches\":%lld,\"switch_overhead\":%lld,\"cpu_utilization\":%.6f",
+                                      metrics->num_switches, metrics->switch_overhead, metrics->cpu_utilization);
+            writer->length += length;
+        }
+        append_text(writer, "}\n");
+        break;
+    case RESULT_FORMAT_BINARY:
+        break;
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Hands the buffered bytes to the stream. Returns false once any write has
+ * failed (e.g. a full disk or a closed pipe).
+ */
+bool result_writer_flush(ResultWriter *writer)
+{
+    if (writer->length > 0)
+    {
+        writer->failed |= (fwrite(writer->buffer, 1, writer->length, writer->stream) != writer->length);
+        writer->length = 0;
+    }
+    return !writer->failed;
+}
+
+/* ========================================================================================*/
+
+// Flushes and releases the buffer if the writer allocated it
+bool result_writer_finish(ResultWriter *writer)
+{
+    bool ok = result_writer_flush(writer);
+    if (writer->owns_buffer)
+    {
+        free(writer->buffer);
+    }
+    writer->buffer = NULL;
+    return ok;
+}
+
+/* ========================================================================================*/
+/* STREAM FRAMING */
+/* ========================================================================================*/
+
+#define SECTION_SEPARATOR "============================================\n"
+
+// Written once before the first report of a stream
+void write_report_prologue(FILE *stream, ResultFormat format)
+{
+    if (format == RESULT_FORMAT_TEXT)
+    {
+        fputs(SECTION_SEPARATOR, stream);
+    }
+    else if (format == RESULT_FORMAT_CSV)
+    {
+        fputs(RESULT_CSV_HEADER, stream);
+    }
+}
+
+/* ========================================================================================*/
+
+// Written after every report
+void write_report_separator(FILE *stream, ResultFormat format)
+{
+    if (format == RESULT_FORMAT_TEXT)
+    {
+        fputs(SECTION_SEPARATOR, stream);
+    }
+}
+
+/* ========================================================================================*/
+
+bool parse_result_format(const char *name, ResultFormat *format)
+{
+    static const char *const NAMES[] = {
+        [RESULT_FORMAT_TEXT] = "text",
+        [RESULT_FORMAT_CSV] = "csv",
+        [RESULT_FORMAT_NDJSON] = "ndjson",
+        [RESULT_FORMAT_BINARY] = "binary",
+    };
+
+    for (int i = 0; i < (int)(sizeof(NAMES) / sizeof(NAMES[0])); i++)
+    {
+        if (strcmp(name, NAMES[i]) == 0)
+        {
+            *format = (ResultFormat)i;
+            return true;
+        }
+    }
+    return false;
+}
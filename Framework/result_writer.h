@@ -0,0 +1,94 @@
+/*
+ * ===============================================================================
+ * RESULT WRITER HEADER FILE
+ * ===============================================================================
+ *
+ * Buffered output stage for the result reports. Records are formatted straight
+ * into one large buffer by a small integer formatter and handed to the stream
+ * in RESULT_WRITER_BUFFER_SIZE blocks, instead of one printf (format parsing
+ * plus a stream lock) per process. Every report is one begin / rows / summary
+ * sequence in one of the ResultFormat layouts:
+ *
+ * - TEXT:   the fixed-width table of display_results, byte-identical to
+ *           printf("%-9d%-21d%d\n", pid, turnaround, waiting)
+ * - CSV:    one RESULT_CSV_HEADER line per stream (write_report_prologue), then
+ *           "process" rows and a "summary" row whose time columns hold the
+ *           averages
+ * - NDJSON: one JSON object per line, "type" is "process" or "summary"
+ * - BINARY: a ResultBlockHeader followed by num_records ResultRecords, in the
+ *           writer's native byte order (see byte_order)
+ *
+ * ===============================================================================
+ */
+
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include "CPU_scheduler.h"
+#include "schedule_metrics.h"
+
+// Size of the formatting buffer (flushed whenever a record might not fit)
+#define RESULT_WRITER_BUFFER_SIZE (1 << 18)
+
+#define RESULT_CSV_HEADER "type,algorithm,pid,completion_time,turnaround_time,waiting_time\n"
+
+#define RESULT_MAGIC "SCHEDRS"                  // 8 bytes including the terminator
+#define RESULT_MAGIC_SIZE 8
+#define RESULT_FORMAT_VERSION 2              // 2: 64-bit times in ResultRecord
+#define RESULT_BYTE_ORDER_MARK 0x01020304u
+#define RESULT_ALGORITHM_NAME_SIZE 48
+
+/* ========================================================================================*/
+// Binary report header, one per algorithm
+typedef struct
+{
+    char magic[RESULT_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t num_records;       // ResultRecords that follow (0 with --summary-only)
+    uint64_t num_processes;
+    int64_t total_turnaround;
+    int64_t total_waiting;
+    char algorithm[RESULT_ALGORITHM_NAME_SIZE];    // '\0'-padded, may be truncated
+} ResultBlockHeader;
+
+// Binary per-process record
+typedef struct
+{
+    int32_t pid;
+    int32_t reserved;           // Zero, keeps the times 8-byte aligned
+    int64_t completion_time;
+    int64_t turnaround_time;
+    int64_t waiting_time;
+} ResultRecord;
+
+/* ========================================================================================*/
+// Structure to hold the buffered output state
+typedef struct
+{
+    FILE *stream;
+    ResultFormat format;
+    const char *algorithm;  // Name of the current report
+    char *buffer;           // RESULT_WRITER_BUFFER_SIZE bytes
+    bool owns_buffer;       // buffer was allocated by result_writer_init
+    size_t length;          // Bytes formatted but not yet written
+    bool failed;            // A write to stream came up short
+} ResultWriter;
+
+/* ========================================================================================*/
+// Result writer function prototypes
+void result_writer_init(ResultWriter *writer, FILE *stream, ResultFormat format, char *buffer);
+void result_writer_begin(ResultWriter *writer, const char *algorithm, const ScheduleMetrics *metrics,
+                         long long num_processes, int num_records);
+void result_writer_row(ResultWriter *writer, int pid, long long completion, long long turnaround,
+                       long long waiting);
+void result_writer_summary(ResultWriter *writer, const ScheduleMetrics *metrics, long long num_processes,
+                           unsigned report_flags);
+bool result_writer_flush(ResultWriter *writer);
+bool result_writer_finish(ResultWriter *writer);
+
+void write_report_prologue(FILE *stream, ResultFormat format);
+void write_report_separator(FILE *stream, ResultFormat format);
+bool parse_result_format(const char *name, ResultFormat *format);
+
+#endif // RESULT_WRITER_H
@@ -0,0 +1,122 @@
+/**
+ * ===============================================================================
+ * RING BUFFER QUEUE
+ * ===============================================================================
+ * @file ring_queue.c
+ * @brief Growable power-of-two circular FIFO for the Round Robin ready queue
+ * ===============================================================================
+ */
+
+#include "ring_queue.h"
+#include "sched_stats.h"
+
+/* ========================================================================================*/
+
+static int round_up_power_of_two(int value)
+{
+    int capacity = RING_QUEUE_MIN_CAPACITY;
+    while (capacity < value && capacity <= INT_MAX / 2)
+    {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/* ========================================================================================*/
+
+/**
+ * Sets up an empty queue. Returns false if the storage could not be allocated.
+ */
+bool ring_queue_try_init(RingQueue *queue, int initial_capacity)
+{
+    int capacity = round_up_power_of_two(initial_capacity);
+    queue->items = calloc((size_t)capacity, sizeof(int));
+    queue->head = 0;
+    queue->count = 0;
+    queue->mask = (queue->items != NULL) ? capacity - 1 : 0;
+    return queue->items != NULL;
+}
+
+/* ========================================================================================*/
+
+void ring_queue_free(RingQueue *queue)
+{
+    free(queue->items);
+    queue->items = NULL;
+    queue->head = 0;
+    queue->count = 0;
+    queue->mask = 0;
+}
+
+/* ========================================================================================*/
+
+void ring_queue_clear(RingQueue *queue)
+{
+    queue->head = 0;
+    queue->count = 0;
+}
+
+/* ========================================================================================*/
+/**
+ * Doubles the storage and unwraps the queued items to the start of the new buffer.
+ */
+static bool grow(RingQueue *queue)
+{
+    int capacity = queue->mask + 1;
+    int *items = malloc((size_t)capacity * 2 * sizeof(int));
+    if (items == NULL)
+    {
+        return false;
+    }
+
+    int first_part = capacity - queue->head;
+    memcpy(items, queue->items + queue->head, (size_t)first_part * sizeof(int));
+    memcpy(items + first_part, queue->items, (size_t)queue->head * sizeof(int));
+
+    free(queue->items);
+    queue->items = items;
+    queue->head = 0;
+    queue->mask = capacity * 2 - 1;
+    return true;
+}
+
+/* ========================================================================================*/
+
+/**
+ * Appends value, growing a full queue. Returns false, with the queue
+ * unchanged, if the storage could not grow.
+ */
+bool ring_queue_try_push(RingQueue *queue, int value)
+{
+    if (queue->count > queue->mask && !grow(queue))
+    {
+        return false;
+    }
+    STATS_COUNT(STAT_QUEUE_PUSHES);
+    queue->items[(queue->head + queue->count) & queue->mask] = value;
+    queue->count++;
+    return true;
+}
+
+/* ========================================================================================*/
+
+int ring_queue_pop(RingQueue *queue)
+{
+    if (queue->count == 0)
+    {
+        return -1;
+    }
+
+    STATS_COUNT(STAT_QUEUE_POPS);
+    int value = queue->items[queue->head];
+    queue->head = (queue->head + 1) & queue->mask;
+    queue->count--;
+    return value;
+}
+
+/* ========================================================================================*/
+
+bool ring_queue_is_empty(const RingQueue *queue)
+{
+    return queue->count == 0;
+}
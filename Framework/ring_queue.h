@@ -0,0 +1,47 @@
+/*
+ * ===============================================================================
+ * RING BUFFER QUEUE HEADER FILE
+ * ===============================================================================
+ *
+ * Growable FIFO of process indices used as a Round Robin ready queue.
+ * The capacity is always a power of two so wrap-around is a mask instead
+ * of a modulo, and a push into a full queue doubles the storage instead of
+ * dropping the item.
+ *
+ * The try_ functions report allocation failure to the caller; ring_queue_init
+ * and ring_queue_push treat it as fatal and are defined with the other
+ * driver-only allocators in scheduler_alloc.c.
+ *
+ * ===============================================================================
+ */
+
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include "CPU_scheduler.h"
+
+// Capacity used when the caller has no better estimate
+#define RING_QUEUE_MIN_CAPACITY 16
+
+/* ========================================================================================*/
+// Structure to hold the queue state
+typedef struct
+{
+    int *items;     // Storage, capacity = mask + 1 (a power of two)
+    int head;       // Slot of the front item
+    int count;      // Number of queued items
+    int mask;       // capacity - 1
+} RingQueue;
+
+/* ========================================================================================*/
+// Queue function prototypes
+bool ring_queue_try_init(RingQueue *queue, int initial_capacity);
+bool ring_queue_try_push(RingQueue *queue, int value);
+void ring_queue_init(RingQueue *queue, int initial_capacity);
+void ring_queue_push(RingQueue *queue, int value);
+void ring_queue_free(RingQueue *queue);
+void ring_queue_clear(RingQueue *queue);
+int ring_queue_pop(RingQueue *queue);
+bool ring_queue_is_empty(const RingQueue *queue);
+
+#endif // RING_QUEUE_H
@@ -0,0 +1,468 @@
+/**
+ * ===============================================================================
+ * SCHEDULING LIBRARY
+ * ===============================================================================
+ * @file sched_library.c
+ * @brief Event loop that drives a SchedPolicy over an immutable workload
+ *
+ * sched_run() copies the workload into rank-ordered columns (the same layout
+ * as process_columns.h), lets the policy size and carve its state, then
+ * advances time from decision to decision: admit arrivals, ask pick_next,
+ * run the job until its budget ends, it completes or an arrival preempts it.
+ * All memory is released before returning; nothing is printed.
+ * ===============================================================================
+ */
+
+#include <limits.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sched_loop.h"
+#include "priority_buckets.h"
+
+#define SCHED_ALIGNMENT alignof(max_align_t)
+
+/* ========================================================================================*/
+// One-shot run: the columns plus their sorting area
+typedef struct
+{
+    RunColumns columns;
+    RankKey *keys;              // Sorting area, reused to build the level map
+} RunLayout;
+
+/* ========================================================================================*/
+/* MEMORY */
+/* ========================================================================================*/
+/**
+ * Returns zeroed room for count elements of size bytes from memory, or NULL in
+ * the sizing pass (memory->base == NULL), where only the total is counted.
+ */
+void *sched_memory_take(SchedMemory *memory, size_t count, size_t size)
+{
+    if (memory->used == SIZE_MAX || (count > 0 && size > (SIZE_MAX - SCHED_ALIGNMENT) / count))
+    {
+        memory->used = SIZE_MAX;    // Saturated: the allocation will fail
+        return NULL;
+    }
+    size_t bytes = (count * size + SCHED_ALIGNMENT - 1) & ~(SCHED_ALIGNMENT - 1);
+    if (bytes > SIZE_MAX - memory->used)
+    {
+        memory->used = SIZE_MAX;
+        return NULL;
+    }
+
+    void *ptr = NULL;
+    if (memory->base != NULL)
+    {
+        ptr = memory->base + memory->used;
+        memset(ptr, 0, bytes);
+    }
+    memory->used += bytes;
+    return ptr;
+}
+
+/* ========================================================================================*/
+
+static void take_columns(SchedMemory *memory, RunLayout *layout, int n)
+{
+    RunColumns *columns = &layout->columns;
+    columns->order = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->arrival_time = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->burst_time = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->priority = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->level = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->remaining_time = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->start_time = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->completion_time = sched_memory_take(memory, (size_t)n, sizeof(int));
+    layout->keys = sched_memory_take(memory, (size_t)n, sizeof(RankKey));
+}
+
+/* ========================================================================================*/
+/* WORKLOAD COPY */
+/* ========================================================================================*/
+
+int compare_rank_keys(const void *lhs, const void *rhs)
+{
+    const RankKey *a = lhs;
+    const RankKey *b = rhs;
+    if (a->arrival_time != b->arrival_time)
+    {
+        return (a->arrival_time > b->arrival_time) - (a->arrival_time < b->arrival_time);
+    }
+    if (a->id != b->id)
+    {
+        return (a->id > b->id) - (a->id < b->id);
+    }
+    return (a->index > b->index) - (a->index < b->index);
+}
+
+/* ========================================================================================*/
+/**
+ * Sorts jobs into arrival rank order: keys[k] describes the job of rank k.
+ */
+void sort_rank_keys(const SchedJob *jobs, int n, RankKey *keys)
+{
+    for (int i = 0; i < n; i++)
+    {
+        keys[i] = (RankKey){jobs[i].arrival_time, jobs[i].id, i};
+    }
+    qsort(keys, (size_t)n, sizeof(RankKey), compare_rank_keys);
+}
+
+/* ========================================================================================*/
+
+// Fills the columns in rank order and returns the number of priority levels
+static int build_columns(RunLayout *layout, const SchedJob *jobs, int n)
+{
+    RunColumns *columns = &layout->columns;
+    sort_rank_keys(jobs, n, layout->keys);
+    for (int k = 0; k < n; k++)
+    {
+        const SchedJob *job = &jobs[layout->keys[k].index];
+        columns->order[k] = layout->keys[k].index;
+        columns->arrival_time[k] = job->arrival_time;
+        columns->burst_time[k] = job->burst_time;
+        columns->priority[k] = job->priority;
+    }
+    return priority_buckets_fill_levels(columns->priority, n, (int *)layout->keys, columns->level);
+}
+
+/* ========================================================================================*/
+
+bool valid_run_arguments(const SchedPolicy *policy, const SchedWorkload *workload, const SchedParams *params)
+{
+    if (policy == NULL || policy->init == NULL || policy->on_arrival == NULL || policy->pick_next == NULL ||
+        workload == NULL || params == NULL || (policy->uses_quantum && params->time_quantum <= 0) ||
+        workload->num_jobs < 0)
+    {
+        return false;
+    }
+    if (workload->num_jobs > 0 && workload->jobs == NULL)
+    {
+        return false;
+    }
+    for (int i = 0; i < workload->num_jobs; i++)
+    {
+        const SchedJob *job = &workload->jobs[i];
+        if (job->burst_time <= 0 || job->arrival_time < 0 || job->priority < 0)
+        {
+            return false;
+        }
+    }
+    return run_horizon(workload->jobs, workload->num_jobs) <= INT_MAX;
+}
+
+/* ========================================================================================*/
+/**
+ * Last arrival plus every burst: no schedule of jobs ends later. The loop
+ * keeps an int clock, so valid workloads stay within INT_MAX.
+ */
+long long run_horizon(const SchedJob *jobs, int n)
+{
+    long long last_arrival = 0;
+    long long total_burst = 0;
+    for (int i = 0; i < n; i++)
+    {
+        last_arrival = (jobs[i].arrival_time > last_arrival) ? jobs[i].arrival_time : last_arrival;
+        total_burst += jobs[i].burst_time;
+    }
+    return last_arrival + total_burst;
+}
+
+/* ========================================================================================*/
+/* EVENT LOOP */
+/* ========================================================================================*/
+
+/**
+ * Prepares loop to run policy from time 0. active_links (2 * n ints) makes it
+ * track the admitted, unfinished jobs; NULL skips that bookkeeping.
+ */
+void run_loop_init(RunLoop *loop, const SchedPolicy *policy, void *state, RunColumns *columns, int n,
+                   int *active_links)
+{
+    memset(loop, 0, sizeof(*loop));
+    loop->policy = policy;
+    loop->state = state;
+    loop->columns = columns;
+    loop->num_jobs = n;
+    loop->last = -1;
+    loop->active_next = active_links;
+    loop->active_prev = (active_links != NULL) ? active_links + n : NULL;
+    loop->active_head = -1;
+    loop->active_tail = -1;
+}
+
+/* ========================================================================================*/
+
+// Admissions happen in rank order, so appending keeps the list sorted
+void run_loop_activate(RunLoop *loop, int job)
+{
+    loop->num_active++;
+    if (loop->active_next == NULL)
+    {
+        return;
+    }
+    loop->active_next[job] = -1;
+    loop->active_prev[job] = loop->active_tail;
+    if (loop->active_tail >= 0)
+    {
+        loop->active_next[loop->active_tail] = job;
+    }
+    else
+    {
+        loop->active_head = job;
+    }
+    loop->active_tail = job;
+}
+
+static void run_loop_deactivate(RunLoop *loop, int job)
+{
+    loop->num_active--;
+    if (loop->active_next == NULL)
+    {
+        return;
+    }
+    int next = loop->active_next[job];
+    int prev = loop->active_prev[job];
+    if (prev >= 0)
+    {
+        loop->active_next[prev] = next;
+    }
+    else
+    {
+        loop->active_head = next;
+    }
+    if (next >= 0)
+    {
+        loop->active_prev[next] = prev;
+    }
+    else
+    {
+        loop->active_tail = prev;
+    }
+}
+
+// The per-run state of a job is set up when it arrives, so a resumed run
+// only has to restore the jobs admitted before its checkpoint
+static bool admit(RunLoop *loop, int running)
+{
+    RunColumns *columns = loop->columns;
+    int job = loop->next_arrival++;
+    columns->remaining_time[job] = columns->burst_time[job];
+    columns->start_time[job] = -1;
+    run_loop_activate(loop, job);
+    return loop->policy->on_arrival(loop->state, job, running, loop->time);
+}
+
+/* ========================================================================================*/
+/**
+ * Runs the loop until every job completed or hook (if not NULL) stops it.
+ */
+SchedStatus run_loop_simulate(RunLoop *loop, RunLoopHook hook, void *arg)
+{
+    const SchedPolicy *policy = loop->policy;
+    RunColumns *columns = loop->columns;
+    int *remaining = columns->remaining_time;
+    int n = loop->num_jobs;
+
+    while (loop->completed < n)
+    {
+        if (hook != NULL && !hook(loop, arg))
+        {
+            return SCHED_OK;
+        }
+        loop->num_events++;
+        while (loop->next_arrival < n && columns->arrival_time[loop->next_arrival] <= loop->time)
+        {
+            admit(loop, -1);
+        }
+
+        int budget = 0;
+        int job = policy->pick_next(loop->state, loop->time, &budget);
+        if (job < 0 || job >= loop->next_arrival || remaining[job] == 0)
+        {
+            if (job >= 0 || loop->next_arrival == n)
+            {
+                return SCHED_ERROR_POLICY;
+            }
+            loop->time = columns->arrival_time[loop->next_arrival];
+            continue;
+        }
+
+        if (job != loop->last)
+        {
+            loop->num_dispatches++;
+            if (loop->last >= 0 && remaining[loop->last] > 0)
+            {
+                loop->num_preemptions++;
+            }
+            loop->last = job;
+        }
+        if (columns->start_time[job] < 0)
+        {
+            columns->start_time[job] = loop->time;
+        }
+
+        int end = loop->time + ((budget > 0 && budget < remaining[job]) ? budget : remaining[job]);
+
+        // Arrivals during the slice are admitted at their own time and may cut it short
+        while (loop->next_arrival < n && columns->arrival_time[loop->next_arrival] <= end)
+        {
+            int now = columns->arrival_time[loop->next_arrival];
+            remaining[job] -= now - loop->time;
+            loop->time = now;
+            if (admit(loop, job))
+            {
+                end = loop->time;
+                break;
+            }
+        }
+        remaining[job] -= end - loop->time;
+        loop->time = end;
+
+        if (remaining[job] == 0)
+        {
+            columns->completion_time[job] = loop->time;
+            loop->completed++;
+            run_loop_deactivate(loop, job);
+            if (policy->on_complete != NULL)
+            {
+                policy->on_complete(loop->state, job, loop->time);
+            }
+        }
+        else if (policy->on_event != NULL)
+        {
+            policy->on_event(loop->state, job, loop->time);
+        }
+    }
+    return SCHED_OK;
+}
+
+/* ========================================================================================*/
+/**
+ * Writes the results of a finished loop in workload order (results may be
+ * NULL) and fills *summary.
+ */
+void run_loop_summarize(const RunLoop *loop, SchedJobResult *results, SchedSummary *summary)
+{
+    const RunColumns *columns = loop->columns;
+    long long total_turnaround = 0, total_waiting = 0;
+    int makespan = 0;
+    for (int k = 0; k < loop->num_jobs; k++)
+    {
+        int turnaround = columns->completion_time[k] - columns->arrival_time[k];
+        if (results != NULL)
+        {
+            SchedJobResult *result = &results[columns->order[k]];
+            result->start_time = columns->start_time[k];
+            result->completion_time = columns->completion_time[k];
+            result->turnaround_time = turnaround;
+            result->waiting_time = turnaround - columns->burst_time[k];
+        }
+        total_turnaround += turnaround;
+        total_waiting += turnaround - columns->burst_time[k];
+        makespan = (columns->completion_time[k] > makespan) ? columns->completion_time[k] : makespan;
+    }
+    memset(summary, 0, sizeof(*summary));
+    summary->makespan = makespan;
+    summary->avg_turnaround = (loop->num_jobs > 0) ? (double)total_turnaround / loop->num_jobs : 0.0;
+    summary->avg_waiting = (loop->num_jobs > 0) ? (double)total_waiting / loop->num_jobs : 0.0;
+    summary->num_dispatches = loop->num_dispatches;
+    summary->num_preemptions = loop->num_preemptions;
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+/**
+ * Schedules workload with policy. On SCHED_OK, results[i] holds the times of
+ * workload->jobs[i] and *summary (if not NULL) the run totals; otherwise the
+ * outputs are unspecified. Safe to call concurrently.
+ */
+SchedStatus sched_run(const SchedPolicy *policy, const SchedWorkload *workload, const SchedParams *params,
+                      SchedJobResult *results, SchedSummary *summary)
+{
+    if (!valid_run_arguments(policy, workload, params) || (workload->num_jobs > 0 && results == NULL))
+    {
+        return SCHED_ERROR_INVALID_ARGUMENT;
+    }
+    SchedSummary totals;
+    memset(&totals, 0, sizeof(totals));
+    int n = workload->num_jobs;
+    if (n == 0)
+    {
+        if (summary != NULL)
+        {
+            *summary = totals;
+        }
+        return SCHED_OK;
+    }
+
+    RunLayout layout;
+    SchedMemory memory = {NULL, 0};
+    take_columns(&memory, &layout, n);
+    memory.base = (memory.used == SIZE_MAX) ? NULL : malloc(memory.used);
+    if (memory.base == NULL)
+    {
+        return SCHED_ERROR_NO_MEMORY;
+    }
+    memory.used = 0;
+    take_columns(&memory, &layout, n);
+    RunColumns *columns = &layout.columns;
+
+    SchedView view;
+    view.num_jobs = n;
+    view.arrival_time = columns->arrival_time;
+    view.burst_time = columns->burst_time;
+    view.priority = columns->priority;
+    view.level = columns->level;
+    view.num_levels = build_columns(&layout, workload->jobs, n);
+    view.remaining_time = columns->remaining_time;
+
+    // Sizing pass, then the real one
+    SchedMemory policy_memory = {NULL, 0};
+    policy->init(&policy_memory, &view, params->time_quantum);
+    policy_memory.base = (policy_memory.used == SIZE_MAX) ? NULL : malloc(policy_memory.used > 0 ? policy_memory.used : 1);
+    if (policy_memory.base == NULL)
+    {
+        free(memory.base);
+        return SCHED_ERROR_NO_MEMORY;
+    }
+    policy_memory.used = 0;
+    void *state = policy->init(&policy_memory, &view, params->time_quantum);
+
+    RunLoop loop;
+    run_loop_init(&loop, policy, state, columns, n, NULL);
+    SchedStatus status = run_loop_simulate(&loop, NULL, NULL);
+    if (status == SCHED_OK)
+    {
+        run_loop_summarize(&loop, results, &totals);
+        if (summary != NULL)
+        {
+            *summary = totals;
+        }
+    }
+
+    free(policy_memory.base);
+    free(memory.base);
+    return status;
+}
+
+/* ========================================================================================*/
+
+const char *sched_status_string(SchedStatus status)
+{
+    switch (status)
+    {
+    case SCHED_OK:
+        return "ok";
+    case SCHED_ERROR_INVALID_ARGUMENT:
+        return "invalid argument";
+    case SCHED_ERROR_NO_MEMORY:
+        return "out of memory";
+    case SCHED_ERROR_POLICY:
+        return "policy left jobs unscheduled";
+    }
+    return "unknown status";
+}
@@ -0,0 +1,181 @@
+/*
+ * ===============================================================================
+ * SCHEDULING LIBRARY HEADER FILE
+ * ===============================================================================
+ *
+ * Embeddable scheduling API (make lib builds libscheduler.a and .so). Unlike
+ * the driver's engines it never touches its input, never prints and keeps no
+ * global state, so any number of runs can be in flight on different threads:
+ *
+ *     SchedJobResult results[n];
+ *     SchedSummary summary;
+ *     SchedParams params = {.time_quantum = 3};
+ *     SchedWorkload workload = {jobs, n};
+ *     if (sched_run(&SCHED_POLICY_RR, &workload, &params, results, &summary) == SCHED_OK) ...
+ *
+ * A policy is a vtable of hooks driven by sched_run()'s event loop. Jobs are
+ * named by arrival rank: rank k is the k-th job by arrival time → ID (ties
+ * by workload position), so a lower rank is also the usual tie-breaker.
+ *
+ * - init:        carve the policy state from memory (called twice, see SchedMemory)
+ * - on_arrival:  job arrived; return true to preempt the running job now
+ * - pick_next:   job to dispatch (-1 = idle) and how long it may run
+ *                before the policy is consulted again (0 = until it completes)
+ * - on_event:    the running job stopped without completing (slice end or
+ *                preemption); the view already shows its new remaining time
+ * - on_complete: the running job finished
+ *
+ * - save:        write a canonical image of the state (buffer NULL = return
+ *                its size only); equal images must mean equal future decisions
+ * - restore:     rebuild a freshly initialized state from a saved image
+ *
+ * A policy that slices by time sets uses_quantum, so sched_run() requires a
+ * positive time_quantum for it; the others accept any value and ignore it.
+ *
+ * on_event and on_complete may be NULL when the policy has nothing to do;
+ * save and restore are optional and only used by sessions (see below).
+ *
+ * A session (sched_session_create) runs a baseline once and keeps periodic
+ * checkpoints so what-if queries ("job 7 arrives 20 ticks later") resume
+ * from the last checkpoint before the first affected arrival and stop as
+ * soon as their state matches a later baseline checkpoint again, instead of
+ * re-simulating the whole trace.
+ *
+ * The built-in policies reproduce the driver's engines exactly (this is
+ * checked by --fuzz). Context switches are free in this model.
+ *
+ * ===============================================================================
+ */
+
+#ifndef SCHED_LIBRARY_H
+#define SCHED_LIBRARY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ========================================================================================*/
+// Input: one job per entry, in any order; never modified
+typedef struct
+{
+    int id;
+    int arrival_time;       // >= 0
+    int burst_time;         // > 0
+    int priority;           // >= 0, lower number = more urgent
+} SchedJob;
+
+typedef struct
+{
+    const SchedJob *jobs;
+    int num_jobs;
+} SchedWorkload;
+
+typedef struct
+{
+    int time_quantum;       // Slice length of the policies with uses_quantum (> 0 for those)
+} SchedParams;
+
+// Output: one entry per job, in workload order (caller-supplied)
+typedef struct
+{
+    int start_time;         // First dispatch
+    int completion_time;
+    int turnaround_time;
+    int waiting_time;
+} SchedJobResult;
+
+typedef struct
+{
+    int makespan;           // Completion time of the last job
+    double avg_turnaround;
+    double avg_waiting;
+    long long num_dispatches;   // Times a different job got the CPU
+    long long num_preemptions;  // Dispatches away from an unfinished job
+} SchedSummary;
+
+typedef enum
+{
+    SCHED_OK,
+    SCHED_ERROR_INVALID_ARGUMENT,   // NULL pointer, bad job field or quantum, or a schedule that
+                                    // could end past INT_MAX (last arrival + total burst)
+    SCHED_ERROR_NO_MEMORY,
+    SCHED_ERROR_POLICY              // The policy went idle with jobs left
+} SchedStatus;
+
+/* ========================================================================================*/
+// Read-only view of the run that hooks receive, indexed by arrival rank
+typedef struct
+{
+    int num_jobs;
+    const int *arrival_time;
+    const int *burst_time;
+    const int *priority;
+    const int *level;           // Dense priority level, 0 = most urgent
+    int num_levels;
+    const int *remaining_time;  // Kept up to date by sched_run()
+} SchedView;
+
+// Policy state allocator: a sizing pass (base == NULL) adds up the requests,
+// then sched_run() allocates once and init runs again to hand out the memory
+typedef struct
+{
+    unsigned char *base;
+    size_t used;
+} SchedMemory;
+
+typedef struct
+{
+    const char *name;
+    bool uses_quantum;          // time_quantum must be > 0
+    void *(*init)(SchedMemory *memory, const SchedView *view, int time_quantum);
+    bool (*on_arrival)(void *state, int job, int running, int now);
+    int (*pick_next)(void *state, int now, int *budget);
+    void (*on_event)(void *state, int job, int now);
+    void (*on_complete)(void *state, int job, int now);
+    size_t (*save)(const void *state, void *buffer);
+    void (*restore)(void *state, const void *buffer);
+} SchedPolicy;
+
+/* ========================================================================================*/
+// What-if queries: new attributes of one job (copy the fields that stay)
+typedef struct
+{
+    int job;                // Workload index
+    int arrival_time;
+    int burst_time;
+    int priority;
+} SchedJobChange;
+
+typedef struct
+{
+    int resume_time;        // Clock of the checkpoint the query resumed from
+    int converge_time;      // Clock where it matched the baseline, -1 = ran to the end
+    long long num_events;   // Decisions simulated, -1 = ran without the session
+                            // (a priority value the baseline never uses)
+} SchedWhatIfInfo;
+
+typedef struct SchedSession SchedSession;
+
+/* ========================================================================================*/
+// Built-in policies
+extern const SchedPolicy SCHED_POLICY_FCFS;
+extern const SchedPolicy SCHED_POLICY_SJF;
+extern const SchedPolicy SCHED_POLICY_SRTF;
+extern const SchedPolicy SCHED_POLICY_RR;
+extern const SchedPolicy SCHED_POLICY_PRIORITY;
+extern const SchedPolicy SCHED_POLICY_PRIORITY_RR;
+
+/* ========================================================================================*/
+// Library function prototypes
+void *sched_memory_take(SchedMemory *memory, size_t count, size_t size);
+const SchedPolicy *sched_find_policy(const char *name);
+const char *sched_status_string(SchedStatus status);
+SchedStatus sched_run(const SchedPolicy *policy, const SchedWorkload *workload, const SchedParams *params,
+                      SchedJobResult *results, SchedSummary *summary);
+SchedStatus sched_session_create(const SchedPolicy *policy, const SchedWorkload *workload, const SchedParams *params,
+                                 int checkpoint_interval, SchedSession **session);
+SchedStatus sched_session_baseline(const SchedSession *session, SchedJobResult *results, SchedSummary *summary);
+SchedStatus sched_session_what_if(SchedSession *session, const SchedJobChange *changes, int num_changes,
+                                  SchedJobResult *results, SchedSummary *summary, SchedWhatIfInfo *info);
+void sched_session_free(SchedSession *session);
+
+#endif // SCHED_LIBRARY_H
@@ -0,0 +1,79 @@
+/*
+ * ===============================================================================
+ * SCHEDULING LIBRARY EVENT LOOP HEADER FILE
+ * ===============================================================================
+ *
+ * Internals shared by sched_library.c (one-shot runs) and sched_session.c
+ * (checkpointed what-if runs); not part of the public API. RunColumns is the
+ * rank-ordered copy of a workload, RunLoop the state of sched_run()'s event
+ * loop between two decisions, which is exactly what a checkpoint records.
+ *
+ * ===============================================================================
+ */
+
+#ifndef SCHED_LOOP_H
+#define SCHED_LOOP_H
+
+#include "sched_library.h"
+
+/* ========================================================================================*/
+// Rank-ordered workload and per-run results (see process_columns.h for the idea)
+typedef struct
+{
+    int *order;                 // order[rank] = workload index
+    int *arrival_time;
+    int *burst_time;
+    int *priority;
+    int *level;
+    int *remaining_time;
+    int *start_time;
+    int *completion_time;
+} RunColumns;
+
+// Sort key of one job: arrival time → ID → workload position
+typedef struct
+{
+    int arrival_time;
+    int id;
+    int index;
+} RankKey;
+
+typedef struct RunLoop RunLoop;
+
+// Called before every decision; returning false stops the loop (status SCHED_OK)
+typedef bool (*RunLoopHook)(RunLoop *loop, void *arg);
+
+// Event loop state between two decisions
+struct RunLoop
+{
+    const SchedPolicy *policy;
+    void *state;
+    RunColumns *columns;
+    int num_jobs;
+    int time;
+    int next_arrival;           // First rank not admitted yet
+    int last;                   // Job that held the CPU last, -1 before the first dispatch
+    int completed;
+    long long num_dispatches;
+    long long num_preemptions;
+    long long num_events;       // Decisions taken, including idle jumps
+    int *active_next;           // Admitted, unfinished jobs as a rank-ordered list
+    int *active_prev;           // (both NULL = not tracked)
+    int active_head;
+    int active_tail;
+    int num_active;
+};
+
+/* ========================================================================================*/
+// Event loop function prototypes
+int compare_rank_keys(const void *lhs, const void *rhs);
+void sort_rank_keys(const SchedJob *jobs, int n, RankKey *keys);
+bool valid_run_arguments(const SchedPolicy *policy, const SchedWorkload *workload, const SchedParams *params);
+long long run_horizon(const SchedJob *jobs, int n);
+void run_loop_init(RunLoop *loop, const SchedPolicy *policy, void *state, RunColumns *columns, int n,
+                   int *active_links);
+void run_loop_activate(RunLoop *loop, int job);
+SchedStatus run_loop_simulate(RunLoop *loop, RunLoopHook hook, void *arg);
+void run_loop_summarize(const RunLoop *loop, SchedJobResult *results, SchedSummary *summary);
+
+#endif // SCHED_LOOP_H
@@ -0,0 +1,478 @@
+/**
+ * ===============================================================================
+ * BUILT-IN LIBRARY POLICIES
+ * ===============================================================================
+ * @file sched_policies.c
+ * @brief FCFS, SJF, SRTF, RR, Priority and Priority RR as SchedPolicy hooks
+ *
+ * Each policy keeps the same ready structure as its driver engine (ring
+ * queue, indexed heap or priority buckets), laid out on memory handed out by
+ * sched_run() instead of allocated, so the structures never grow: every job
+ * is in its ready structure at most once, so the try_ pushes cannot fail.
+ *
+ * Saved images list the ready jobs as int arrays; heap images are sorted so
+ * two heaps holding the same jobs compare equal whatever their layout.
+ * ===============================================================================
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "sched_library.h"
+#include "ready_heap.h"
+#include "ring_queue.h"
+#include "priority_buckets.h"
+
+/* ========================================================================================*/
+/* READY STRUCTURES ON POLICY MEMORY */
+/* ========================================================================================*/
+
+// False in the sizing pass; the structure is only set up in the real one
+static bool take_ring_queue(SchedMemory *memory, RingQueue *queue, int num_jobs)
+{
+    int capacity = 1;
+    while (capacity < num_jobs)
+    {
+        capacity <<= 1;
+    }
+    int *items = sched_memory_take(memory, (size_t)capacity, sizeof(int));
+    if (items == NULL)
+    {
+        return false;
+    }
+    queue->items = items;
+    queue->head = 0;
+    queue->count = 0;
+    queue->mask = capacity - 1;
+    return true;
+}
+
+/* ========================================================================================*/
+
+static bool take_ready_heap(SchedMemory *memory, ReadyHeap *heap, int num_jobs)
+{
+    ReadyEntry *entries = sched_memory_take(memory, (size_t)num_jobs, sizeof(ReadyEntry));
+    int *position = sched_memory_take(memory, (size_t)num_jobs, sizeof(int));
+    if (entries == NULL || position == NULL)
+    {
+        return false;
+    }
+    for (int i = 0; i < num_jobs; i++)
+    {
+        position[i] = -1;
+    }
+    heap->entries = entries;
+    heap->position = position;
+    heap->size = 0;
+    heap->capacity = num_jobs;
+    return true;
+}
+
+/* ========================================================================================*/
+
+static bool take_priority_buckets(SchedMemory *memory, PriorityBuckets *buckets, int num_levels, int num_jobs)
+{
+    buckets->num_levels = num_levels;
+    buckets->num_words = (num_levels + 63) / 64;
+    buckets->num_summary_words = (buckets->num_words + 63) / 64;
+    buckets->head = sched_memory_take(memory, (size_t)num_levels, sizeof(int));
+    buckets->tail = sched_memory_take(memory, (size_t)num_levels, sizeof(int));
+    buckets->next = sched_memory_take(memory, (size_t)num_jobs, sizeof(int));
+    buckets->prev = sched_memory_take(memory, (size_t)num_jobs, sizeof(int));
+    buckets->level_bits = sched_memory_take(memory, (size_t)buckets->num_words, sizeof(uint64_t));
+    buckets->word_bits = sched_memory_take(memory, (size_t)buckets->num_summary_words, sizeof(uint64_t));
+    if (buckets->head == NULL)
+    {
+        return false;
+    }
+    priority_buckets_clear(buckets);
+    return true;
+}
+
+/* ========================================================================================*/
+/* FIFO POLICIES: FCFS, RR */
+/* ========================================================================================*/
+
+typedef struct
+{
+    RingQueue queue;
+    int time_quantum;           // 0 = run to completion (FCFS)
+} FifoState;
+
+static void *fifo_init(SchedMemory *memory, const SchedView *view, int time_quantum, bool sliced)
+{
+    FifoState *state = sched_memory_take(memory, 1, sizeof(FifoState));
+    RingQueue queue;
+    if (!take_ring_queue(memory, &queue, view->num_jobs) || state == NULL)
+    {
+        return NULL;
+    }
+    state->queue = queue;
+    state->time_quantum = sliced ? time_quantum : 0;
+    return state;
+}
+
+static void *fcfs_init(SchedMemory *memory, const SchedView *view, int time_quantum)
+{
+    return fifo_init(memory, view, time_quantum, false);
+}
+
+static void *rr_init(SchedMemory *memory, const SchedView *view, int time_quantum)
+{
+    return fifo_init(memory, view, time_quantum, true);
+}
+
+static bool fifo_on_arrival(void *state, int job, int running, int now)
+{
+    (void)running;
+    (void)now;
+    ring_queue_try_push(&((FifoState *)state)->queue, job);
+    return false;
+}
+
+static int fifo_pick_next(void *state, int now, int *budget)
+{
+    (void)now;
+    FifoState *fifo = state;
+    *budget = fifo->time_quantum;
+    return ring_queue_pop(&fifo->queue);
+}
+
+// Arrivals during the slice are already queued, so the preempted job goes behind them
+static void rr_on_event(void *state, int job, int now)
+{
+    (void)now;
+    ring_queue_try_push(&((FifoState *)state)->queue, job);
+}
+
+// Image: count, then the queue from head to tail
+static size_t fifo_save(const void *state, void *buffer)
+{
+    const RingQueue *queue = &((const FifoState *)state)->queue;
+    if (buffer != NULL)
+    {
+        int *image = buffer;
+        image[0] = queue->count;
+        for (int i = 0; i < queue->count; i++)
+        {
+            image[1 + i] = queue->items[(queue->head + i) & queue->mask];
+        }
+    }
+    return (size_t)(1 + queue->count) * sizeof(int);
+}
+
+static void fifo_restore(void *state, const void *buffer)
+{
+    const int *image = buffer;
+    for (int i = 0; i < image[0]; i++)
+    {
+        ring_queue_try_push(&((FifoState *)state)->queue, image[1 + i]);
+    }
+}
+
+/* ========================================================================================*/
+/* HEAP POLICIES: SJF, SRTF, PRIORITY */
+/* ========================================================================================*/
+
+typedef struct
+{
+    ReadyHeap heap;
+    const int *key;             // Burst time, remaining time or priority by rank
+    bool preemptive;            // SRTF: re-evaluate at every arrival
+} HeapState;
+
+static void *heap_init(SchedMemory *memory, const int *key, int num_jobs, bool preemptive)
+{
+    HeapState *state = sched_memory_take(memory, 1, sizeof(HeapState));
+    ReadyHeap heap;
+    if (!take_ready_heap(memory, &heap, num_jobs) || state == NULL)
+    {
+        return NULL;
+    }
+    state->heap = heap;
+    state->key = key;
+    state->preemptive = preemptive;
+    return state;
+}
+
+static void *sjf_init(SchedMemory *memory, const SchedView *view, int time_quantum)
+{
+    (void)time_quantum;
+    return heap_init(memory, view->burst_time, view->num_jobs, false);
+}
+
+static void *srtf_init(SchedMemory *memory, const SchedView *view, int time_quantum)
+{
+    (void)time_quantum;
+    return heap_init(memory, view->remaining_time, view->num_jobs, true);
+}
+
+static void *priority_init(SchedMemory *memory, const SchedView *view, int time_quantum)
+{
+    (void)time_quantum;
+    return heap_init(memory, view->priority, view->num_jobs, false);
+}
+
+static bool heap_on_arrival(void *state, int job, int running, int now)
+{
+    (void)now;
+    HeapState *ready = state;
+    ready_heap_push(&ready->heap, job, ready->key[job], job);
+    return ready->preemptive && running >= 0;
+}
+
+// Non-preemptive: the chosen job leaves the heap and runs to completion
+static int heap_pop_next(void *state, int now, int *budget)
+{
+    (void)now;
+    *budget = 0;
+    return ready_heap_pop(&((HeapState *)state)->heap);
+}
+
+// SRTF: the running job stays in the heap so an arrival can displace it
+static int heap_peek_next(void *state, int now, int *budget)
+{
+    (void)now;
+    *budget = 0;
+    return ready_heap_peek(&((HeapState *)state)->heap);
+}
+
+static void srtf_on_event(void *state, int job, int now)
+{
+    (void)now;
+    HeapState *ready = state;
+    ready_heap_update(&ready->heap, job, ready->key[job]);
+}
+
+// Its heap key may be stale if it finished as a job arrived; 0 moves it to the root
+static void srtf_on_complete(void *state, int job, int now)
+{
+    (void)now;
+    HeapState *ready = state;
+    ready_heap_update(&ready->heap, job, 0);
+    ready_heap_pop(&ready->heap);
+}
+
+// Image: count, then (key, job) pairs in heap order; the tie-break rank is the job
+typedef struct
+{
+    int key;
+    int job;
+} HeapImageEntry;
+
+static int compare_heap_image_entries(const void *lhs, const void *rhs)
+{
+    const HeapImageEntry *a = lhs;
+    const HeapImageEntry *b = rhs;
+    if (a->key != b->key)
+    {
+        return (a->key > b->key) - (a->key < b->key);
+    }
+    return (a->job > b->job) - (a->job < b->job);
+}
+
+static size_t heap_save(const void *state, void *buffer)
+{
+    const ReadyHeap *heap = &((const HeapState *)state)->heap;
+    if (buffer != NULL)
+    {
+        int *image = buffer;
+        HeapImageEntry *entries = (HeapImageEntry *)(image + 1);
+        image[0] = heap->size;
+        for (int i = 0; i < heap->size; i++)
+        {
+            entries[i] = (HeapImageEntry){heap->entries[i].key, heap->entries[i].idx};
+        }
+        qsort(entries, (size_t)heap->size, sizeof(HeapImageEntry), compare_heap_image_entries);
+    }
+    return sizeof(int) + (size_t)heap->size * sizeof(HeapImageEntry);
+}
+
+// A sorted array already is a valid heap
+static void heap_restore(void *state, const void *buffer)
+{
+    ReadyHeap *heap = &((HeapState *)state)->heap;
+    const int *image = buffer;
+    const HeapImageEntry *entries = (const HeapImageEntry *)(image + 1);
+    for (int i = 0; i < image[0]; i++)
+    {
+        heap->entries[i] = (ReadyEntry){entries[i].job, entries[i].key, entries[i].job};
+        heap->position[entries[i].job] = i;
+    }
+    heap->size = image[0];
+}
+
+/* ========================================================================================*/
+/* PRIORITY RR */
+/* ========================================================================================*/
+
+// RR cycles over the members of the highest level present when the cycle starts
+typedef struct
+{
+    PriorityBuckets buckets;
+    const int *level;
+    int time_quantum;
+    bool in_cycle;
+    int cycle_level;
+    int cursor;                 // Next job of the cycle
+    int cycle_end;              // Last job of the cycle
+} PriorityRrState;
+
+static void *priority_rr_init(SchedMemory *memory, const SchedView *view, int time_quantum)
+{
+    PriorityRrState *state = sched_memory_take(memory, 1, sizeof(PriorityRrState));
+    PriorityBuckets buckets;
+    if (!take_priority_buckets(memory, &buckets, view->num_levels, view->num_jobs) || state == NULL)
+    {
+        return NULL;
+    }
+    state->buckets = buckets;
+    state->level = view->level;
+    state->time_quantum = time_quantum;
+    state->in_cycle = false;
+    return state;
+}
+
+// Only a strictly higher level preempts; it also ends the cycle
+static bool priority_rr_on_arrival(void *state, int job, int running, int now)
+{
+    (void)now;
+    PriorityRrState *prr = state;
+    priority_buckets_push_back(&prr->buckets, prr->level[job], job);
+    if (prr->in_cycle && prr->level[job] < prr->cycle_level)
+    {
+        prr->in_cycle = false;
+        return running >= 0;
+    }
+    return false;
+}
+
+static int priority_rr_pick_next(void *state, int now, int *budget)
+{
+    (void)now;
+    PriorityRrState *prr = state;
+    *budget = prr->time_quantum;
+    if (!prr->in_cycle)
+    {
+        int level = priority_buckets_first_level(&prr->buckets);
+        if (level < 0)
+        {
+            return -1;
+        }
+        prr->in_cycle = true;
+        prr->cycle_level = level;
+        prr->cursor = prr->buckets.head[level];
+        prr->cycle_end = prr->buckets.tail[level];
+    }
+    return prr->cursor;
+}
+
+static void priority_rr_on_event(void *state, int job, int now)
+{
+    (void)now;
+    PriorityRrState *prr = state;
+    if (prr->in_cycle)
+    {
+        prr->in_cycle = (job != prr->cycle_end);
+        prr->cursor = prr->buckets.next[job];
+    }
+}
+
+static void priority_rr_on_complete(void *state, int job, int now)
+{
+    (void)now;
+    PriorityRrState *prr = state;
+    int following = prr->buckets.next[job];
+    priority_buckets_remove(&prr->buckets, prr->level[job], job);
+    if (prr->in_cycle)
+    {
+        prr->in_cycle = (job != prr->cycle_end);
+        prr->cursor = following;
+    }
+}
+
+// Image: cycle state (zeroed outside a cycle), count, then every level's list
+static size_t priority_rr_save(const void *state, void *buffer)
+{
+    const PriorityRrState *prr = state;
+    const PriorityBuckets *buckets = &prr->buckets;
+    int *image = buffer;
+    int count = 0;
+    for (int w = 0; w < buckets->num_words; w++)
+    {
+        for (uint64_t bits = buckets->level_bits[w]; bits != 0; bits &= bits - 1)
+        {
+            int level = w * 64 + __builtin_ctzll(bits);
+            for (int job = buckets->head[level]; job >= 0; job = buckets->next[job])
+            {
+                if (image != NULL)
+                {
+                    image[5 + count] = job;
+                }
+                count++;
+            }
+        }
+    }
+    if (image != NULL)
+    {
+        image[0] = prr->in_cycle;
+        image[1] = prr->in_cycle ? prr->cycle_level : 0;
+        image[2] = prr->in_cycle ? prr->cursor : 0;
+        image[3] = prr->in_cycle ? prr->cycle_end : 0;
+        image[4] = count;
+    }
+    return (size_t)(5 + count) * sizeof(int);
+}
+
+static void priority_rr_restore(void *state, const void *buffer)
+{
+    PriorityRrState *prr = state;
+    const int *image = buffer;
+    prr->in_cycle = image[0];
+    prr->cycle_level = image[1];
+    prr->cursor = image[2];
+    prr->cycle_end = image[3];
+    for (int i = 0; i < image[4]; i++)
+    {
+        priority_buckets_push_back(&prr->buckets, prr->level[image[5 + i]], image[5 + i]);
+    }
+}
+
+/* ========================================================================================*/
+/* POLICY TABLE */
+/* ========================================================================================*/
+
+const SchedPolicy SCHED_POLICY_FCFS = {"FCFS", false, fcfs_init, fifo_on_arrival, fifo_pick_next, NULL, NULL,
+                                       fifo_save, fifo_restore};
+const SchedPolicy SCHED_POLICY_SJF = {"SJF", false, sjf_init, heap_on_arrival, heap_pop_next, NULL, NULL,
+                                      heap_save, heap_restore};
+const SchedPolicy SCHED_POLICY_SRTF = {"SRTF", false, srtf_init, heap_on_arrival, heap_peek_next,
+                                       srtf_on_event, srtf_on_complete, heap_save, heap_restore};
+const SchedPolicy SCHED_POLICY_RR = {"RR", true, rr_init, fifo_on_arrival, fifo_pick_next, rr_on_event, NULL,
+                                     fifo_save, fifo_restore};
+const SchedPolicy SCHED_POLICY_PRIORITY = {"PRIORITY_NP", false, priority_init, heap_on_arrival, heap_pop_next,
+                                           NULL, NULL, heap_save, heap_restore};
+const SchedPolicy SCHED_POLICY_PRIORITY_RR = {"PRIORITY_RR", true, priority_rr_init, priority_rr_on_arrival,
+                                              priority_rr_pick_next, priority_rr_on_event, priority_rr_on_complete,
+                                              priority_rr_save, priority_rr_restore};
+
+static const SchedPolicy *const BUILT_IN_POLICIES[] = {
+    &SCHED_POLICY_FCFS, &SCHED_POLICY_SJF, &SCHED_POLICY_SRTF,
+    &SCHED_POLICY_RR, &SCHED_POLICY_PRIORITY, &SCHED_POLICY_PRIORITY_RR,
+};
+
+/* ========================================================================================*/
+/**
+ * Looks up a built-in policy by its name (case-insensitive), NULL if unknown.
+ */
+const SchedPolicy *sched_find_policy(const char *name)
+{
+    for (size_t i = 0; i < sizeof(BUILT_IN_POLICIES) / sizeof(BUILT_IN_POLICIES[0]); i++)
+    {
+        if (strcasecmp(name, BUILT_IN_POLICIES[i]->name) == 0)
+        {
+            return BUILT_IN_POLICIES[i];
+        }
+    }
+    return NULL;
+}
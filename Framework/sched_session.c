@@ -0,0 +1,809 @@
+/**
+ * ===============================================================================
+ * WHAT-IF SESSIONS
+ * ===============================================================================
+ * @file sched_session.c
+ * @brief Checkpointed baseline runs and incremental what-if re-simulation
+ *
+ * A session runs its baseline once on the shared event loop and records a
+ * checkpoint every few decisions: clock, admission cursor, the admitted jobs
+ * still unfinished with their remaining times, and the policy's saved image.
+ * A what-if query patches the few changed ranks into the columns, restores
+ * the last checkpoint taken before the earliest affected arrival, and runs
+ * until its state matches a later checkpoint at the same clock (same pending
+ * arrivals, same unfinished jobs, same image, every moved job finished); the
+ * baseline results are then exact for everything that has not completed yet.
+ *
+ * Between queries the work columns hold the baseline results, so a query
+ * only touches the ranks it simulates. Queries on one session must not run
+ * concurrently; separate sessions are independent.
+ * ===============================================================================
+ */
+
+#include <limits.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sched_loop.h"
+#include "priority_buckets.h"
+
+#define SCHED_DEFAULT_CHECKPOINT_INTERVAL 256
+#define CHECKPOINT_ALIGNMENT alignof(max_align_t)
+
+/* ========================================================================================*/
+// Loop state at one decision of the baseline
+typedef struct
+{
+    int time;
+    int next_arrival;
+    int last;
+    int completed;
+    int num_active;
+    long long num_dispatches;
+    long long num_preemptions;
+    long long num_events;
+    size_t offset;              // Into data: (rank, remaining) per active job, then the image
+    size_t image_size;          // 0 = freshly initialized policy state
+} Checkpoint;
+
+struct SchedSession
+{
+    const SchedPolicy *policy;
+    int time_quantum;
+    int num_jobs;
+    int checkpoint_interval;
+    SchedJob *jobs;             // Baseline workload (patched during a query)
+    RankKey *keys;              // Baseline sort key of each rank
+    int *rank_of;               // rank_of[index] = baseline rank
+    int *distinct;              // Sorted distinct priorities: the level map
+    int num_levels;
+    RunColumns base;            // Baseline columns and results (no remaining_time)
+    RunColumns work;            // Columns the loop runs on
+    int *active_links;
+    unsigned char *block;       // Everything above lives in one allocation
+    SchedMemory policy_memory;
+    SchedView view;
+    Checkpoint *checkpoints;
+    int num_checkpoints;
+    int checkpoint_capacity;
+    unsigned char *data;
+    size_t data_size;
+    size_t data_capacity;
+    unsigned char *image;       // Scratch image for the convergence test
+    size_t image_capacity;
+    SchedSummary baseline;
+    int last_arrival;           // Baseline bounds of run_horizon()
+    long long total_burst;
+    long long total_turnaround;
+    long long total_waiting;
+};
+
+// One changed job of a query
+typedef struct
+{
+    RankKey key;                // New sort key
+    int rank;                   // Baseline rank
+    int level;
+    SchedJob saved;
+} JobEdit;
+
+// State of the convergence test while a query runs
+typedef struct
+{
+    SchedSession *session;
+    int cursor;                 // Next checkpoint that may match
+    int lo;                     // Ranks whose job differs from the baseline's
+    int hi;
+    const Checkpoint *matched;
+} WhatIfRun;
+
+/* ========================================================================================*/
+/* MEMORY */
+/* ========================================================================================*/
+
+static void take_run_columns(SchedMemory *memory, RunColumns *columns, int n, bool with_remaining)
+{
+    columns->order = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->arrival_time = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->burst_time = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->priority = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->level = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->remaining_time = with_remaining ? sched_memory_take(memory, (size_t)n, sizeof(int)) : NULL;
+    columns->start_time = sched_memory_take(memory, (size_t)n, sizeof(int));
+    columns->completion_time = sched_memory_take(memory, (size_t)n, sizeof(int));
+}
+
+static void take_session_arrays(SchedMemory *memory, SchedSession *session, int n)
+{
+    session->jobs = sched_memory_take(memory, (size_t)n, sizeof(SchedJob));
+    session->keys = sched_memory_take(memory, (size_t)n, sizeof(RankKey));
+    session->rank_of = sched_memory_take(memory, (size_t)n, sizeof(int));
+    session->distinct = sched_memory_take(memory, (size_t)n, sizeof(int));
+    session->active_links = sched_memory_take(memory, 2 * (size_t)n, sizeof(int));
+    take_run_columns(memory, &session->base, n, false);
+    take_run_columns(memory, &session->work, n, true);
+}
+
+/* ========================================================================================*/
+
+static bool reserve_bytes(unsigned char **buffer, size_t *capacity, size_t needed)
+{
+    if (needed <= *capacity)
+    {
+        return true;
+    }
+    size_t grown = (*capacity > 0) ? *capacity : 4096;
+    while (grown < needed)
+    {
+        grown = (grown > SIZE_MAX / 2) ? needed : grown * 2;
+    }
+    unsigned char *bigger = realloc(*buffer, grown);
+    if (bigger == NULL)
+    {
+        return false;
+    }
+    *buffer = bigger;
+    *capacity = grown;
+    return true;
+}
+
+/* ========================================================================================*/
+/* CHECKPOINTS */
+/* ========================================================================================*/
+
+static bool record_checkpoint(SchedSession *session, const RunLoop *loop)
+{
+    if (session->num_checkpoints == session->checkpoint_capacity)
+    {
+        int capacity = (session->checkpoint_capacity > 0) ? session->checkpoint_capacity * 2 : 64;
+        Checkpoint *bigger = realloc(session->checkpoints, (size_t)capacity * sizeof(Checkpoint));
+        if (bigger == NULL)
+        {
+            return false;
+        }
+        session->checkpoints = bigger;
+        session->checkpoint_capacity = capacity;
+    }
+
+    const SchedPolicy *policy = session->policy;
+    size_t pairs = (size_t)loop->num_active * 2 * sizeof(int);
+    size_t image_size = (policy->save != NULL && loop->num_events > 0) ? policy->save(loop->state, NULL) : 0;
+    size_t offset = (session->data_size + CHECKPOINT_ALIGNMENT - 1) & ~(CHECKPOINT_ALIGNMENT - 1);
+    if (!reserve_bytes(&session->data, &session->data_capacity, offset + pairs + image_size))
+    {
+        return false;
+    }
+
+    int *pair = (int *)(session->data + offset);
+    for (int job = loop->active_head; job >= 0; job = loop->active_next[job])
+    {
+        *pair++ = job;
+        *pair++ = loop->columns->remaining_time[job];
+    }
+    if (image_size > 0)
+    {
+        policy->save(loop->state, session->data + offset + pairs);
+    }
+    session->data_size = offset + pairs + image_size;
+
+    Checkpoint *checkpoint = &session->checkpoints[session->num_checkpoints++];
+    checkpoint->time = loop->time;
+    checkpoint->next_arrival = loop->next_arrival;
+    checkpoint->last = loop->last;
+    checkpoint->completed = loop->completed;
+    checkpoint->num_active = loop->num_active;
+    checkpoint->num_dispatches = loop->num_dispatches;
+    checkpoint->num_preemptions = loop->num_preemptions;
+    checkpoint->num_events = loop->num_events;
+    checkpoint->offset = offset;
+    checkpoint->image_size = image_size;
+    return true;
+}
+
+/* ========================================================================================*/
+
+// A checkpoint of k ints is not followed by another for k decisions, so
+// recording stays O(1) amortized per decision even with long ready queues
+static bool baseline_hook(RunLoop *loop, void *arg)
+{
+    SchedSession *session = arg;
+    const Checkpoint *last = &session->checkpoints[session->num_checkpoints - 1];
+    long long spacing = (long long)((last->image_size / sizeof(int)) + 2 * (size_t)last->num_active);
+    if (spacing < session->checkpoint_interval)
+    {
+        spacing = session->checkpoint_interval;
+    }
+    if (loop->num_events - last->num_events < spacing)
+    {
+        return true;
+    }
+    if (!record_checkpoint(session, loop))
+    {
+        session->num_checkpoints = -1;      // Out of memory: stop the loop
+        return false;
+    }
+    return true;
+}
+
+/* ========================================================================================*/
+
+static void *reset_policy_state(SchedSession *session)
+{
+    session->policy_memory.used = 0;
+    return session->policy->init(&session->policy_memory, &session->view, session->time_quantum);
+}
+
+static bool states_match(const WhatIfRun *run, const RunLoop *loop, const Checkpoint *checkpoint)
+{
+    SchedSession *session = run->session;
+    if (checkpoint->next_arrival != loop->next_arrival || checkpoint->num_active != loop->num_active)
+    {
+        return false;
+    }
+    int last = (loop->last >= 0) ? session->work.order[loop->last] : -1;
+    int base_last = (checkpoint->last >= 0) ? session->base.order[checkpoint->last] : -1;
+    if (last != base_last)
+    {
+        return false;
+    }
+
+    // Outside [lo, hi] a rank names the same job in both runs
+    const int *pair = (const int *)(session->data + checkpoint->offset);
+    for (int job = loop->active_head; job >= 0; job = loop->active_next[job], pair += 2)
+    {
+        if (job != pair[0] || loop->columns->remaining_time[job] != pair[1] || (job >= run->lo && job <= run->hi))
+        {
+            return false;
+        }
+    }
+
+    size_t image_size = session->policy->save(loop->state, NULL);
+    if (image_size != checkpoint->image_size ||
+        !reserve_bytes(&session->image, &session->image_capacity, image_size))
+    {
+        return false;
+    }
+    session->policy->save(loop->state, session->image);
+    return memcmp(session->image, (const unsigned char *)pair, image_size) == 0;
+}
+
+static bool what_if_hook(RunLoop *loop, void *arg)
+{
+    WhatIfRun *run = arg;
+    const SchedSession *session = run->session;
+    while (run->cursor < session->num_checkpoints && session->checkpoints[run->cursor].time < loop->time)
+    {
+        run->cursor++;
+    }
+    if (run->cursor == session->num_checkpoints || loop->next_arrival <= run->hi)
+    {
+        return true;
+    }
+    const Checkpoint *checkpoint = &session->checkpoints[run->cursor];
+    if (checkpoint->time == loop->time && states_match(run, loop, checkpoint))
+    {
+        run->matched = checkpoint;
+        return false;
+    }
+    return true;
+}
+
+/* ========================================================================================*/
+/* SESSION LIFETIME */
+/* ========================================================================================*/
+/**
+ * Runs the baseline of workload under policy and keeps checkpoints about
+ * every checkpoint_interval decisions (<= 0 picks a default). Policies
+ * without save/restore only get the initial checkpoint, so their queries
+ * always re-simulate from time 0.
+ */
+SchedStatus sched_session_create(const SchedPolicy *policy, const SchedWorkload *workload, const SchedParams *params,
+                                 int checkpoint_interval, SchedSession **session)
+{
+    if (session == NULL || !valid_run_arguments(policy, workload, params) ||
+        (policy->save == NULL) != (policy->restore == NULL))
+    {
+        return SCHED_ERROR_INVALID_ARGUMENT;
+    }
+    *session = NULL;
+    SchedSession *created = calloc(1, sizeof(SchedSession));
+    if (created == NULL)
+    {
+        return SCHED_ERROR_NO_MEMORY;
+    }
+    int n = workload->num_jobs;
+    created->policy = policy;
+    created->time_quantum = params->time_quantum;
+    created->num_jobs = n;
+    created->checkpoint_interval = (checkpoint_interval > 0) ? checkpoint_interval : SCHED_DEFAULT_CHECKPOINT_INTERVAL;
+
+    SchedMemory memory = {NULL, 0};
+    take_session_arrays(&memory, created, n);
+    created->block = (memory.used == SIZE_MAX) ? NULL : malloc(memory.used > 0 ? memory.used : 1);
+    if (created->block == NULL)
+    {
+        sched_session_free(created);
+        return SCHED_ERROR_NO_MEMORY;
+    }
+    memory.base = created->block;
+    memory.used = 0;
+    take_session_arrays(&memory, created, n);
+
+    // Baseline columns, copied into the work columns
+    memcpy(created->jobs, workload->jobs, (size_t)n * sizeof(SchedJob));
+    for (int i = 0; i < n; i++)
+    {
+        created->last_arrival = (workload->jobs[i].arrival_time > created->last_arrival) ? workload->jobs[i].arrival_time
+                                                                                         : created->last_arrival;
+        created->total_burst += workload->jobs[i].burst_time;
+    }
+    sort_rank_keys(created->jobs, n, created->keys);
+    RunColumns *base = &created->base;
+    for (int k = 0; k < n; k++)
+    {
+        const SchedJob *job = &created->jobs[created->keys[k].index];
+        created->rank_of[created->keys[k].index] = k;
+        base->order[k] = created->keys[k].index;
+        base->arrival_time[k] = job->arrival_time;
+        base->burst_time[k] = job->burst_time;
+        base->priority[k] = job->priority;
+    }
+    created->num_levels = priority_buckets_fill_levels(base->priority, n, created->distinct, base->level);
+    RunColumns *work = &created->work;
+    memcpy(work->order, base->order, (size_t)n * sizeof(int));
+    memcpy(work->arrival_time, base->arrival_time, (size_t)n * sizeof(int));
+    memcpy(work->burst_time, base->burst_time, (size_t)n * sizeof(int));
+    memcpy(work->priority, base->priority, (size_t)n * sizeof(int));
+    memcpy(work->level, base->level, (size_t)n * sizeof(int));
+
+    SchedView *view = &created->view;
+    view->num_jobs = n;
+    view->arrival_time = work->arrival_time;
+    view->burst_time = work->burst_time;
+    view->priority = work->priority;
+    view->level = work->level;
+    view->num_levels = created->num_levels;
+    view->remaining_time = work->remaining_time;
+
+    // Sizing pass, then the real one
+    created->policy_memory = (SchedMemory){NULL, 0};
+    policy->init(&created->policy_memory, view, params->time_quantum);
+    size_t policy_bytes = created->policy_memory.used;
+    created->policy_memory.base = (policy_bytes == SIZE_MAX) ? NULL : malloc(policy_bytes > 0 ? policy_bytes : 1);
+    if (created->policy_memory.base == NULL)
+    {
+        sched_session_free(created);
+        return SCHED_ERROR_NO_MEMORY;
+    }
+
+    RunLoop loop;
+    run_loop_init(&loop, policy, reset_policy_state(created), work, n, created->active_links);
+    if (!record_checkpoint(created, &loop))
+    {
+        sched_session_free(created);
+        return SCHED_ERROR_NO_MEMORY;
+    }
+    SchedStatus status = run_loop_simulate(&loop, (policy->save != NULL) ? baseline_hook : NULL, created);
+    if (status == SCHED_OK && created->num_checkpoints < 0)
+    {
+        status = SCHED_ERROR_NO_MEMORY;
+    }
+    if (status != SCHED_OK)
+    {
+        sched_session_free(created);
+        return status;
+    }
+
+    run_loop_summarize(&loop, NULL, &created->baseline);
+    memcpy(base->start_time, work->start_time, (size_t)n * sizeof(int));
+    memcpy(base->completion_time, work->completion_time, (size_t)n * sizeof(int));
+    for (int k = 0; k < n; k++)
+    {
+        int turnaround = base->completion_time[k] - base->arrival_time[k];
+        created->total_turnaround += turnaround;
+        created->total_waiting += turnaround - base->burst_time[k];
+    }
+    *session = created;
+    return SCHED_OK;
+}
+
+/* ========================================================================================*/
+
+void sched_session_free(SchedSession *session)
+{
+    if (session == NULL)
+    {
+        return;
+    }
+    free(session->image);
+    free(session->data);
+    free(session->checkpoints);
+    free(session->policy_memory.base);
+    free(session->block);
+    free(session);
+}
+
+/* ========================================================================================*/
+/**
+ * Writes the baseline results (results may be NULL) and summary.
+ */
+SchedStatus sched_session_baseline(const SchedSession *session, SchedJobResult *results, SchedSummary *summary)
+{
+    if (session == NULL)
+    {
+        return SCHED_ERROR_INVALID_ARGUMENT;
+    }
+    const RunColumns *base = &session->base;
+    for (int k = 0; results != NULL && k < session->num_jobs; k++)
+    {
+        SchedJobResult *result = &results[base->order[k]];
+        result->start_time = base->start_time[k];
+        result->completion_time = base->completion_time[k];
+        result->turnaround_time = base->completion_time[k] - base->arrival_time[k];
+        result->waiting_time = result->turnaround_time - base->burst_time[k];
+    }
+    if (summary != NULL)
+    {
+        *summary = session->baseline;
+    }
+    return SCHED_OK;
+}
+
+/* ========================================================================================*/
+/* WHAT-IF QUERIES */
+/* ========================================================================================*/
+
+static int compare_edit_keys(const void *lhs, const void *rhs)
+{
+    return compare_rank_keys(&((const JobEdit *)lhs)->key, &((const JobEdit *)rhs)->key);
+}
+
+static int compare_ranks(const void *lhs, const void *rhs)
+{
+    int a = *(const int *)lhs;
+    int b = *(const int *)rhs;
+    return (a > b) - (a < b);
+}
+
+// Level of a priority in the baseline map, -1 if the baseline never uses it
+static int find_level(const SchedSession *session, int priority)
+{
+    int lo = 0, hi = session->num_levels;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (session->distinct[mid] < priority)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return (lo < session->num_levels && session->distinct[lo] == priority) ? lo : -1;
+}
+
+// First baseline rank whose key is not below key
+static int insertion_rank(const SchedSession *session, const RankKey *key)
+{
+    int lo = 0, hi = session->num_jobs;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (compare_rank_keys(&session->keys[mid], key) < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* ========================================================================================*/
+
+// Re-sorts the work columns over [lo, hi]: the unchanged baseline ranks there
+// merged with the edits (sorted by new key); old_ranks is sorted
+static void patch_ranks(SchedSession *session, const JobEdit *edits, const int *old_ranks, int num_edits, int lo, int hi)
+{
+    RunColumns *work = &session->work;
+    int next_edit = 0, next_old = 0;
+    int k = lo;
+    for (int b = lo; b <= hi + 1; b++)
+    {
+        while (next_old < num_edits && old_ranks[next_old] < b)
+        {
+            next_old++;
+        }
+        bool skip = (b <= hi) && next_old < num_edits && old_ranks[next_old] == b;
+        while (next_edit < num_edits && (b > hi || (!skip && compare_rank_keys(&edits[next_edit].key,
+                                                                               &session->keys[b]) < 0)))
+        {
+            work->order[k++] = edits[next_edit++].key.index;
+        }
+        if (b <= hi && !skip)
+        {
+            work->order[k++] = session->base.order[b];
+        }
+    }
+    for (k = lo; k <= hi; k++)
+    {
+        const SchedJob *job = &session->jobs[work->order[k]];
+        work->arrival_time[k] = job->arrival_time;
+        work->burst_time[k] = job->burst_time;
+        work->priority[k] = job->priority;
+        work->level[k] = find_level(session, job->priority);
+    }
+}
+
+/* ========================================================================================*/
+
+// Puts the baseline back into the work columns over the ranks a query touched
+static void restore_baseline(SchedSession *session, const Checkpoint *resume, int end, int lo, int hi)
+{
+    RunColumns *work = &session->work;
+    const RunColumns *base = &session->base;
+    const int *pair = (const int *)(session->data + resume->offset);
+    for (int i = 0; i < resume->num_active; i++, pair += 2)
+    {
+        work->remaining_time[pair[0]] = 0;
+        work->start_time[pair[0]] = base->start_time[pair[0]];
+        work->completion_time[pair[0]] = base->completion_time[pair[0]];
+    }
+    size_t count = (size_t)(end - resume->next_arrival);
+    memset(work->remaining_time + resume->next_arrival, 0, count * sizeof(int));
+    memcpy(work->start_time + resume->next_arrival, base->start_time + resume->next_arrival, count * sizeof(int));
+    memcpy(work->completion_time + resume->next_arrival, base->completion_time + resume->next_arrival,
+           count * sizeof(int));
+    if (lo <= hi)
+    {
+        count = (size_t)(hi - lo + 1);
+        memcpy(work->order + lo, base->order + lo, count * sizeof(int));
+        memcpy(work->arrival_time + lo, base->arrival_time + lo, count * sizeof(int));
+        memcpy(work->burst_time + lo, base->burst_time + lo, count * sizeof(int));
+        memcpy(work->priority + lo, base->priority + lo, count * sizeof(int));
+        memcpy(work->level + lo, base->level + lo, count * sizeof(int));
+    }
+}
+
+/* ========================================================================================*/
+
+// A priority outside the level map renumbers the levels, so no checkpoint
+// applies: schedule the patched workload from scratch
+static SchedStatus run_without_session(SchedSession *session, SchedJobResult *results, SchedSummary *summary,
+                                       SchedWhatIfInfo *info)
+{
+    SchedJobResult *output = results;
+    if (output == NULL && (output = malloc((size_t)session->num_jobs * sizeof(SchedJobResult))) == NULL)
+    {
+        return SCHED_ERROR_NO_MEMORY;
+    }
+    SchedWorkload workload = {session->jobs, session->num_jobs};
+    SchedParams params = {session->time_quantum};
+    SchedSummary totals;
+    SchedStatus status = sched_run(session->policy, &workload, &params, output, &totals);
+    if (output != results)
+    {
+        free(output);
+    }
+    if (status == SCHED_OK && summary != NULL)
+    {
+        *summary = totals;
+    }
+    if (info != NULL)
+    {
+        *info = (SchedWhatIfInfo){0, -1, -1};
+    }
+    return status;
+}
+
+/* ========================================================================================*/
+/**
+ * Schedules the baseline workload with changes applied. results (may be
+ * NULL, which saves an O(n) pass) and *summary are as for sched_run();
+ * *info (may be NULL) tells how much of the trace was re-simulated.
+ */
+SchedStatus sched_session_what_if(SchedSession *session, const SchedJobChange *changes, int num_changes,
+                                  SchedJobResult *results, SchedSummary *summary, SchedWhatIfInfo *info)
+{
+    if (session == NULL || num_changes < 0 || (num_changes > 0 && changes == NULL))
+    {
+        return SCHED_ERROR_INVALID_ARGUMENT;
+    }
+    int n = session->num_jobs;
+    long long last_arrival = session->last_arrival;
+    long long total_burst = session->total_burst;
+    for (int i = 0; i < num_changes; i++)
+    {
+        const SchedJobChange *change = &changes[i];
+        if (change->job < 0 || change->job >= n || change->burst_time <= 0 || change->arrival_time < 0 ||
+            change->priority < 0)
+        {
+            return SCHED_ERROR_INVALID_ARGUMENT;
+        }
+        // Upper bound of the changed workload's run_horizon(), as for sched_run()
+        last_arrival = (change->arrival_time > last_arrival) ? change->arrival_time : last_arrival;
+        total_burst += change->burst_time - session->jobs[change->job].burst_time;
+    }
+    if (last_arrival + total_burst > INT_MAX)
+    {
+        return SCHED_ERROR_INVALID_ARGUMENT;
+    }
+    if (num_changes == 0)
+    {
+        if (info != NULL)
+        {
+            *info = (SchedWhatIfInfo){0, 0, 0};
+        }
+        return sched_session_baseline(session, results, summary);
+    }
+
+    JobEdit *edits = malloc((size_t)num_changes * (sizeof(JobEdit) + sizeof(int)));
+    if (edits == NULL)
+    {
+        return SCHED_ERROR_NO_MEMORY;
+    }
+    int *old_ranks = (int *)(edits + num_changes);
+    int lo = n, hi = -1;
+    int first_arrival = INT32_MAX;
+    bool in_level_map = true;
+    for (int i = 0; i < num_changes; i++)
+    {
+        const SchedJobChange *change = &changes[i];
+        const SchedJob *job = &session->jobs[change->job];
+        JobEdit *edit = &edits[i];
+        edit->key = (RankKey){change->arrival_time, job->id, change->job};
+        edit->rank = session->rank_of[change->job];
+        edit->level = find_level(session, change->priority);
+        edit->saved = *job;
+        old_ranks[i] = edit->rank;
+        in_level_map = in_level_map && edit->level >= 0;
+
+        // Ranks from min(old, new position) to max(old, new position - 1) change hands
+        int position = insertion_rank(session, &edit->key);
+        lo = (edit->rank < lo) ? edit->rank : lo;
+        lo = (position < lo) ? position : lo;
+        hi = (edit->rank > hi) ? edit->rank : hi;
+        hi = (position - 1 > hi) ? position - 1 : hi;
+        first_arrival = (job->arrival_time < first_arrival) ? job->arrival_time : first_arrival;
+        first_arrival = (change->arrival_time < first_arrival) ? change->arrival_time : first_arrival;
+    }
+    qsort(old_ranks, (size_t)num_changes, sizeof(int), compare_ranks);
+    for (int i = 1; i < num_changes; i++)
+    {
+        if (old_ranks[i] == old_ranks[i - 1])
+        {
+            free(edits);
+            return SCHED_ERROR_INVALID_ARGUMENT;
+        }
+    }
+    for (int i = 0; i < num_changes; i++)
+    {
+        SchedJob *job = &session->jobs[changes[i].job];
+        job->arrival_time = changes[i].arrival_time;
+        job->burst_time = changes[i].burst_time;
+        job->priority = changes[i].priority;
+    }
+
+    SchedStatus status;
+    if (!in_level_map)
+    {
+        status = run_without_session(session, results, summary, info);
+    }
+    else
+    {
+        qsort(edits, (size_t)num_changes, sizeof(JobEdit), compare_edit_keys);
+        patch_ranks(session, edits, old_ranks, num_changes, lo, hi);
+
+        // Last checkpoint whose admitted jobs all arrived before the first change
+        int resume_index = 0;
+        for (int a = 1, b = session->num_checkpoints - 1; a <= b;)
+        {
+            int mid = a + (b - a) / 2;
+            if (session->checkpoints[mid].time < first_arrival)
+            {
+                resume_index = mid;
+                a = mid + 1;
+            }
+            else
+            {
+                b = mid - 1;
+            }
+        }
+        const Checkpoint *resume = &session->checkpoints[resume_index];
+
+        RunColumns *work = &session->work;
+        const RunColumns *base = &session->base;
+        void *state = reset_policy_state(session);
+        if (resume->image_size > 0)
+        {
+            session->policy->restore(state, session->data + resume->offset + 2 * sizeof(int) * resume->num_active);
+        }
+        RunLoop loop;
+        run_loop_init(&loop, session->policy, state, work, n, session->active_links);
+        loop.time = resume->time;
+        loop.next_arrival = resume->next_arrival;
+        loop.last = resume->last;
+        loop.completed = resume->completed;
+        loop.num_dispatches = resume->num_dispatches;
+        loop.num_preemptions = resume->num_preemptions;
+        const int *pair = (const int *)(session->data + resume->offset);
+        for (int i = 0; i < resume->num_active; i++, pair += 2)
+        {
+            run_loop_activate(&loop, pair[0]);
+            work->remaining_time[pair[0]] = pair[1];
+            work->start_time[pair[0]] = (base->start_time[pair[0]] < resume->time) ? base->start_time[pair[0]] : -1;
+        }
+
+        WhatIfRun run = {session, resume_index + 1, lo, hi, NULL};
+        status = run_loop_simulate(&loop, (session->policy->save != NULL) ? what_if_hook : NULL, &run);
+        int end = (run.matched != NULL) ? loop.next_arrival : n;
+        if (status == SCHED_OK)
+        {
+            // From the match on the baseline is exact for every unfinished job,
+            // except the start times the re-simulation already set
+            for (int job = loop.active_head; run.matched != NULL && job >= 0; job = loop.active_next[job])
+            {
+                if (work->start_time[job] < 0)
+                {
+                    work->start_time[job] = base->start_time[job];
+                }
+                work->completion_time[job] = base->completion_time[job];
+            }
+
+            // Only the re-simulated ranks can differ from the baseline totals
+            long long turnaround = session->total_turnaround;
+            long long waiting = session->total_waiting;
+            pair = (const int *)(session->data + resume->offset);
+            for (int i = -resume->num_active; i < end - resume->next_arrival; i++)
+            {
+                int k = (i < 0) ? pair[2 * (i + resume->num_active)] : resume->next_arrival + i;
+                int was = base->completion_time[k] - base->arrival_time[k];
+                int is = work->completion_time[k] - work->arrival_time[k];
+                turnaround += is - was;
+                waiting += (is - work->burst_time[k]) - (was - base->burst_time[k]);
+            }
+            if (summary != NULL)
+            {
+                SchedSummary *totals = summary;
+                memset(totals, 0, sizeof(*totals));
+                totals->makespan = (run.matched != NULL) ? session->baseline.makespan : loop.time;
+                totals->avg_turnaround = (double)turnaround / n;
+                totals->avg_waiting = (double)waiting / n;
+                totals->num_dispatches = loop.num_dispatches;
+                totals->num_preemptions = loop.num_preemptions;
+                if (run.matched != NULL)
+                {
+                    totals->num_dispatches += session->baseline.num_dispatches - run.matched->num_dispatches;
+                    totals->num_preemptions += session->baseline.num_preemptions - run.matched->num_preemptions;
+                }
+            }
+            for (int k = 0; results != NULL && k < n; k++)
+            {
+                SchedJobResult *result = &results[work->order[k]];
+                result->start_time = work->start_time[k];
+                result->completion_time = work->completion_time[k];
+                result->turnaround_time = work->completion_time[k] - work->arrival_time[k];
+                result->waiting_time = result->turnaround_time - work->burst_time[k];
+            }
+            if (info != NULL)
+            {
+                info->resume_time = resume->time;
+                info->converge_time = (run.matched != NULL) ? run.matched->time : -1;
+                info->num_events = loop.num_events;
+            }
+        }
+        restore_baseline(session, resume, (status == SCHED_OK) ? end : n, lo, hi);
+    }
+
+    for (int i = 0; i < num_changes; i++)
+    {
+        session->jobs[edits[i].key.index] = edits[i].saved;
+    }
+    free(edits);
+    return status;
+}
@@ -0,0 +1,107 @@
+/**
+ * ===============================================================================
+ * HOT-PATH STATISTICS
+ * ===============================================================================
+ * @file sched_stats.c
+ * @brief Thread-local counters, phase clock and the per-run report
+ *
+ * Empty unless the build defines SCHED_STATS (see sched_stats.h).
+ * ===============================================================================
+ */
+
+#include <time.h>
+#include "sched_stats.h"
+
+#ifdef SCHED_STATS
+
+#if defined(__x86_64__) || defined(__i386__)
+#define STATS_CLOCK_UNIT "TSC cycles"
+#else
+#define STATS_CLOCK_UNIT "ns"
+#endif
+
+_Thread_local SchedStats sched_stats;
+
+static const char *const COUNTER_NAMES[STAT_NUM_COUNTERS] = {
+    [STAT_LOOP_ITERATIONS] = "Loop iterations (events)",
+    [STAT_SCANS] = "Selection scans",
+    [STAT_SCAN_ENTRIES] = "Scanned entries",
+    [STAT_HEAP_PUSHES] = "Heap pushes",
+    [STAT_HEAP_POPS] = "Heap pops",
+    [STAT_HEAP_UPDATES] = "Heap key updates",
+    [STAT_QUEUE_PUSHES] = "Queue enqueues",
+    [STAT_QUEUE_POPS] = "Queue dequeues",
+    [STAT_BUCKET_PUSHES] = "Bucket appends",
+    [STAT_BUCKET_REMOVALS] = "Bucket removals",
+    [STAT_IDLE_JUMPS] = "Idle jumps",
+    [STAT_DISPATCHES] = "Dispatches",
+    [STAT_PREEMPTIONS] = "Preemptions",
+};
+
+static const char *const PHASE_NAMES[STATS_NUM_PHASES] = {
+    [STATS_PHASE_LOAD] = "Load (once)",
+    [STATS_PHASE_VALIDATE] = "Validate (once)",
+    [STATS_PHASE_SIMULATE] = "Simulate",
+    [STATS_PHASE_OUTPUT] = "Output",
+};
+
+/* ========================================================================================*/
+
+uint64_t sched_stats_clock(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/* ========================================================================================*/
+
+// Clears the per-run counters and phases; load and validate are kept
+void sched_stats_begin_run(void)
+{
+    memset(sched_stats.counters, 0, sizeof(sched_stats.counters));
+    sched_stats.phase_time[STATS_PHASE_SIMULATE] = 0;
+    sched_stats.phase_time[STATS_PHASE_OUTPUT] = 0;
+    sched_stats.run_start = sched_stats_clock();
+}
+
+/* ========================================================================================*/
+/**
+ * Closes the run started by sched_stats_begin_run(): everything that was not
+ * output counts as simulation. Prints the phases, the counters and the
+ * simulated time span of ctx's schedule to report.
+ */
+void sched_stats_end_run(const SchedulerContext *ctx, const char *algorithm_name, FILE *report)
+{
+    uint64_t total = sched_stats_clock() - sched_stats.run_start;
+    uint64_t output = sched_stats.phase_time[STATS_PHASE_OUTPUT];
+    sched_stats.phase_time[STATS_PHASE_SIMULATE] = (total > output) ? total - output : 0;
+
+    long long span = 0;
+    for (int i = 0; i < ctx->num_processes; i++)
+    {
+        span = (ctx->processes[i].completion_time > span) ? ctx->processes[i].completion_time : span;
+    }
+
+    fprintf(report, "Stats: %s\n", algorithm_name);
+    fprintf(report, "  %-28s%s\n", "Phase", STATS_CLOCK_UNIT);
+    for (int phase = 0; phase < STATS_NUM_PHASES; phase++)
+    {
+        fprintf(report, "  %-28s%llu\n", PHASE_NAMES[phase], (unsigned long long)sched_stats.phase_time[phase]);
+    }
+    fprintf(report, "  %-28s%s\n", "Counter", "Count");
+    for (int counter = 0; counter < STAT_NUM_COUNTERS; counter++)
+    {
+        fprintf(report, "  %-28s%llu\n", COUNTER_NAMES[counter], (unsigned long long)sched_stats.counters[counter]);
+    }
+
+    uint64_t events = sched_stats.counters[STAT_LOOP_ITERATIONS];
+    fprintf(report, "  %-28s%lld\n", "Simulated time units", span);
+    fprintf(report, "  %-28s%.3f\n", "Time units per event", (events > 0) ? (double)span / (double)events : 0.0);
+}
+
+#endif // SCHED_STATS
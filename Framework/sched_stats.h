@@ -0,0 +1,92 @@
+/*
+ * ===============================================================================
+ * HOT-PATH STATISTICS HEADER FILE
+ * ===============================================================================
+ *
+ * Optional counters and phase timers that show where a scheduler run spends
+ * its work: selection scans, heap, queue and bucket operations, idle jumps,
+ * dispatches and preemptions, and how many loop iterations (events) the
+ * engine needed for the simulated time span. The phases are load and
+ * validate (once per program) and simulate and output (per run, output being
+ * display_results()). Phase times are TSC cycles on x86, nanoseconds
+ * elsewhere.
+ *
+ * Everything is compiled in only with -DSCHED_STATS (make STATS=1); without
+ * it every macro below expands to nothing. The counters are thread-local, so
+ * parallel runs do not contend, but only the sequential runs print a report
+ * (to stderr, after each algorithm's results).
+ *
+ * ===============================================================================
+ */
+
+#ifndef SCHED_STATS_H
+#define SCHED_STATS_H
+
+#include "CPU_scheduler.h"
+
+/* ========================================================================================*/
+// Counted operations
+typedef enum
+{
+    STAT_LOOP_ITERATIONS,       // Scheduling loop iterations, i.e. events handled
+    STAT_SCANS,                 // Ready set selections by linear scan
+    STAT_SCAN_ENTRIES,          // Entries examined by those scans
+    STAT_HEAP_PUSHES,
+    STAT_HEAP_POPS,
+    STAT_HEAP_UPDATES,
+    STAT_QUEUE_PUSHES,          // Ring queue (RR ready queue)
+    STAT_QUEUE_POPS,
+    STAT_BUCKET_PUSHES,         // Priority buckets (Priority RR ready structure)
+    STAT_BUCKET_REMOVALS,
+    STAT_IDLE_JUMPS,            // Jumps over idle CPU time to the next arrival
+    STAT_DISPATCHES,
+    STAT_PREEMPTIONS,
+    STAT_NUM_COUNTERS
+} StatsCounter;
+
+// Timed phases
+typedef enum
+{
+    STATS_PHASE_LOAD,
+    STATS_PHASE_VALIDATE,
+    STATS_PHASE_SIMULATE,
+    STATS_PHASE_OUTPUT,
+    STATS_NUM_PHASES
+} StatsPhase;
+
+// Structure to hold the statistics of the current thread
+typedef struct
+{
+    uint64_t counters[STAT_NUM_COUNTERS];
+    uint64_t phase_time[STATS_NUM_PHASES];
+    uint64_t run_start;
+} SchedStats;
+
+/* ========================================================================================*/
+#ifdef SCHED_STATS
+
+extern _Thread_local SchedStats sched_stats;
+
+uint64_t sched_stats_clock(void);
+void sched_stats_begin_run(void);
+void sched_stats_end_run(const SchedulerContext *ctx, const char *algorithm_name, FILE *report);
+
+#define STATS_COUNT(counter) (sched_stats.counters[(counter)]++)
+#define STATS_ADD(counter, amount) (sched_stats.counters[(counter)] += (uint64_t)(amount))
+#define STATS_PHASE_BEGIN(phase) uint64_t stats_start_##phase = sched_stats_clock()
+#define STATS_PHASE_END(phase) (sched_stats.phase_time[(phase)] += sched_stats_clock() - stats_start_##phase)
+#define STATS_RUN_BEGIN() sched_stats_begin_run()
+#define STATS_RUN_END(ctx, name) sched_stats_end_run((ctx), (name), stderr)
+
+#else
+
+#define STATS_COUNT(counter) ((void)0)
+#define STATS_ADD(counter, amount) ((void)0)
+#define STATS_PHASE_BEGIN(phase) ((void)0)
+#define STATS_PHASE_END(phase) ((void)0)
+#define STATS_RUN_BEGIN() ((void)0)
+#define STATS_RUN_END(ctx, name) ((void)0)
+
+#endif
+
+#endif // SCHED_STATS_H
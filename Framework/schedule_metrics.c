@@ -0,0 +1,230 @@
+/**
+ * ===============================================================================
+ * SCHEDULE METRICS
+ * ===============================================================================
+ * @file schedule_metrics.c
+ * @brief Fused turnaround / waiting time pass and tail percentiles
+ *
+ * FORMULAS (as per lecture slides):
+ * - Turnaround Time (TAT) = Completion Time - Arrival Time
+ * - Waiting Time (WT) = Turnaround Time - CPU Burst Time
+ * - Response Time = First Start Time - Arrival Time
+ * ===============================================================================
+ */
+
+#include "schedule_metrics.h"
+#include "thread_pool.h"
+
+/* ========================================================================================*/
+// Partial result of one chunk of the fused pass
+typedef struct
+{
+    long long total_turnaround;
+    long long total_waiting;
+    long long total_burst;
+    long long max_response;
+    int first_arrival;
+    long long last_completion;
+} MetricsPartial;
+
+// Shared state of a parallel fused pass
+typedef struct
+{
+    SchedulerContext *ctx;
+    MetricsPartial *partials;
+    int chunk_size;
+} MetricsPass;
+
+/* ========================================================================================*/
+/* FUSED PASS */
+/* ========================================================================================*/
+
+static void measure_range(Process *processes, int begin, int end, MetricsPartial *partial)
+{
+    long long total_turnaround = 0, total_waiting = 0, total_burst = 0;
+    long long max_response = 0, last_completion = LLONG_MIN;
+    int first_arrival = INT_MAX;
+
+    // Per-job times in 64 bits too: completions may lie past INT_MAX
+    for (int i = begin; i < end; i++)
+    {
+        Process *p = &processes[i];
+        long long turnaround = p->completion_time - p->arrival_time;
+        long long waiting = turnaround - p->burst_time;
+        long long response = p->start_time - p->arrival_time;
+
+        p->turnaround_time = turnaround;
+        p->waiting_time = waiting;
+        total_turnaround += turnaround;
+        total_waiting += waiting;
+        total_burst += p->burst_time;
+        max_response = (response > max_response) ? response : max_response;
+        first_arrival = (p->arrival_time < first_arrival) ? p->arrival_time : first_arrival;
+        last_completion = (p->completion_time > last_completion) ? p->completion_time : last_completion;
+    }
+
+    partial->total_turnaround = total_turnaround;
+    partial->total_waiting = total_waiting;
+    partial->total_burst = total_burst;
+    partial->max_response = max_response;
+    partial->first_arrival = first_arrival;
+    partial->last_completion = last_completion;
+}
+
+/* ========================================================================================*/
+
+static void measure_chunk(void *arg, int index, int worker)
+{
+    (void)worker;
+    MetricsPass *pass = arg;
+    int begin = index * pass->chunk_size;
+    int end = min_value(begin + pass->chunk_size, pass->ctx->num_processes);
+    measure_range(pass->ctx->processes, begin, end, &pass->partials[index]);
+}
+
+/* ========================================================================================*/
+/**
+ * Fills in turnaround_time / waiting_time of every process and computes the
+ * totals, averages, maximum response time and CPU utilization of the run in
+ * the same pass.
+ */
+void measure_schedule(SchedulerContext *ctx, ScheduleMetrics *metrics)
+{
+    memset(metrics, 0, sizeof(*metrics));
+    int n = ctx->num_processes;
+    if (n <= 0)
+    {
+        return;
+    }
+
+    MetricsPartial total;
+    if (ctx->num_threads > 1 && n >= METRICS_PARALLEL_MIN_PROCESSES)
+    {
+        // A few chunks per thread so uneven threads still balance
+        int num_chunks = ctx->num_threads * 4;
+        MetricsPass pass;
+        pass.ctx = ctx;
+        pass.chunk_size = (n + num_chunks - 1) / num_chunks;
+        num_chunks = (n + pass.chunk_size - 1) / pass.chunk_size;
+        pass.partials = scheduler_alloc((size_t)num_chunks, sizeof(MetricsPartial));
+
+        run_parallel_tasks(num_chunks, ctx->num_threads, measure_chunk, &pass);
+
+        total = pass.partials[0];
+        for (int c = 1; c < num_chunks; c++)
+        {
+            const MetricsPartial *part = &pass.partials[c];
+            total.total_turnaround += part->total_turnaround;
+            total.total_waiting += part->total_waiting;
+            total.total_burst += part->total_burst;
+            total.max_response = (part->max_response > total.max_response) ? part->max_response : total.max_response;
+            total.first_arrival = (part->first_arrival < total.first_arrival) ? part->first_arrival : total.first_arrival;
+            total.last_completion = (part->last_completion > total.last_completion) ? part->last_completion
+                                                                                  : total.last_completion;
+        }
+        free(pass.partials);
+    }
+    else
+    {
+        measure_range(ctx->processes, 0, n, &total);
+    }
+
+    metrics->total_turnaround = total.total_turnaround;
+    metrics->total_waiting = total.total_waiting;
+    metrics->avg_turnaround = (double)total.total_turnaround / n;
+    metrics->avg_waiting = (double)total.total_waiting / n;
+    metrics->max_response = total.max_response;
+
+    long long span = total.last_completion - total.first_arrival;
+    metrics->cpu_utilization = (span > 0) ? (double)total.total_burst / (double)span : 1.0;
+    metrics->num_switches = ctx->num_switches;
+    metrics->switch_overhead = ctx->switch_overhead;
+}
+
+/* ========================================================================================*/
+/* PERCENTILES */
+/* ========================================================================================*/
+
+/**
+ * Reorders values[lo .. hi] so values[nth] holds the element a full sort would
+ * put there, with nothing larger before it (Hoare-partition quickselect).
+ */
+static void select_nth(long long *values, int lo, int hi, int nth)
+{
+    while (lo < hi)
+    {
+        long long pivot = values[lo + (hi - lo) / 2];
+        int i = lo, j = hi;
+        while (i <= j)
+        {
+            while (values[i] < pivot)
+            {
+                i++;
+            }
+            while (values[j] > pivot)
+            {
+                j--;
+            }
+            if (i <= j)
+            {
+                long long tmp = values[i];
+                values[i++] = values[j];
+                values[j--] = tmp;
+            }
+        }
+
+        if (nth <= j)
+        {
+            hi = j;
+        }
+        else if (nth >= i)
+        {
+            lo = i;
+        }
+        else
+        {
+            return;
+        }
+    }
+}
+
+/* ========================================================================================*/
+
+// Index of the nearest-rank percentile in a sorted array of n values
+static int percentile_index(int n, int percent)
+{
+    long long rank = ((long long)n * percent + 99) / 100;
+    return (rank > 0) ? (int)rank - 1 : 0;
+}
+
+/* ========================================================================================*/
+/**
+ * Computes the p50 / p95 / p99 waiting times of the last run. Each selection
+ * only searches the prefix left of the previous, higher percentile.
+ */
+void measure_waiting_percentiles(const SchedulerContext *ctx, ScheduleMetrics *metrics)
+{
+    int n = ctx->num_processes;
+    if (n <= 0)
+    {
+        return;
+    }
+
+    long long *waiting = scheduler_alloc((size_t)n, sizeof(long long));
+    for (int i = 0; i < n; i++)
+    {
+        waiting[i] = ctx->processes[i].waiting_time;
+    }
+
+    int p99 = percentile_index(n, 99);
+    int p95 = percentile_index(n, 95);
+    int p50 = percentile_index(n, 50);
+    select_nth(waiting, 0, n - 1, p99);
+    select_nth(waiting, 0, p99, p95);
+    select_nth(waiting, 0, p95, p50);
+
+    metrics->waiting_p99 = waiting[p99];
+    metrics->waiting_p95 = waiting[p95];
+    metrics->waiting_p50 = waiting[p50];
+    free(waiting);
+}
@@ -0,0 +1,49 @@
+/*
+ * ===============================================================================
+ * SCHEDULE METRICS HEADER FILE
+ * ===============================================================================
+ *
+ * Per-run metrics computed after an algorithm has filled in completion_time
+ * and start_time:
+ *
+ * - measure_schedule() fuses the per-process Turnaround / Waiting Time
+ *   computation with 64-bit totals, the maximum response time and the CPU
+ *   utilization in one pass, split across ctx->num_threads workers for large
+ *   workloads; it also copies the context switch counters of the run
+ * - measure_waiting_percentiles() finds the p50 / p95 / p99 waiting times
+ *   (nearest rank) with quickselect instead of a full sort
+ *
+ * ===============================================================================
+ */
+
+#ifndef SCHEDULE_METRICS_H
+#define SCHEDULE_METRICS_H
+
+#include "CPU_scheduler.h"
+
+// Smallest workload whose metrics pass is split across threads
+#define METRICS_PARALLEL_MIN_PROCESSES (1 << 16)
+
+/* ========================================================================================*/
+// Structure to hold the metrics of one run
+typedef struct ScheduleMetrics
+{
+    long long total_turnaround;
+    long long total_waiting;
+    double avg_turnaround;
+    double avg_waiting;
+    long long max_response; // Largest start_time - arrival_time
+    double cpu_utilization; // Burst time / (last completion - first arrival)
+    long long num_switches;     // Copied from the context (see charge_context_switch)
+    long long switch_overhead;
+    long long waiting_p50;  // Filled in by measure_waiting_percentiles()
+    long long waiting_p95;
+    long long waiting_p99;
+} ScheduleMetrics;
+
+/* ========================================================================================*/
+// Metrics function prototypes
+void measure_schedule(SchedulerContext *ctx, ScheduleMetrics *metrics);
+void measure_waiting_percentiles(const SchedulerContext *ctx, ScheduleMetrics *metrics);
+
+#endif // SCHEDULE_METRICS_H
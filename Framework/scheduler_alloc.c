@@ -0,0 +1,98 @@
+/**
+ * ===============================================================================
+ * CPU SCHEDULER - ALLOCATION
+ * ===============================================================================
+ * @file scheduler_alloc.c
+ * @brief Allocators of the driver, for which running out of memory is fatal
+ *
+ * The ready heap, ring queue and priority buckets are shared with the
+ * scheduling library (see sched_library.h), so their own translation units
+ * only report allocation failure (the try_ functions). The fatal forms the
+ * engines call live here, next to scheduler_alloc(), and the library links
+ * neither this file nor scheduler_core.c.
+ * ===============================================================================
+ */
+
+#include "CPU_scheduler.h"
+#include "ready_heap.h"
+#include "ring_queue.h"
+#include "priority_buckets.h"
+
+/* ========================================================================================*/
+
+static void out_of_memory(void)
+{
+    fprintf(stderr, "Error: Out of memory.\n");
+    exit(EXIT_FAILURE);
+}
+
+/* ========================================================================================*/
+
+void *scheduler_alloc(size_t count, size_t size)
+{
+    // Scratch arrays are sized by the workload, so allocation failure is fatal
+    void *ptr = calloc(count > 0 ? count : 1, size);
+    if (ptr == NULL)
+    {
+        out_of_memory();
+    }
+    return ptr;
+}
+
+/* ========================================================================================*/
+/* DATA STRUCTURES */
+/* ========================================================================================*/
+
+void ready_heap_init(ReadyHeap *heap, int capacity)
+{
+    if (!ready_heap_try_init(heap, capacity))
+    {
+        out_of_memory();
+    }
+}
+
+void ready_heap_reserve(ReadyHeap *heap, int capacity)
+{
+    if (!ready_heap_try_reserve(heap, capacity))
+    {
+        out_of_memory();
+    }
+}
+
+/* ========================================================================================*/
+
+void ring_queue_init(RingQueue *queue, int initial_capacity)
+{
+    if (!ring_queue_try_init(queue, initial_capacity))
+    {
+        out_of_memory();
+    }
+}
+
+void ring_queue_push(RingQueue *queue, int value)
+{
+    if (!ring_queue_try_push(queue, value))
+    {
+        out_of_memory();
+    }
+}
+
+/* ========================================================================================*/
+
+void priority_buckets_init(PriorityBuckets *buckets, int num_levels, int num_processes)
+{
+    if (!priority_buckets_try_init(buckets, num_levels, num_processes))
+    {
+        out_of_memory();
+    }
+}
+
+int *priority_buckets_map_levels(const int *priorities, int n, int *num_levels)
+{
+    int *levels = priority_buckets_try_map_levels(priorities, n, num_levels);
+    if (levels == NULL)
+    {
+        out_of_memory();
+    }
+    return levels;
+}
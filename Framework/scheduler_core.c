@@ -0,0 +1,656 @@
+/**
+ * ===============================================================================
+ * CPU SCHEDULER - CORE UTILITIES
+ * ===============================================================================
+ * @file scheduler_core.c
+ * @brief Context management, input loading and result reporting
+ *
+ * Everything a front end needs around the scheduling engines: creating and
+ * cloning contexts, reading and validating workloads, the arrival order and
+ * display_results(). The scheduler driver and the benchmark link against it.
+ * ===============================================================================
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "CPU_scheduler.h"
+#include "scheduler_scratch.h"
+#include "workload_reader.h"
+#include "workload_binary.h"
+#include "schedule_metrics.h"
+#include "result_writer.h"
+#include "sched_stats.h"
+
+/* ========================================================================================*/
+/* CORE UTILITY FUNCTIONS */
+/* ========================================================================================*/
+
+void init_scheduler_context(SchedulerContext *ctx)
+{
+    ctx->processes = NULL;
+    ctx->num_processes = 0;
+    ctx->capacity = 0;
+    ctx->arrival_order = NULL;
+    ctx->mapped_input = NULL;
+    ctx->rows_pending = false;
+    ctx->output = stdout;
+    ctx->scratch = NULL;
+    ctx->num_threads = 1;
+    ctx->report_flags = 0;
+    ctx->output_format = RESULT_FORMAT_TEXT;
+    ctx->trace = NULL;
+    ctx->switch_cost = 0;
+    ctx->warmup_cost = 0;
+    ctx->num_switches = 0;
+    ctx->switch_overhead = 0;
+    ctx->report_buffer = NULL;
+    ctx->output_failed = false;
+    ctx->last_metrics = NULL;
+}
+
+/* ========================================================================================*/
+
+void free_scheduler_context(SchedulerContext *ctx)
+{
+    release_mapped_input(ctx);
+    free(ctx->report_buffer);
+    free(ctx->processes);
+    free(ctx->arrival_order);
+    init_scheduler_context(ctx);
+}
+
+/* ========================================================================================*/
+/**
+ * Deep-copies the workload (and its cached arrival index) of src into dst so an
+ * algorithm can run on dst without touching src. Output goes to src's stream with
+ * src's report options; the clone's metrics pass is serial.
+ */
+bool clone_scheduler_context(SchedulerContext *dst, const SchedulerContext *src)
+{
+    init_scheduler_context(dst);
+    dst->output = src->output;
+    dst->report_flags = src->report_flags;
+    dst->output_format = src->output_format;
+    dst->switch_cost = src->switch_cost;
+    dst->warmup_cost = src->warmup_cost;
+    if (src->num_processes == 0)
+    {
+        return true;
+    }
+
+    if (!reserve_process_capacity(dst, src->num_processes))
+    {
+        return false;
+    }
+    if (src->rows_pending)
+    {
+        // The mapping is read-only, so clones fill their rows from it directly
+        fill_mapped_rows(src->mapped_input, dst->processes, src->num_processes);
+    }
+    else
+    {
+        memcpy(dst->processes, src->processes, (size_t)src->num_processes * sizeof(Process));
+    }
+    dst->num_processes = src->num_processes;
+
+    if (src->arrival_order != NULL)
+    {
+        dst->arrival_order = malloc((size_t)src->num_processes * sizeof(int));
+        if (dst->arrival_order == NULL)
+        {
+            free_scheduler_context(dst);
+            return false;
+        }
+        memcpy(dst->arrival_order, src->arrival_order, (size_t)src->num_processes * sizeof(int));
+    }
+    return true;
+}
+
+/* ========================================================================================*/
+
+
+bool reserve_process_capacity(SchedulerContext *ctx, int capacity)
+{
+    if (capacity <= ctx->capacity)
+    {
+        return true;
+    }
+
+    Process *grown = realloc(ctx->processes, (size_t)capacity * sizeof(Process));
+    if (grown == NULL)
+    {
+        return false;
+    }
+
+    memset(grown + ctx->capacity, 0, (size_t)(capacity - ctx->capacity) * sizeof(Process));
+    ctx->processes = grown;
+    ctx->capacity = capacity;
+    return true;
+}
+
+/* ========================================================================================*/
+
+Process *append_process(SchedulerContext *ctx)
+{
+    // Rows added to a mapped workload make the rows the input
+    materialize_process_rows(ctx);
+    release_mapped_input(ctx);
+
+    if (ctx->num_processes == ctx->capacity)
+    {
+        // Amortized doubling keeps appends O(1) on average
+        int new_capacity = INITIAL_PROCESS_CAPACITY;
+        if (ctx->capacity > 0)
+        {
+            if (ctx->capacity > INT_MAX / 2)
+            {
+                return NULL;
+            }
+            new_capacity = ctx->capacity * 2;
+        }
+        if (!reserve_process_capacity(ctx, new_capacity))
+        {
+            return NULL;
+        }
+    }
+
+    // The workload changed, so any cached arrival index is stale
+    free(ctx->arrival_order);
+    ctx->arrival_order = NULL;
+
+    Process *p = &ctx->processes[ctx->num_processes++];
+    memset(p, 0, sizeof(*p));
+    return p;
+}
+
+/* ========================================================================================*/
+
+void reset_process_states(SchedulerContext *ctx)
+{
+    materialize_process_rows(ctx);
+    for (int i = 0; i < ctx->num_processes; i++)
+    {
+        ctx->processes[i].remaining_time = ctx->processes[i].burst_time;
+        ctx->processes[i].waiting_time = 0;
+        ctx->processes[i].turnaround_time = 0;
+        ctx->processes[i].completion_time = 0;
+        ctx->processes[i].start_time = -1;
+        ctx->processes[i].is_completed = false;
+    }
+    ctx->num_switches = 0;
+    ctx->switch_overhead = 0;
+}
+
+/* ========================================================================================*/
+
+// Input fields of the workload: row i at pid[i * stride] etc. Reads the
+// mapped file columns while the rows are pending, so loading does not copy them
+typedef struct
+{
+    const int *pid;
+    const int *arrival_time;
+    const int *burst_time;
+    const int *priority;
+    size_t stride;
+} InputFields;
+
+static InputFields input_fields(const SchedulerContext *ctx)
+{
+    if (ctx->rows_pending)
+    {
+        const MappedWorkload *map = ctx->mapped_input;
+        return (InputFields){map->columns[WORKLOAD_COLUMN_PID], map->columns[WORKLOAD_COLUMN_ARRIVAL_TIME],
+                             map->columns[WORKLOAD_COLUMN_BURST_TIME], map->columns[WORKLOAD_COLUMN_PRIORITY], 1};
+    }
+    const Process *rows = ctx->processes;
+    return (InputFields){&rows->pid, &rows->arrival_time, &rows->burst_time, &rows->priority,
+                         sizeof(Process) / sizeof(int)};
+}
+
+/* ========================================================================================*/
+
+// Number of offending rows listed before validation only counts them
+#define MAX_REPORTED_ROWS 10
+
+static void report_invalid_row(int *num_invalid, int row, const char *format, int value)
+{
+    if (++*num_invalid <= MAX_REPORTED_ROWS)
+    {
+        fprintf(stderr, "Error: Row %d: ", row);
+        fprintf(stderr, format, value);
+        fputc('\n', stderr);
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Checks every row in a single pass: positive burst, non-negative arrival and
+ * priority, and unique PIDs. Duplicates are found with an open-addressing hash
+ * set of row indices, so validation is linear in the number of processes.
+ * Offending rows (1-based, in input order) are listed on stderr.
+ */
+bool validate_input_data(const SchedulerContext *ctx)
+{
+    if (ctx->num_processes <= 0)
+    {
+        return false;
+    }
+
+    // Power-of-two table at most half full; slots hold row index + 1, 0 = empty
+    int table_bits = 4;
+    while (((size_t)1 << table_bits) < (size_t)ctx->num_processes * 2)
+    {
+        table_bits++;
+    }
+    size_t table_size = (size_t)1 << table_bits;
+    size_t mask = table_size - 1;
+    int *slots = scheduler_alloc(table_size, sizeof(int));
+
+    InputFields fields = input_fields(ctx);
+    int num_invalid = 0;
+    for (int i = 0; i < ctx->num_processes; i++)
+    {
+        size_t at = (size_t)i * fields.stride;
+        int pid = fields.pid[at];
+        if (fields.burst_time[at] <= 0)
+        {
+            report_invalid_row(&num_invalid, i + 1, "burst time %d must be positive", fields.burst_time[at]);
+        }
+        if (fields.arrival_time[at] < 0)
+        {
+            report_invalid_row(&num_invalid, i + 1, "arrival time %d must not be negative", fields.arrival_time[at]);
+        }
+        if (fields.priority[at] < 0)
+        {
+            report_invalid_row(&num_invalid, i + 1, "priority %d must not be negative", fields.priority[at]);
+        }
+
+        // Check for duplicate PIDs (Fibonacci hashing, linear probing)
+        size_t slot = (size_t)(((uint64_t)(uint32_t)pid * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - table_bits));
+        while (slots[slot] != 0 && fields.pid[(size_t)(slots[slot] - 1) * fields.stride] != pid)
+        {
+            slot = (slot + 1) & mask;
+        }
+        if (slots[slot] != 0)
+        {
+            report_invalid_row(&num_invalid, i + 1, "duplicate PID %d", pid);
+        }
+        else
+        {
+            slots[slot] = i + 1;
+        }
+    }
+    free(slots);
+
+    if (num_invalid > MAX_REPORTED_ROWS)
+    {
+        fprintf(stderr, "Error: ... %d more invalid rows.\n", num_invalid - MAX_REPORTED_ROWS);
+    }
+    if (num_invalid == 0 && schedule_horizon(ctx, (long long)ctx->switch_cost + ctx->warmup_cost) == LLONG_MAX)
+    {
+        fprintf(stderr, "Error: The schedule could run past the 64-bit clock (last arrival + total burst + "
+                        "switch costs).\n");
+        return false;
+    }
+    return num_invalid == 0;
+}
+
+/* ========================================================================================*/
+/**
+ * Upper bound on the time any engine can reach on ctx: the last arrival plus
+ * every burst, plus cost_per_switch for each of at most Σ burst + 2n switches
+ * (a dispatch runs at least one unit unless an arrival cut it short).
+ * Saturates at LLONG_MAX. Fits in 64 bits without costs, since n and every
+ * field are ints.
+ */
+long long schedule_horizon(const SchedulerContext *ctx, long long cost_per_switch)
+{
+    long long last_arrival = 0;
+    long long total_burst = 0;
+    if (ctx->num_processes > 0)
+    {
+        InputFields fields = input_fields(ctx);
+        for (int i = 0; i < ctx->num_processes; i++)
+        {
+            int arrival_time = fields.arrival_time[(size_t)i * fields.stride];
+            int burst_time = fields.burst_time[(size_t)i * fields.stride];
+            last_arrival = (arrival_time > last_arrival) ? arrival_time : last_arrival;
+            total_burst += (burst_time > 0) ? burst_time : 0;
+        }
+    }
+
+    long long horizon = last_arrival + total_burst;
+    long long max_switches = total_burst + 2LL * ctx->num_processes;
+    if (cost_per_switch > 0 && max_switches > (LLONG_MAX - horizon) / cost_per_switch)
+    {
+        return LLONG_MAX;
+    }
+    return horizon + max_switches * cost_per_switch;
+}
+
+/* ========================================================================================*/
+
+// Maps a signed value onto an unsigned key with the same ordering
+static uint64_t order_preserving_key(int value)
+{
+    return (uint64_t)((uint32_t)value ^ UINT32_C(0x80000000));
+}
+
+/**
+ * Stable LSD radix sort of the (arrival_time, pid) keys, 8 bits per pass.
+ * Passes where every key shares the same digit are skipped, so small arrival
+ * and PID ranges cost only a few passes.
+ */
+static void radix_sort_arrival_keys(uint64_t *keys, int *order, int n)
+{
+    uint64_t *src_keys = keys;
+    int *src_order = order;
+    uint64_t *dst_keys = scheduler_alloc((size_t)n, sizeof(uint64_t));
+    int *dst_order = scheduler_alloc((size_t)n, sizeof(int));
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        size_t counts[257] = {0};
+        for (int i = 0; i < n; i++)
+        {
+            counts[((src_keys[i] >> shift) & 0xFF) + 1]++;
+        }
+        if (counts[((src_keys[0] >> shift) & 0xFF) + 1] == (size_t)n)
+        {
+            continue;
+        }
+        for (int d = 0; d < 256; d++)
+        {
+            counts[d + 1] += counts[d];
+        }
+        for (int i = 0; i < n; i++)
+        {
+            size_t slot = counts[(src_keys[i] >> shift) & 0xFF]++;
+            dst_keys[slot] = src_keys[i];
+            dst_order[slot] = src_order[i];
+        }
+
+        uint64_t *key_swap = src_keys;
+        src_keys = dst_keys;
+        dst_keys = key_swap;
+        int *order_swap = src_order;
+        src_order = dst_order;
+        dst_order = order_swap;
+    }
+
+    // An odd number of passes leaves the result in the scratch buffers
+    if (src_order != order)
+    {
+        memcpy(order, src_order, (size_t)n * sizeof(int));
+        free(src_keys);
+        free(src_order);
+    }
+    else
+    {
+        free(dst_keys);
+        free(dst_order);
+    }
+}
+
+/**
+ * Returns the indices of ctx->processes ordered by arrival time, then PID.
+ *
+ * The index is built once per loaded workload (on first use) and cached in the
+ * context. All schedulers read it without modifying it, and ctx->processes is
+ * never reordered. Call it once before sharing the context between threads.
+ */
+const int *get_arrival_order(SchedulerContext *ctx)
+{
+    if (ctx->arrival_order != NULL || ctx->num_processes <= 0)
+    {
+        return ctx->arrival_order;
+    }
+
+    int n = ctx->num_processes;
+    uint64_t *keys = scheduler_alloc((size_t)n, sizeof(uint64_t));
+    int *order = scheduler_alloc((size_t)n, sizeof(int));
+
+    InputFields fields = input_fields(ctx);
+    for (int i = 0; i < n; i++)
+    {
+        keys[i] = (order_preserving_key(fields.arrival_time[(size_t)i * fields.stride]) << 32) |
+                  order_preserving_key(fields.pid[(size_t)i * fields.stride]);
+        order[i] = i;
+    }
+
+    radix_sort_arrival_keys(keys, order, n);
+
+    free(keys);
+    ctx->arrival_order = order;
+    return order;
+}
+
+/* ========================================================================================*/
+
+void clear_input_buffer(void)
+{
+    int c;
+    while ((c = getchar()) != '\n' && c != EOF)
+        ;
+}
+
+/* ========================================================================================*/
+
+int min_value(int a, int b)
+{
+    return (a < b) ? a : b;
+}
+
+/* ========================================================================================*/
+/**
+ * Accounts one context switch and returns the time it costs: switch_cost, plus
+ * warmup_cost when the incoming process has run before (resumed). Engines call
+ * it whenever the CPU is given to a process other than the one that ran last,
+ * and start the process that much later.
+ */
+int charge_context_switch(SchedulerContext *ctx, bool resumed)
+{
+    int cost = ctx->switch_cost + (resumed ? ctx->warmup_cost : 0);
+    ctx->num_switches++;
+    ctx->switch_overhead += cost;
+    return cost;
+}
+
+/* ========================================================================================*/
+
+/**
+ * Reads a text workload from fd with the block-buffered parser (see workload_reader.h).
+ * Malformed rows are reported with their line number and abort the load.
+ */
+static bool read_text_workload(int fd, SchedulerContext *ctx)
+{
+    ProcessReader reader;
+    process_reader_init(&reader, fd);
+
+    ReaderStatus status;
+    Process row;
+    while ((status = process_reader_next(&reader, &row)) == READER_ROW)
+    {
+        // Store the process data
+        Process *p = append_process(ctx);
+        if (p == NULL)
+        {
+            fprintf(stderr, "Error: Out of memory after %d processes.\n", ctx->num_processes);
+            status = READER_ERROR;
+            break;
+        }
+        *p = row;
+    }
+    process_reader_free(&reader);
+
+    return status != READER_ERROR;
+}
+
+/* ========================================================================================*/
+
+// Validation step shared by both readers, timed as its own phase
+static bool validate_loaded_workload(SchedulerContext *ctx)
+{
+    STATS_PHASE_BEGIN(STATS_PHASE_VALIDATE);
+    bool valid = validate_input_data(ctx);
+    STATS_PHASE_END(STATS_PHASE_VALIDATE);
+    return valid;
+}
+
+/* ========================================================================================*/
+
+bool read_processes_from_stdin(SchedulerContext *ctx)
+{
+    STATS_PHASE_BEGIN(STATS_PHASE_LOAD);
+    bool ok = read_text_workload(STDIN_FILENO, ctx);
+    STATS_PHASE_END(STATS_PHASE_LOAD);
+    if (!ok || ctx->num_processes == 0)
+    {
+        return false;
+    }
+
+    return validate_loaded_workload(ctx);
+}
+
+/* ========================================================================================*/
+/**
+ * Reads a workload file in either format: files starting with WORKLOAD_MAGIC are
+ * memory-mapped (see workload_binary.h), anything else is parsed as text.
+ */
+bool read_processes_from_file(const char *filename, SchedulerContext *ctx)
+{
+    STATS_PHASE_BEGIN(STATS_PHASE_LOAD);
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        STATS_PHASE_END(STATS_PHASE_LOAD);
+        fprintf(stderr, "Error: Cannot open '%s': %s.\n", filename, strerror(errno));
+        return false;
+    }
+
+    char magic[WORKLOAD_MAGIC_SIZE];
+    ssize_t got = pread(fd, magic, sizeof(magic), 0);
+    bool ok;
+    if (got > 0 && is_workload_magic(magic, (size_t)got))
+    {
+        MappedWorkload map;
+        ok = map_workload_file(fd, &map);
+        if (ok)
+        {
+            ok = load_mapped_workload(&map, ctx);
+            unmap_workload_file(&map);
+        }
+    }
+    else
+    {
+        ok = read_text_workload(fd, ctx);
+    }
+    close(fd);
+    STATS_PHASE_END(STATS_PHASE_LOAD);
+
+    if (!ok || ctx->num_processes == 0)
+    {
+        return false;
+    }
+
+    return validate_loaded_workload(ctx);
+}
+
+/* ========================================================================================*/
+/**
+ * Computing Turnaround Time and Waiting Time for all processes
+ * 
+ * FORMULAS (as per lecture slides):
+ * - Turnaround Time (TAT) = Completion Time - Arrival Time
+ * - Waiting Time (WT) = Turnaround Time - CPU Burst Time
+ *
+ * The per-process times are filled in by the fused metrics pass (see schedule_metrics.h).
+ */
+void calculate_turnaround_times(SchedulerContext *ctx)
+{
+    ScheduleMetrics metrics;
+    measure_schedule(ctx, &metrics);
+}
+
+/* ========================================================================================*/
+
+void compute_average_times(const SchedulerContext *ctx, double *avg_turnaround, double *avg_waiting)
+{
+    // 64-bit totals: int sums overflow on large traces
+    long long total_waiting_time = 0, total_turnaround_time = 0;
+
+    for (int i = 0; i < ctx->num_processes; i++)
+    {
+        total_waiting_time += ctx->processes[i].waiting_time;
+        total_turnaround_time += ctx->processes[i].turnaround_time;
+    }
+
+    *avg_turnaround = (double)total_turnaround_time / ctx->num_processes;
+    *avg_waiting = (double)total_waiting_time / ctx->num_processes;
+}
+
+/* ========================================================================================*/
+
+static void print_average_times(FILE *output, double avg_turnaround, double avg_waiting)
+{
+    fprintf(output, "Average Turnaround Time: %.2f\nAverage Waiting Time: %.2f\n", avg_turnaround, avg_waiting);
+}
+
+/* ========================================================================================*/
+
+void calculate_average_times(const SchedulerContext *ctx)
+{
+    double avg_turnaround, avg_waiting;
+    compute_average_times(ctx, &avg_turnaround, &avg_waiting);
+    print_average_times(ctx->output, avg_turnaround, avg_waiting);
+}
+
+/* ========================================================================================*/
+/**
+ * Reports the last run of ctx under algorithm_name. Returns false, and sets
+ * ctx->output_failed for the front end, if the report could not be written.
+ * The formatting buffer is kept in ctx for the next report.
+ */
+bool display_results(SchedulerContext *ctx, const char *algorithm_name)
+{
+    STATS_PHASE_BEGIN(STATS_PHASE_OUTPUT);
+    ScheduleMetrics metrics;
+    measure_schedule(ctx, &metrics);
+    if (ctx->last_metrics != NULL)
+    {
+        *ctx->last_metrics = metrics;
+    }
+
+    // Quiet runs (e.g. quantum sweeps) only need the computed times
+    if (ctx->output == NULL)
+    {
+        STATS_PHASE_END(STATS_PHASE_OUTPUT);
+        return true;
+    }
+
+    if (ctx->report_flags & REPORT_TAIL_METRICS)
+    {
+        measure_waiting_percentiles(ctx, &metrics);
+    }
+
+    int num_records = (ctx->report_flags & REPORT_SUMMARY_ONLY) ? 0 : ctx->num_processes;
+    if (ctx->report_buffer == NULL)
+    {
+        ctx->report_buffer = scheduler_alloc(RESULT_WRITER_BUFFER_SIZE, 1);
+    }
+
+    ResultWriter writer;
+    result_writer_init(&writer, ctx->output, ctx->output_format, ctx->report_buffer);
+    result_writer_begin(&writer, algorithm_name, &metrics, ctx->num_processes, num_records);
+    for (int i = 0; i < num_records; i++)
+    {
+        const Process *p = &ctx->processes[i];
+        result_writer_row(&writer, p->pid, p->completion_time, p->turnaround_time, p->waiting_time);
+    }
+    result_writer_summary(&writer, &metrics, ctx->num_processes, ctx->report_flags);
+    bool written = result_writer_finish(&writer);
+    ctx->output_failed |= !written;
+    STATS_PHASE_END(STATS_PHASE_OUTPUT);
+    return written;
+}
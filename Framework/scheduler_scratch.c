@@ -0,0 +1,228 @@
+/**
+ * ===============================================================================
+ * SCHEDULER SCRATCH STATE
+ * ===============================================================================
+ * @file scheduler_scratch.c
+ * @brief Reusable engine buffers for repeated runs on one workload
+ *
+ * acquire_* hands out the scratch-owned structure (cleared) when the context has
+ * scratch attached, or initializes the caller's local one otherwise. release_*
+ * frees only what acquire_* allocated locally.
+ * ===============================================================================
+ */
+
+#include "scheduler_scratch.h"
+
+/* ========================================================================================*/
+
+void init_scheduler_scratch(SchedulerScratch *scratch)
+{
+    memset(scratch, 0, sizeof(*scratch));
+    scratch_arena_init(&scratch->arena);
+}
+
+/* ========================================================================================*/
+
+void free_scheduler_scratch(SchedulerScratch *scratch)
+{
+    if (scratch->has_ready_queue)
+    {
+        ring_queue_free(&scratch->ready_queue);
+    }
+    if (scratch->has_buckets)
+    {
+        priority_buckets_free(&scratch->buckets);
+    }
+    if (scratch->has_columns)
+    {
+        process_columns_free(&scratch->columns);
+    }
+    free(scratch->levels);
+    scratch_arena_free(&scratch->arena);
+    init_scheduler_scratch(scratch);
+}
+
+/* ========================================================================================*/
+/**
+ * Starts a new run: everything handed out by scratch_alloc() and
+ * acquire_ready_heap() since the last reset becomes invalid. Workload state is
+ * kept.
+ */
+void reset_scheduler_scratch(SchedulerScratch *scratch)
+{
+    scratch_arena_reset(&scratch->arena);
+}
+
+/* ========================================================================================*/
+/**
+ * Zeroed per-run array: from the arena when ctx has scratch attached,
+ * scheduler_alloc() otherwise. Pair with scratch_release().
+ */
+void *scratch_alloc(SchedulerContext *ctx, size_t count, size_t size)
+{
+    if (ctx->scratch == NULL)
+    {
+        return scheduler_alloc(count, size);
+    }
+    return scratch_arena_alloc(&ctx->scratch->arena, count, size);
+}
+
+/* ========================================================================================*/
+
+void scratch_release(SchedulerContext *ctx, void *ptr)
+{
+    if (ctx->scratch == NULL)
+    {
+        free(ptr);
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Initializes local as an empty heap for indices 0 .. capacity - 1. With
+ * scratch attached its arrays come from the arena, so the heap must not be
+ * grown with ready_heap_reserve().
+ */
+ReadyHeap *acquire_ready_heap(SchedulerContext *ctx, ReadyHeap *local, int capacity)
+{
+    if (ctx->scratch == NULL)
+    {
+        ready_heap_init(local, capacity);
+        return local;
+    }
+
+    capacity = (capacity > 0) ? capacity : 1;
+    local->entries = scratch_arena_alloc(&ctx->scratch->arena, (size_t)capacity, sizeof(ReadyEntry));
+    local->position = scratch_arena_alloc(&ctx->scratch->arena, (size_t)capacity, sizeof(int));
+    for (int i = 0; i < capacity; i++)
+    {
+        local->position[i] = -1;
+    }
+    local->size = 0;
+    local->capacity = capacity;
+    return local;
+}
+
+/* ========================================================================================*/
+
+void release_ready_heap(SchedulerContext *ctx, ReadyHeap *heap)
+{
+    if (ctx->scratch == NULL)
+    {
+        ready_heap_free(heap);
+    }
+}
+
+/* ========================================================================================*/
+
+RingQueue *acquire_ready_queue(SchedulerContext *ctx, RingQueue *local)
+{
+    SchedulerScratch *scratch = ctx->scratch;
+    if (scratch == NULL)
+    {
+        ring_queue_init(local, RING_QUEUE_MIN_CAPACITY);
+        return local;
+    }
+
+    if (!scratch->has_ready_queue)
+    {
+        ring_queue_init(&scratch->ready_queue, RING_QUEUE_MIN_CAPACITY);
+        scratch->has_ready_queue = true;
+    }
+    ring_queue_clear(&scratch->ready_queue);
+    return &scratch->ready_queue;
+}
+
+/* ========================================================================================*/
+
+void release_ready_queue(SchedulerContext *ctx, RingQueue *queue)
+{
+    if (ctx->scratch == NULL)
+    {
+        ring_queue_free(queue);
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Returns the rank-ordered columns of ctx with the per-run state reset. The
+ * input columns only depend on the workload, so scratch gathers them once.
+ */
+ProcessColumns *acquire_process_columns(SchedulerContext *ctx, ProcessColumns *local)
+{
+    SchedulerScratch *scratch = ctx->scratch;
+    if (scratch == NULL)
+    {
+        process_columns_build(local, ctx);
+        return local;
+    }
+
+    if (!scratch->has_columns)
+    {
+        process_columns_build(&scratch->columns, ctx);
+        scratch->has_columns = true;
+    }
+    else
+    {
+        // Clones of one workload may share a scratch; the ranks are identical
+        scratch->columns.order = get_arrival_order(ctx);
+        process_columns_reset(&scratch->columns);
+    }
+    return &scratch->columns;
+}
+
+/* ========================================================================================*/
+
+void release_process_columns(SchedulerContext *ctx, ProcessColumns *columns)
+{
+    if (ctx->scratch == NULL)
+    {
+        process_columns_free(columns);
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Returns empty priority buckets sized for ctx and the dense level of every
+ * process by arrival rank (see priority_buckets_map_levels) in *levels.
+ */
+PriorityBuckets *acquire_priority_buckets(SchedulerContext *ctx, const ProcessColumns *columns,
+                                          PriorityBuckets *local, int **levels)
+{
+    SchedulerScratch *scratch = ctx->scratch;
+    int num_levels = 0;
+
+    if (scratch == NULL)
+    {
+        *levels = priority_buckets_map_levels(columns->priority, columns->num_processes, &num_levels);
+        priority_buckets_init(local, num_levels, ctx->num_processes);
+        return local;
+    }
+
+    // The level map only depends on the workload, so it is built once
+    if (scratch->levels == NULL)
+    {
+        scratch->levels = priority_buckets_map_levels(columns->priority, columns->num_processes,
+                                                      &scratch->num_levels);
+    }
+    if (!scratch->has_buckets)
+    {
+        priority_buckets_init(&scratch->buckets, scratch->num_levels, ctx->num_processes);
+        scratch->has_buckets = true;
+    }
+    priority_buckets_clear(&scratch->buckets);
+
+    *levels = scratch->levels;
+    return &scratch->buckets;
+}
+
+/* ========================================================================================*/
+
+void release_priority_buckets(SchedulerContext *ctx, PriorityBuckets *buckets, int *levels)
+{
+    if (ctx->scratch == NULL)
+    {
+        priority_buckets_free(buckets);
+        free(levels);
+    }
+}
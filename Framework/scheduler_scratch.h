@@ -0,0 +1,67 @@
+/*
+ * ===============================================================================
+ * SCHEDULER SCRATCH STATE HEADER FILE
+ * ===============================================================================
+ *
+ * Per-thread scratch buffers that the engines reuse across runs on the same
+ * workload (e.g. one run per quantum during a sweep). When a context has no
+ * scratch attached, the engines allocate and free their own.
+ *
+ * Two kinds of state live here:
+ *
+ * - workload state (columns, level map), built by the first run and kept
+ * - per-run arrays (ready heaps, SMP tables), carved from the arena and
+ *   reclaimed by reset_scheduler_scratch(), which runners call before every
+ *   run; in steady state a run makes no allocator calls
+ *
+ * ===============================================================================
+ */
+
+#ifndef SCHEDULER_SCRATCH_H
+#define SCHEDULER_SCRATCH_H
+
+#include "CPU_scheduler.h"
+#include "ring_queue.h"
+#include "priority_buckets.h"
+#include "process_columns.h"
+#include "ready_heap.h"
+#include "scratch_arena.h"
+
+/* ========================================================================================*/
+// Scratch state kept between runs; valid only for the workload it was built on
+struct SchedulerScratch
+{
+    RingQueue ready_queue;      // Round Robin ready queue
+    bool has_ready_queue;
+    PriorityBuckets buckets;    // Priority RR ready structure
+    bool has_buckets;
+    int *levels;                // Dense priority level by arrival rank
+    int num_levels;
+    ProcessColumns columns;     // Rank-ordered process columns
+    bool has_columns;
+    ScratchArena arena;         // Per-run arrays, reset between runs
+};
+
+/* ========================================================================================*/
+// Scratch function prototypes
+void init_scheduler_scratch(SchedulerScratch *scratch);
+void free_scheduler_scratch(SchedulerScratch *scratch);
+void reset_scheduler_scratch(SchedulerScratch *scratch);
+
+void *scratch_alloc(SchedulerContext *ctx, size_t count, size_t size);
+void scratch_release(SchedulerContext *ctx, void *ptr);
+
+ReadyHeap *acquire_ready_heap(SchedulerContext *ctx, ReadyHeap *local, int capacity);
+void release_ready_heap(SchedulerContext *ctx, ReadyHeap *heap);
+
+RingQueue *acquire_ready_queue(SchedulerContext *ctx, RingQueue *local);
+void release_ready_queue(SchedulerContext *ctx, RingQueue *queue);
+
+ProcessColumns *acquire_process_columns(SchedulerContext *ctx, ProcessColumns *local);
+void release_process_columns(SchedulerContext *ctx, ProcessColumns *columns);
+
+PriorityBuckets *acquire_priority_buckets(SchedulerContext *ctx, const ProcessColumns *columns,
+                                          PriorityBuckets *local, int **levels);
+void release_priority_buckets(SchedulerContext *ctx, PriorityBuckets *buckets, int *levels);
+
+#endif // SCHEDULER_SCRATCH_H
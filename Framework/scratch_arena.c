@@ -0,0 +1,126 @@
+/**
+ * ===============================================================================
+ * SCRATCH ARENA
+ * ===============================================================================
+ * @file scratch_arena.c
+ * @brief Block-chained bump allocator with whole-arena reset
+ *
+ * Every allocation is rounded up to the alignment of max_align_t, so any
+ * scalar type can be carved from it. Like scheduler_alloc(), memory comes back
+ * zeroed and running out of memory is fatal.
+ * ===============================================================================
+ */
+
+#include <stdalign.h>
+#include <stddef.h>
+#include "scratch_arena.h"
+
+#define ARENA_ALIGNMENT alignof(max_align_t)
+#define ARENA_ROUND_UP(bytes) (((bytes) + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1))
+#define ARENA_HEADER_SIZE ARENA_ROUND_UP(sizeof(ArenaBlock))
+
+/* ========================================================================================*/
+
+static unsigned char *block_data(ArenaBlock *block)
+{
+    return (unsigned char *)block + ARENA_HEADER_SIZE;
+}
+
+/* ========================================================================================*/
+
+static void push_block(ScratchArena *arena, size_t capacity)
+{
+    ArenaBlock *block = malloc(ARENA_HEADER_SIZE + capacity);
+    if (block == NULL)
+    {
+        fprintf(stderr, "Error: Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    block->next = arena->blocks;
+    block->capacity = capacity;
+    arena->blocks = block;
+    arena->used = 0;
+    arena->total_capacity += capacity;
+}
+
+/* ========================================================================================*/
+
+static void free_blocks(ScratchArena *arena)
+{
+    ArenaBlock *block = arena->blocks;
+    while (block != NULL)
+    {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->blocks = NULL;
+    arena->used = 0;
+    arena->total_capacity = 0;
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+
+void scratch_arena_init(ScratchArena *arena)
+{
+    arena->blocks = NULL;
+    arena->used = 0;
+    arena->total_capacity = 0;
+}
+
+/* ========================================================================================*/
+
+void scratch_arena_free(ScratchArena *arena)
+{
+    free_blocks(arena);
+}
+
+/* ========================================================================================*/
+/**
+ * Returns zeroed room for count elements of size bytes, valid until the next
+ * scratch_arena_reset(). Opens a new block (at least double the previous one)
+ * when the head block is full.
+ */
+void *scratch_arena_alloc(ScratchArena *arena, size_t count, size_t size)
+{
+    if (count > 0 && size > (SIZE_MAX - ARENA_HEADER_SIZE - ARENA_ALIGNMENT) / count)
+    {
+        fprintf(stderr, "Error: Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t bytes = ARENA_ROUND_UP(count * size);
+    if (bytes == 0)
+    {
+        bytes = ARENA_ALIGNMENT;
+    }
+
+    if (arena->blocks == NULL || bytes > arena->blocks->capacity - arena->used)
+    {
+        size_t capacity = (arena->blocks != NULL) ? arena->blocks->capacity * 2 : SCRATCH_ARENA_MIN_BLOCK;
+        push_block(arena, (capacity > bytes) ? capacity : bytes);
+    }
+
+    unsigned char *ptr = block_data(arena->blocks) + arena->used;
+    arena->used += bytes;
+    memset(ptr, 0, bytes);
+    return ptr;
+}
+
+/* ========================================================================================*/
+/**
+ * Reclaims every allocation. A chain of blocks is coalesced into one block
+ * with the same total capacity, so the next run of the same size fits
+ * without growing.
+ */
+void scratch_arena_reset(ScratchArena *arena)
+{
+    if (arena->blocks != NULL && arena->blocks->next != NULL)
+    {
+        size_t total = arena->total_capacity;
+        free_blocks(arena);
+        push_block(arena, total);
+    }
+    arena->used = 0;
+}
@@ -0,0 +1,48 @@
+/*
+ * ===============================================================================
+ * SCRATCH ARENA HEADER FILE
+ * ===============================================================================
+ *
+ * Bump allocator for per-run engine state (ready heaps, SMP core tables).
+ * Allocations are never freed one by one; scratch_arena_reset() reclaims all
+ * of them at once. When a run outgrew the current block, the next reset
+ * replaces the blocks by a single one of their combined size, so repeated
+ * runs on the same workload settle at one block and reset in O(1) with no
+ * allocator calls at all.
+ *
+ * An arena belongs to one thread (it lives in that thread's SchedulerScratch).
+ *
+ * ===============================================================================
+ */
+
+#ifndef SCRATCH_ARENA_H
+#define SCRATCH_ARENA_H
+
+#include "CPU_scheduler.h"
+
+#define SCRATCH_ARENA_MIN_BLOCK ((size_t)64 * 1024)
+
+/* ========================================================================================*/
+// One contiguous region; the newest block is at the head of the list
+typedef struct ArenaBlock
+{
+    struct ArenaBlock *next;
+    size_t capacity;            // Usable bytes after the header
+} ArenaBlock;
+
+// Structure to hold the arena state
+typedef struct
+{
+    ArenaBlock *blocks;
+    size_t used;                // Bytes handed out from the head block
+    size_t total_capacity;      // Sum of all block capacities
+} ScratchArena;
+
+/* ========================================================================================*/
+// Arena function prototypes
+void scratch_arena_init(ScratchArena *arena);
+void scratch_arena_free(ScratchArena *arena);
+void *scratch_arena_alloc(ScratchArena *arena, size_t count, size_t size);
+void scratch_arena_reset(ScratchArena *arena);
+
+#endif // SCRATCH_ARENA_H
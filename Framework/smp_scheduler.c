@@ -0,0 +1,593 @@
+/**
+ * ===============================================================================
+ * SMP SCHEDULER
+ * ===============================================================================
+ * @file smp_scheduler.c
+ * @brief Multi-core simulation with per-core run queues and work stealing
+ *
+ * The machine advances from event to event: the next arrival, the earliest
+ * end of a running slice (cores are kept in a ReadyHeap keyed by that time)
+ * or the next balancing point. At one time the steps run in a fixed order:
+ *
+ * 1. slices ending now stop (completed jobs are recorded)
+ * 2. arrivals are routed to cores, possibly preempting the running job
+ * 3. jobs whose quantum expired go back to their core's queue
+ * 4. the queues are balanced if a balancing point is due
+ * 5. idle cores steal work if their queue is empty and dispatch, in core order
+ *
+ * The simulation works on the rank-ordered columns (see process_columns.h) and
+ * reports through display_results() followed by a per-core table.
+ * ===============================================================================
+ */
+
+#include "smp_scheduler.h"
+#include "ready_heap.h"
+#include "ring_queue.h"
+#include "scheduler_scratch.h"
+
+#define RUN_HEAP_MIN_CAPACITY 16
+
+/* ========================================================================================*/
+// Growable min-heap of (key, rank) entries; a per-core queue only ever holds
+// part of the workload, so unlike ReadyHeap it keeps no position index
+typedef struct
+{
+    ReadyEntry *entries;
+    int size;
+    int capacity;
+} RunHeap;
+
+// Structure to hold the state of one core
+typedef struct
+{
+    RingQueue fifo;             // FCFS / RR run queue
+    RunHeap heap;               // SRTF / PRIORITY_RR run queue
+    int queued;
+    int running;                // Rank on the CPU, -1 when idle
+    int expired;                // Rank whose quantum just ran out, -1 if none
+    int work_start;             // running does work from here on (after a migration)
+    long long busy_time;        // Time spent on job work
+    long long migrations;       // Started jobs that resumed here after running elsewhere
+    bool dirty;                 // Listed in SmpMachine.dirty
+} SmpCore;
+
+// Structure to hold the machine state
+typedef struct
+{
+    SchedulerContext *ctx;
+    const SmpConfig *config;
+    SmpPolicy policy;
+    ProcessColumns *cols;
+    SmpCore *cores;
+    ReadyHeap events;           // Running cores keyed by the end of their slice
+    int *last_core;             // Core each rank last ran on, -1 before its first slice
+    long long *sequence;        // PRIORITY_RR queue order of each rank
+    long long next_sequence;
+    int *dirty;                 // Cores touched at the current time
+    int num_dirty;
+    int completed;
+} SmpMachine;
+
+/* ========================================================================================*/
+/* RUN HEAP */
+/* ========================================================================================*/
+
+static bool entry_less(const ReadyEntry *a, const ReadyEntry *b)
+{
+    return a->key < b->key || (a->key == b->key && a->rank < b->rank);
+}
+
+/* ========================================================================================*/
+
+static void run_heap_push(RunHeap *heap, int idx, int key, long long rank)
+{
+    if (heap->size == heap->capacity)
+    {
+        int capacity = (heap->capacity > 0) ? heap->capacity * 2 : RUN_HEAP_MIN_CAPACITY;
+        ReadyEntry *entries = scheduler_alloc((size_t)capacity, sizeof(ReadyEntry));
+        if (heap->size > 0)
+        {
+            memcpy(entries, heap->entries, (size_t)heap->size * sizeof(ReadyEntry));
+        }
+        free(heap->entries);
+        heap->entries = entries;
+        heap->capacity = capacity;
+    }
+
+    ReadyEntry entry = {rank, key, idx};
+    int slot = heap->size++;
+    while (slot > 0)
+    {
+        int parent = (slot - 1) / 2;
+        if (!entry_less(&entry, &heap->entries[parent]))
+        {
+            break;
+        }
+        heap->entries[slot] = heap->entries[parent];
+        slot = parent;
+    }
+    heap->entries[slot] = entry;
+}
+
+/* ========================================================================================*/
+
+static int run_heap_pop(RunHeap *heap)
+{
+    int top = heap->entries[0].idx;
+    ReadyEntry last = heap->entries[--heap->size];
+
+    int slot = 0;
+    for (;;)
+    {
+        int child = 2 * slot + 1;
+        if (child >= heap->size)
+        {
+            break;
+        }
+        if (child + 1 < heap->size && entry_less(&heap->entries[child + 1], &heap->entries[child]))
+        {
+            child++;
+        }
+        if (!entry_less(&heap->entries[child], &last))
+        {
+            break;
+        }
+        heap->entries[slot] = heap->entries[child];
+        slot = child;
+    }
+    if (heap->size > 0)
+    {
+        heap->entries[slot] = last;
+    }
+    return top;
+}
+
+/* ========================================================================================*/
+/* CORE QUEUES */
+/* ========================================================================================*/
+
+static void core_push(SmpMachine *m, int core, int rank)
+{
+    SmpCore *c = &m->cores[core];
+    switch (m->policy)
+    {
+    case SMP_FCFS:
+    case SMP_RR:
+        ring_queue_push(&c->fifo, rank);
+        break;
+    case SMP_SRTF:
+        run_heap_push(&c->heap, rank, m->cols->remaining_time[rank], rank);
+        break;
+    default:
+        run_heap_push(&c->heap, rank, m->cols->priority[rank], m->sequence[rank]);
+        break;
+    }
+    c->queued++;
+}
+
+/* ========================================================================================*/
+
+// Removes the job the core would run next
+static int core_pop(SmpMachine *m, int core)
+{
+    SmpCore *c = &m->cores[core];
+    c->queued--;
+    if (m->policy == SMP_FCFS || m->policy == SMP_RR)
+    {
+        return ring_queue_pop(&c->fifo);
+    }
+    return run_heap_pop(&c->heap);
+}
+
+/* ========================================================================================*/
+
+static int core_load(const SmpCore *c)
+{
+    return c->queued + (c->running >= 0) + (c->expired >= 0);
+}
+
+/* ========================================================================================*/
+
+static void mark_dirty(SmpMachine *m, int core)
+{
+    if (!m->cores[core].dirty)
+    {
+        m->cores[core].dirty = true;
+        m->dirty[m->num_dirty++] = core;
+    }
+}
+
+/* ========================================================================================*/
+
+static int compare_core_ids(const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+/* ========================================================================================*/
+/* RUNNING JOBS */
+/* ========================================================================================*/
+
+// Takes the running job off the core at time, crediting the work it did
+static int stop_running(SmpMachine *m, int core, int time)
+{
+    SmpCore *c = &m->cores[core];
+    int rank = c->running;
+    int worked = time - c->work_start;
+    if (worked > 0)
+    {
+        m->cols->remaining_time[rank] -= worked;
+        c->busy_time += worked;
+    }
+    c->running = -1;
+    mark_dirty(m, core);
+    return rank;
+}
+
+/* ========================================================================================*/
+
+// Would rank, arriving at time, preempt the job running on core?
+static bool preempts(const SmpMachine *m, const SmpCore *c, int rank, int time)
+{
+    const ProcessColumns *cols = m->cols;
+    int running = c->running;
+
+    if (m->policy == SMP_SRTF)
+    {
+        int worked = time - c->work_start;
+        int left = cols->remaining_time[running] - (worked > 0 ? worked : 0);
+        return cols->remaining_time[rank] < left || (cols->remaining_time[rank] == left && rank < running);
+    }
+    if (m->policy == SMP_PRIORITY_RR)
+    {
+        return cols->priority[rank] < cols->priority[running];
+    }
+    return false;
+}
+
+/* ========================================================================================*/
+
+static void admit(SmpMachine *m, int rank, int time)
+{
+    // Least loaded core, lowest index on ties
+    int target = 0;
+    int target_load = INT_MAX;
+    for (int core = 0; core < m->config->num_cores; core++)
+    {
+        int load = core_load(&m->cores[core]);
+        if (load < target_load)
+        {
+            target = core;
+            target_load = load;
+        }
+    }
+
+    SmpCore *c = &m->cores[target];
+    m->sequence[rank] = m->next_sequence++;
+    core_push(m, target, rank);
+    mark_dirty(m, target);
+
+    if (c->running >= 0 && preempts(m, c, rank, time))
+    {
+        // Pull the slice event to the root (no other key is INT_MIN) and drop it
+        ready_heap_update(&m->events, target, INT_MIN);
+        ready_heap_pop(&m->events);
+        core_push(m, target, stop_running(m, target, time));   // Keeps its sequence
+    }
+}
+
+/* ========================================================================================*/
+
+// Moves the next queued job of the busiest other core to thief
+static void steal(SmpMachine *m, int thief)
+{
+    int victim = -1;
+    for (int core = 0; core < m->config->num_cores; core++)
+    {
+        if (core != thief && m->cores[core].queued > 0 &&
+            (victim < 0 || m->cores[core].queued > m->cores[victim].queued))
+        {
+            victim = core;
+        }
+    }
+    if (victim >= 0)
+    {
+        core_push(m, thief, core_pop(m, victim));
+    }
+}
+
+/* ========================================================================================*/
+
+// Moves queued jobs until no two run queues differ by more than one job
+static void balance(SmpMachine *m)
+{
+    for (;;)
+    {
+        int longest = 0, shortest = 0;
+        for (int core = 1; core < m->config->num_cores; core++)
+        {
+            if (m->cores[core].queued > m->cores[longest].queued)
+            {
+                longest = core;
+            }
+            if (m->cores[core].queued < m->cores[shortest].queued)
+            {
+                shortest = core;
+            }
+        }
+        if (m->cores[longest].queued - m->cores[shortest].queued <= 1)
+        {
+            return;
+        }
+        core_push(m, shortest, core_pop(m, longest));
+        mark_dirty(m, shortest);
+    }
+}
+
+/* ========================================================================================*/
+
+static void dispatch(SmpMachine *m, int core, int time)
+{
+    SmpCore *c = &m->cores[core];
+    if (c->running >= 0)
+    {
+        return;
+    }
+    if (c->queued == 0 && m->config->work_stealing)
+    {
+        steal(m, core);
+    }
+    if (c->queued == 0)
+    {
+        return;
+    }
+
+    ProcessColumns *cols = m->cols;
+    int rank = core_pop(m, core);
+    int work_start = time;
+    if (cols->start_time[rank] >= 0 && m->last_core[rank] != core)
+    {
+        work_start += m->config->migration_cost;
+        c->migrations++;
+    }
+    else if (cols->start_time[rank] < 0)
+    {
+        cols->start_time[rank] = time;
+    }
+    m->last_core[rank] = core;
+
+    int slice = cols->remaining_time[rank];
+    if (m->policy == SMP_RR || m->policy == SMP_PRIORITY_RR)
+    {
+        slice = min_value(slice, m->config->time_quantum);
+    }
+    c->running = rank;
+    c->work_start = work_start;
+    ready_heap_push(&m->events, core, work_start + slice, core);
+}
+
+/* ========================================================================================*/
+/* SIMULATION */
+/* ========================================================================================*/
+
+static void simulate(SmpMachine *m)
+{
+    const SmpConfig *config = m->config;
+    const int *arrival = m->cols->arrival_time;
+    int n = m->cols->num_processes;
+    int next_arrival = 0;
+    long long next_balance = (config->balance_interval > 0) ? config->balance_interval : LLONG_MAX;
+
+    while (m->completed < n)
+    {
+        // An idle machine has nothing queued, so skip the balancing points up to the next arrival
+        if (ready_heap_is_empty(&m->events) && next_arrival < n && next_balance < arrival[next_arrival])
+        {
+            long long gap = arrival[next_arrival] - next_balance;
+            next_balance += (gap + config->balance_interval - 1) / config->balance_interval * config->balance_interval;
+        }
+
+        long long time = (next_arrival < n) ? arrival[next_arrival] : LLONG_MAX;
+        int first_core = ready_heap_peek(&m->events);
+        if (first_core >= 0 && m->events.entries[0].key < time)
+        {
+            time = m->events.entries[0].key;
+        }
+        if (next_balance < time)
+        {
+            time = next_balance;
+        }
+        int now = (int)time;
+
+        // 1. Slices ending now
+        while (!ready_heap_is_empty(&m->events) && m->events.entries[0].key == now)
+        {
+            int core = ready_heap_pop(&m->events);
+            int rank = stop_running(m, core, now);
+            if (m->cols->remaining_time[rank] == 0)
+            {
+                m->cols->completion_time[rank] = now;
+                m->completed++;
+            }
+            else
+            {
+                m->cores[core].expired = rank;
+            }
+        }
+
+        // 2. Arrivals
+        while (next_arrival < n && arrival[next_arrival] <= now)
+        {
+            admit(m, next_arrival++, now);
+        }
+
+        // 3. Expired quanta go behind the arrivals
+        for (int i = 0; i < m->num_dirty; i++)
+        {
+            SmpCore *c = &m->cores[m->dirty[i]];
+            if (c->expired >= 0)
+            {
+                m->sequence[c->expired] = m->next_sequence++;
+                core_push(m, m->dirty[i], c->expired);
+                c->expired = -1;
+            }
+        }
+
+        // 4. Periodic balancing
+        if (next_balance == time)
+        {
+            balance(m);
+            next_balance += config->balance_interval;
+        }
+
+        // 5. Dispatch idle cores in core order; with stealing every idle core gets a turn
+        if (config->work_stealing)
+        {
+            for (int core = 0; core < config->num_cores; core++)
+            {
+                if (m->cores[core].running < 0)
+                {
+                    mark_dirty(m, core);
+                }
+            }
+        }
+        if (m->num_dirty > 1)
+        {
+            qsort(m->dirty, (size_t)m->num_dirty, sizeof(int), compare_core_ids);
+        }
+        for (int i = 0; i < m->num_dirty; i++)
+        {
+            m->cores[m->dirty[i]].dirty = false;
+            dispatch(m, m->dirty[i], now);
+        }
+        m->num_dirty = 0;
+    }
+}
+
+/* ========================================================================================*/
+/* REPORT */
+/* ========================================================================================*/
+
+static void print_core_table(const SmpMachine *m, const char *name)
+{
+    SchedulerContext *ctx = m->ctx;
+    const ProcessColumns *cols = m->cols;
+    if (ctx->output == NULL ||
+        (ctx->output_format != RESULT_FORMAT_TEXT && ctx->output_format != RESULT_FORMAT_NDJSON))
+    {
+        return;
+    }
+
+    // Utilization over the same span as ScheduleMetrics.cpu_utilization
+    long long last_completion = 0;
+    for (int k = 0; k < cols->num_processes; k++)
+    {
+        last_completion = (cols->completion_time[k] > last_completion) ? cols->completion_time[k] : last_completion;
+    }
+    long long span = last_completion - cols->arrival_time[0];
+
+    if (ctx->output_format == RESULT_FORMAT_TEXT)
+    {
+        fprintf(ctx->output, "Core     Busy_Time            Utilization          Migrations\n");
+    }
+    for (int core = 0; core < m->config->num_cores; core++)
+    {
+        const SmpCore *c = &m->cores[core];
+        double utilization = (span > 0) ? (double)c->busy_time / (double)span : 0.0;
+        if (ctx->output_format == RESULT_FORMAT_TEXT)
+        {
+            char percent[32];
+            snprintf(percent, sizeof(percent), "%.2f%%", utilization * 100.0);
+            fprintf(ctx->output, "%-9d%-21lld%-21s%lld\n", core, c->busy_time, percent, c->migrations);
+        }
+        else
+        {
+            fprintf(ctx->output,
+                    "{\"type\":\"core\",\"algorithm\":\"%s\",\"core\":%d,\"busy_time\":%lld,"
+                    "\"utilization\":%.6f,\"migrations\":%lld}\n",
+                    name, core, c->busy_time, utilization, c->migrations);
+        }
+    }
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+
+/**
+ * @brief Simulates policy on config->num_cores cores
+ *
+ * @param ctx Pointer to the scheduler context containing all process information
+ * @param policy Per-core scheduling policy
+ * @param config Machine model
+ *
+ * Fills in start_time and completion_time of every process like the single-core
+ * engines, then prints the usual report and the busy time, utilization and
+ * incoming migrations of every core.
+ */
+void smp_scheduler(SchedulerContext *ctx, SmpPolicy policy, const SmpConfig *config)
+{
+    // PRIORITY_RR rotates unlike priority_preemptive_rr(), so it keeps a title of its own
+    static const AlgorithmId ALGORITHM_OF[] = {
+        [SMP_FCFS] = ALGORITHM_FCFS,
+        [SMP_RR] = ALGORITHM_RR,
+        [SMP_SRTF] = ALGORITHM_SRTF,
+    };
+
+    if (ctx->num_processes <= 0 || config->num_cores <= 0 || config->time_quantum <= 0)
+    {
+        return;
+    }
+    reset_process_states(ctx);
+
+    SmpMachine m;
+    memset(&m, 0, sizeof(m));
+    m.ctx = ctx;
+    m.config = config;
+    m.policy = policy;
+
+    ProcessColumns local_columns;
+    m.cols = acquire_process_columns(ctx, &local_columns);
+    int n = m.cols->num_processes;
+
+    m.cores = scratch_alloc(ctx, (size_t)config->num_cores, sizeof(SmpCore));
+    for (int core = 0; core < config->num_cores; core++)
+    {
+        SmpCore *c = &m.cores[core];
+        ring_queue_init(&c->fifo, RING_QUEUE_MIN_CAPACITY);
+        c->running = -1;
+        c->expired = -1;
+    }
+    acquire_ready_heap(ctx, &m.events, config->num_cores);
+    m.last_core = scratch_alloc(ctx, (size_t)n, sizeof(int));
+    for (int k = 0; k < n; k++)
+    {
+        m.last_core[k] = -1;
+    }
+    m.sequence = scratch_alloc(ctx, (size_t)n, sizeof(long long));
+    m.dirty = scratch_alloc(ctx, (size_t)config->num_cores, sizeof(int));
+
+    simulate(&m);
+
+    process_columns_store(m.cols, ctx);
+
+    char name[96];
+    const char *title = (policy == SMP_PRIORITY_RR) ? "PRIORITY_PREEMPTIVE_WITH_ROTATING_RR"
+                                                     : SCHEDULER_ALGORITHMS[ALGORITHM_OF[policy]].title;
+    snprintf(name, sizeof(name), "%s on %d core%s", title, config->num_cores,
+             (config->num_cores == 1) ? "" : "s");
+    display_results(ctx, name);
+    print_core_table(&m, name);
+
+    for (int core = 0; core < config->num_cores; core++)
+    {
+        ring_queue_free(&m.cores[core].fifo);
+        free(m.cores[core].heap.entries);
+    }
+    scratch_release(ctx, m.cores);
+    release_ready_heap(ctx, &m.events);
+    scratch_release(ctx, m.last_core);
+    scratch_release(ctx, m.sequence);
+    scratch_release(ctx, m.dirty);
+    release_process_columns(ctx, m.cols);
+}
@@ -0,0 +1,62 @@
+/*
+ * ===============================================================================
+ * SMP SCHEDULER HEADER FILE
+ * ===============================================================================
+ *
+ * Event-driven simulation of a multi-core machine. Every core owns a run queue
+ * and applies one of the single-core policies to it:
+ *
+ * - FCFS:        FIFO, runs each job to completion
+ * - RR:          FIFO with a time quantum; arrivals at the end of a slice are
+ *                queued before the preempted job, as in round_robin()
+ * - SRTF:        min-heap on remaining time → arrival rank; an arrival routed
+ *                to the core preempts a job with more remaining time
+ * - PRIORITY_RR: min-heap on priority → queue sequence; a higher priority
+ *                arrival preempts, equal priorities rotate per quantum. Unlike
+ *                priority_preemptive_rr(), same-priority arrivals join the
+ *                rotation at once instead of waiting for the next cycle, and a
+ *                preempted job resumes before the rest of its level; the
+ *                report says ROTATING_RR and the differential harness checks
+ *                it against REFERENCE_PRIORITY_RR_ROTATING.
+ *
+ * Arrivals go to the least loaded core (queued + running, lowest core first).
+ * A core that runs out of work steals the next job of the core with the most
+ * queued jobs, and with a balance interval the queues are evened out
+ * periodically. A job that resumes on another core than it last ran on pays
+ * migration_cost before it continues. With one core, FCFS, RR and SRTF give
+ * exactly the schedules of the single-core engines.
+ *
+ * ===============================================================================
+ */
+
+#ifndef SMP_SCHEDULER_H
+#define SMP_SCHEDULER_H
+
+#include "CPU_scheduler.h"
+
+/* ========================================================================================*/
+// Per-core policies
+typedef enum
+{
+    SMP_FCFS,
+    SMP_RR,
+    SMP_SRTF,
+    SMP_PRIORITY_RR,
+    SMP_NUM_POLICIES
+} SmpPolicy;
+
+// Structure to hold the machine model
+typedef struct
+{
+    int num_cores;
+    int time_quantum;           // RR / PRIORITY_RR slice length
+    bool work_stealing;         // Idle cores steal queued jobs
+    int balance_interval;       // Even out the run queues every N time units, 0 = never
+    int migration_cost;         // Time a started job loses when it resumes on another core
+} SmpConfig;
+
+/* ========================================================================================*/
+// SMP function prototypes
+void smp_scheduler(SchedulerContext *ctx, SmpPolicy policy, const SmpConfig *config);
+
+#endif // SMP_SCHEDULER_H
@@ -0,0 +1,110 @@
+/**
+ * ===============================================================================
+ * THREAD POOL
+ * ===============================================================================
+ * @file thread_pool.c
+ * @brief Fork-join execution of independent tasks on POSIX threads
+ * ===============================================================================
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include "thread_pool.h"
+
+/* ========================================================================================*/
+// Shared state of one run_parallel_tasks() call
+typedef struct
+{
+    ParallelTask task;
+    void *arg;
+    int num_tasks;
+    atomic_int next_task;
+} TaskBatch;
+
+// Start argument of one worker thread
+typedef struct
+{
+    TaskBatch *batch;
+    int worker;
+} WorkerStart;
+
+/* ========================================================================================*/
+
+static void *worker_main(void *data)
+{
+    WorkerStart *start = data;
+    TaskBatch *batch = start->batch;
+    for (;;)
+    {
+        int index = atomic_fetch_add(&batch->next_task, 1);
+        if (index >= batch->num_tasks)
+        {
+            break;
+        }
+        batch->task(batch->arg, index, start->worker);
+    }
+    return NULL;
+}
+
+/* ========================================================================================*/
+
+int default_thread_count(void)
+{
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return (online > 0) ? (int)online : 1;
+}
+
+/* ========================================================================================*/
+/**
+ * Runs task(arg, 0 .. num_tasks - 1, worker) and waits for all of them.
+ * The calling thread works too, so num_threads = 1 runs everything inline.
+ */
+void run_parallel_tasks(int num_tasks, int num_threads, ParallelTask task, void *arg)
+{
+    if (num_tasks <= 0)
+    {
+        return;
+    }
+    if (num_threads > num_tasks)
+    {
+        num_threads = num_tasks;
+    }
+    if (num_threads < 1)
+    {
+        num_threads = 1;
+    }
+
+    TaskBatch batch;
+    batch.task = task;
+    batch.arg = arg;
+    batch.num_tasks = num_tasks;
+    atomic_init(&batch.next_task, 0);
+
+    pthread_t *workers = scheduler_alloc((size_t)num_threads, sizeof(pthread_t));
+    WorkerStart *starts = scheduler_alloc((size_t)num_threads, sizeof(WorkerStart));
+    for (int i = 0; i < num_threads; i++)
+    {
+        starts[i].batch = &batch;
+        starts[i].worker = i;
+    }
+
+    int started = 0;
+    for (int i = 1; i < num_threads; i++)
+    {
+        if (pthread_create(&workers[started], NULL, worker_main, &starts[i]) != 0)
+        {
+            break; // Fewer workers only means less parallelism
+        }
+        started++;
+    }
+
+    worker_main(&starts[0]);
+
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+    free(starts);
+}
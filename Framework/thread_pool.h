@@ -0,0 +1,30 @@
+/*
+ * ===============================================================================
+ * THREAD POOL HEADER FILE
+ * ===============================================================================
+ *
+ * Minimal fork-join pool: run_parallel_tasks() runs task(arg, i, worker) for
+ * every i in [0, num_tasks) on up to num_threads worker threads and returns
+ * once all tasks have finished. Tasks are handed out dynamically, so long and
+ * short tasks balance across workers. worker (0 .. num_threads - 1) identifies
+ * the executing thread so callers can keep per-thread scratch state.
+ *
+ * ===============================================================================
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "CPU_scheduler.h"
+
+/* ========================================================================================*/
+// Work item signature: arg is shared by all tasks, index identifies the task,
+// worker identifies the thread running it
+typedef void (*ParallelTask)(void *arg, int index, int worker);
+
+/* ========================================================================================*/
+// Thread pool function prototypes
+int default_thread_count(void);
+void run_parallel_tasks(int num_tasks, int num_threads, ParallelTask task, void *arg);
+
+#endif // THREAD_POOL_H
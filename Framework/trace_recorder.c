@@ -0,0 +1,275 @@
+/**
+ * ===============================================================================
+ * EXECUTION TRACE RECORDER
+ * ===============================================================================
+ * @file trace_recorder.c
+ * @brief Ring-buffered scheduling events with an asynchronous JSON writer
+ *
+ * The ring is split into blocks. The producer fills one block at a time and
+ * publishes it under the lock; the writer thread drains published blocks in
+ * order, formatting them without holding the lock. A block is reused once the
+ * writer has consumed it.
+ * ===============================================================================
+ */
+
+#include <pthread.h>
+#include "trace_recorder.h"
+
+/* ========================================================================================*/
+// Structure to hold the recorder state
+struct TraceRecorder
+{
+    TraceEvent *events;             // TRACE_NUM_BLOCKS * TRACE_BLOCK_EVENTS entries
+    int fill;                       // Events in the producer's current block
+    long long produced;             // Index of the producer's current block
+    int current_track;              // -1 once the track table is full
+    int num_tracks;
+    const char *track_names[TRACE_MAX_TRACKS];
+
+    // Shared with the writer thread (guarded by lock)
+    pthread_mutex_t lock;
+    pthread_cond_t published_cond;  // Signalled when a block is published or on close
+    pthread_cond_t consumed_cond;   // Signalled when a block has been written
+    long long published;            // Blocks handed to the writer
+    long long consumed;             // Blocks the writer is done with
+    int block_fill[TRACE_NUM_BLOCKS];
+    bool closing;
+
+    // Writer thread only
+    pthread_t writer;
+    FILE *file;
+    bool first_event;
+};
+
+/* ========================================================================================*/
+/* WRITER THREAD */
+/* ========================================================================================*/
+
+// Writes text as a JSON string literal, escaping quotes, backslashes and control characters
+static void write_json_string(FILE *file, const char *text)
+{
+    fputc('"', file);
+    for (const unsigned char *c = (const unsigned char *)text; *c != '\0'; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            fputc('\\', file);
+            fputc(*c, file);
+        }
+        else if (*c < 0x20)
+        {
+            fprintf(file, "\\u%04x", *c);
+        }
+        else
+        {
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+/* ========================================================================================*/
+
+static void write_event(TraceRecorder *recorder, const TraceEvent *e)
+{
+    FILE *file = recorder->file;
+    int tid = e->track + 1;
+
+    fputs(recorder->first_event ? "\n" : ",\n", file);
+    recorder->first_event = false;
+
+    switch ((TraceEventType)e->type)
+    {
+    case TRACE_TRACK:
+        fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", tid);
+        write_json_string(file, recorder->track_names[e->track]);
+        fputs("}}", file);
+        break;
+    case TRACE_DISPATCH:
+        fprintf(file, "{\"name\":\"P%d\",\"ph\":\"B\",\"pid\":1,\"tid\":%d,\"ts\":%lld}",
+                (int)e->pid, tid, (long long)e->time);
+        break;
+    case TRACE_PREEMPT:
+    case TRACE_COMPLETE:
+        fprintf(file, "{\"name\":\"P%d\",\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%lld,\"args\":{\"end\":\"%s\"}}",
+                (int)e->pid, tid, (long long)e->time, (e->type == TRACE_PREEMPT) ? "preempt" : "complete");
+        break;
+    }
+}
+
+/* ========================================================================================*/
+
+static void *trace_writer_main(void *arg)
+{
+    TraceRecorder *recorder = arg;
+
+    pthread_mutex_lock(&recorder->lock);
+    for (;;)
+    {
+        while (recorder->consumed == recorder->published && !recorder->closing)
+        {
+            pthread_cond_wait(&recorder->published_cond, &recorder->lock);
+        }
+        if (recorder->consumed == recorder->published)
+        {
+            break;
+        }
+
+        int block = (int)(recorder->consumed % TRACE_NUM_BLOCKS);
+        int count = recorder->block_fill[block];
+        pthread_mutex_unlock(&recorder->lock);
+
+        const TraceEvent *events = &recorder->events[(size_t)block * TRACE_BLOCK_EVENTS];
+        for (int i = 0; i < count; i++)
+        {
+            write_event(recorder, &events[i]);
+        }
+
+        pthread_mutex_lock(&recorder->lock);
+        recorder->consumed++;
+        pthread_cond_signal(&recorder->consumed_cond);
+    }
+    pthread_mutex_unlock(&recorder->lock);
+    return NULL;
+}
+
+/* ========================================================================================*/
+/* PRODUCER */
+/* ========================================================================================*/
+
+// Hands the current block to the writer and waits until the next one is free
+static void publish_block(TraceRecorder *recorder)
+{
+    pthread_mutex_lock(&recorder->lock);
+    recorder->block_fill[recorder->produced % TRACE_NUM_BLOCKS] = recorder->fill;
+    recorder->published++;
+    pthread_cond_signal(&recorder->published_cond);
+
+    recorder->produced++;
+    recorder->fill = 0;
+    while (recorder->produced - recorder->consumed >= TRACE_NUM_BLOCKS)
+    {
+        pthread_cond_wait(&recorder->consumed_cond, &recorder->lock);
+    }
+    pthread_mutex_unlock(&recorder->lock);
+}
+
+/* ========================================================================================*/
+
+void trace_recorder_append(TraceRecorder *recorder, TraceEventType type, int pid, long long time)
+{
+    if (recorder->current_track < 0)
+    {
+        return;
+    }
+    size_t block = (size_t)(recorder->produced % TRACE_NUM_BLOCKS);
+    TraceEvent *e = &recorder->events[block * TRACE_BLOCK_EVENTS + (size_t)recorder->fill];
+    e->time = time;
+    e->pid = pid;
+    e->type = (uint16_t)type;
+    e->track = (uint16_t)recorder->current_track;
+
+    if (++recorder->fill == TRACE_BLOCK_EVENTS)
+    {
+        publish_block(recorder);
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Starts a new track; the following events are drawn on it. name must stay
+ * valid until the recorder is closed. Past TRACE_MAX_TRACKS tracks, warns once
+ * and drops the events until the recorder is closed; returns false.
+ */
+bool trace_recorder_begin_track(TraceRecorder *recorder, const char *name)
+{
+    if (recorder->num_tracks == TRACE_MAX_TRACKS)
+    {
+        if (recorder->current_track >= 0)
+        {
+            fprintf(stderr, "Warning: The trace holds at most %d tracks; later runs are not recorded.\n",
+                    TRACE_MAX_TRACKS);
+            recorder->current_track = -1;
+        }
+        return false;
+    }
+    recorder->track_names[recorder->num_tracks] = name;
+    recorder->current_track = recorder->num_tracks++;
+    trace_recorder_append(recorder, TRACE_TRACK, 0, 0);
+    return true;
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+
+/**
+ * Creates the trace file at path and starts its writer thread. Returns NULL
+ * (after printing why) on failure.
+ */
+TraceRecorder *trace_recorder_open(const char *path)
+{
+    TraceRecorder *recorder = scheduler_alloc(1, sizeof(TraceRecorder));
+    memset(recorder, 0, sizeof(*recorder));
+
+    recorder->file = fopen(path, "w");
+    if (recorder->file == NULL)
+    {
+        fprintf(stderr, "Error: Cannot create trace file '%s'.\n", path);
+        free(recorder);
+        return NULL;
+    }
+    recorder->events = scheduler_alloc((size_t)TRACE_NUM_BLOCKS * TRACE_BLOCK_EVENTS, sizeof(TraceEvent));
+    recorder->first_event = true;
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", recorder->file);
+
+    pthread_mutex_init(&recorder->lock, NULL);
+    pthread_cond_init(&recorder->published_cond, NULL);
+    pthread_cond_init(&recorder->consumed_cond, NULL);
+    if (pthread_create(&recorder->writer, NULL, trace_writer_main, recorder) != 0)
+    {
+        fprintf(stderr, "Error: Cannot start the trace writer thread.\n");
+        fclose(recorder->file);
+        pthread_mutex_destroy(&recorder->lock);
+        pthread_cond_destroy(&recorder->published_cond);
+        pthread_cond_destroy(&recorder->consumed_cond);
+        free(recorder->events);
+        free(recorder);
+        return NULL;
+    }
+    return recorder;
+}
+
+/* ========================================================================================*/
+/**
+ * Flushes the remaining events, finishes the JSON document and frees the
+ * recorder. Returns false if the trace file could not be written completely.
+ */
+bool trace_recorder_close(TraceRecorder *recorder)
+{
+    if (recorder->fill > 0)
+    {
+        publish_block(recorder);
+    }
+
+    pthread_mutex_lock(&recorder->lock);
+    recorder->closing = true;
+    pthread_cond_signal(&recorder->published_cond);
+    pthread_mutex_unlock(&recorder->lock);
+    pthread_join(recorder->writer, NULL);
+
+    fputs("\n]}\n", recorder->file);
+    bool ok = !ferror(recorder->file);
+    ok = (fclose(recorder->file) == 0) && ok;
+    if (!ok)
+    {
+        fprintf(stderr, "Error: Failed to write the trace file.\n");
+    }
+
+    pthread_mutex_destroy(&recorder->lock);
+    pthread_cond_destroy(&recorder->published_cond);
+    pthread_cond_destroy(&recorder->consumed_cond);
+    free(recorder->events);
+    free(recorder);
+    return ok;
+}
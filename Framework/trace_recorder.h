@@ -0,0 +1,75 @@
+/*
+ * ===============================================================================
+ * EXECUTION TRACE RECORDER HEADER FILE
+ * ===============================================================================
+ *
+ * Optional record of when each job actually held the CPU. The engines report
+ * every dispatch, preemption and completion through TRACE_POINT(); the events
+ * are appended to a preallocated ring of TRACE_NUM_BLOCKS blocks and a
+ * background thread writes every full block to the trace file, so the
+ * scheduling loop never formats or writes anything itself. The producer only
+ * takes the lock once per TRACE_BLOCK_EVENTS events (and waits if the writer
+ * is a whole ring behind).
+ *
+ * The file is Chrome trace event JSON (chrome://tracing, ui.perfetto.dev) with
+ * one track per algorithm run (trace_recorder_begin_track). Each slice is a
+ * B / E pair named after the PID; one scheduling time unit is shown as 1 us.
+ *
+ * The hooks are compiled in only with -DSCHED_TRACE (make TRACE=1). Without
+ * it TRACE_POINT() expands to nothing; with it, a run that has no recorder
+ * attached (ctx->trace == NULL) pays one predicted branch per event.
+ *
+ * ===============================================================================
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include "CPU_scheduler.h"
+
+#define TRACE_BLOCK_EVENTS 4096     // Events handed to the writer at a time
+#define TRACE_NUM_BLOCKS 8          // Blocks in the ring
+#define TRACE_MAX_TRACKS 64
+
+/* ========================================================================================*/
+// What happened at time to process pid
+typedef enum
+{
+    TRACE_TRACK,        // A new track starts (pid unused)
+    TRACE_DISPATCH,     // pid got the CPU
+    TRACE_PREEMPT,      // pid lost the CPU with work left
+    TRACE_COMPLETE      // pid finished
+} TraceEventType;
+
+// Fixed-size ring entry
+typedef struct
+{
+    int64_t time;
+    int32_t pid;
+    uint16_t type;
+    uint16_t track;
+} TraceEvent;
+
+/* ========================================================================================*/
+// Recorder function prototypes
+TraceRecorder *trace_recorder_open(const char *path);
+bool trace_recorder_close(TraceRecorder *recorder);
+bool trace_recorder_begin_track(TraceRecorder *recorder, const char *name);
+void trace_recorder_append(TraceRecorder *recorder, TraceEventType type, int pid, long long time);
+
+/* ========================================================================================*/
+// Engine hook
+#ifdef SCHED_TRACE
+#define TRACE_POINT(ctx, type, pid, time)                               \
+    do                                                                  \
+    {                                                                   \
+        if (__builtin_expect((ctx)->trace != NULL, 0))                  \
+        {                                                               \
+            trace_recorder_append((ctx)->trace, (type), (pid), (time)); \
+        }                                                               \
+    } while (0)
+#else
+#define TRACE_POINT(ctx, type, pid, time) ((void)0)
+#endif
+
+#endif // TRACE_RECORDER_H
@@ -0,0 +1,329 @@
+/**
+ * ===============================================================================
+ * BINARY WORKLOAD FORMAT
+ * ===============================================================================
+ * @file workload_binary.c
+ * @brief Writer and mmap-based loader for the columnar workload file
+ *
+ * Mapping a file only validates its header, so it costs the same for any trace
+ * size. Loading hands the mapping to the context instead of copying it: the
+ * engines' input columns come straight from the file, and the Process rows,
+ * which hold the per-run results, are filled in when first needed.
+ * ===============================================================================
+ */
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "workload_binary.h"
+
+/* ========================================================================================*/
+/* LOADING */
+/* ========================================================================================*/
+
+bool is_workload_magic(const char *bytes, size_t length)
+{
+    return length >= WORKLOAD_MAGIC_SIZE && memcmp(bytes, WORKLOAD_MAGIC, WORKLOAD_MAGIC_SIZE) == 0;
+}
+
+/* ========================================================================================*/
+/**
+ * Maps the workload file open on fd and checks its header and column bounds.
+ * The descriptor may be closed once this returns.
+ */
+bool map_workload_file(int fd, MappedWorkload *map)
+{
+    memset(map, 0, sizeof(*map));
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        fprintf(stderr, "Error: Cannot stat workload file: %s.\n", strerror(errno));
+        return false;
+    }
+    if (info.st_size < (off_t)sizeof(WorkloadFileHeader))
+    {
+        fprintf(stderr, "Error: Workload file is truncated.\n");
+        return false;
+    }
+
+    size_t length = (size_t)info.st_size;
+    void *base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED)
+    {
+        fprintf(stderr, "Error: Cannot map workload file: %s.\n", strerror(errno));
+        return false;
+    }
+
+    const WorkloadFileHeader *header = base;
+    const char *problem = NULL;
+    if (!is_workload_magic(header->magic, sizeof(header->magic)))
+    {
+        problem = "not a workload file";
+    }
+    else if (header->byte_order != WORKLOAD_BYTE_ORDER_MARK)
+    {
+        problem = "written with a different byte order";
+    }
+    else if (header->version != WORKLOAD_FORMAT_VERSION)
+    {
+        problem = "unsupported format version";
+    }
+    else if (header->num_columns != WORKLOAD_NUM_COLUMNS || header->num_processes > INT_MAX)
+    {
+        problem = "corrupt header";
+    }
+
+    for (int c = 0; problem == NULL && c < WORKLOAD_NUM_COLUMNS; c++)
+    {
+        uint64_t offset = header->column_offset[c];
+        uint64_t bytes = header->num_processes * sizeof(int32_t);
+        if (offset % sizeof(int32_t) != 0 || offset < sizeof(WorkloadFileHeader) ||
+            offset > length || bytes > length - offset)
+        {
+            problem = "column outside the file";
+            break;
+        }
+        map->columns[c] = (const int32_t *)((const char *)base + offset);
+    }
+
+    if (problem != NULL)
+    {
+        fprintf(stderr, "Error: Invalid workload file (%s).\n", problem);
+        munmap(base, length);
+        memset(map, 0, sizeof(*map));
+        return false;
+    }
+
+    // Columns are read front to back exactly once
+    posix_madvise(base, length, POSIX_MADV_SEQUENTIAL);
+
+    map->base = base;
+    map->length = length;
+    map->flags = header->flags;
+    map->num_processes = (int)header->num_processes;
+    return true;
+}
+
+/* ========================================================================================*/
+
+void unmap_workload_file(MappedWorkload *map)
+{
+    if (map->base != NULL)
+    {
+        munmap(map->base, map->length);
+    }
+    memset(map, 0, sizeof(*map));
+}
+
+/* ========================================================================================*/
+/**
+ * Replaces the workload in ctx with the mapped rows; ctx takes over the
+ * mapping (*map is cleared) and unmaps it in free_scheduler_context(). When
+ * the file claims to be sorted by arrival (and really is), the identity
+ * order becomes the cached arrival index so no sort is needed.
+ */
+bool load_mapped_workload(MappedWorkload *map, SchedulerContext *ctx)
+{
+    int n = map->num_processes;
+    MappedWorkload *owned = malloc(sizeof(*owned));
+    int *order = (n > 0) ? malloc((size_t)n * sizeof(int)) : NULL;
+    if (owned == NULL || (n > 0 && order == NULL))
+    {
+        free(owned);
+        free(order);
+        return false;
+    }
+
+    const int32_t *pid = map->columns[WORKLOAD_COLUMN_PID];
+    const int32_t *arrival_time = map->columns[WORKLOAD_COLUMN_ARRIVAL_TIME];
+    bool sorted = (map->flags & WORKLOAD_FLAG_SORTED_BY_ARRIVAL) != 0;
+    for (int i = 1; sorted && i < n; i++)
+    {
+        sorted = arrival_time[i - 1] < arrival_time[i] ||
+                 (arrival_time[i - 1] == arrival_time[i] && pid[i - 1] <= pid[i]);
+    }
+    if (!sorted)
+    {
+        map->flags &= ~WORKLOAD_FLAG_SORTED_BY_ARRIVAL;
+        free(order);
+        order = NULL;
+    }
+    for (int i = 0; order != NULL && i < n; i++)
+    {
+        order[i] = i;
+    }
+
+    release_mapped_input(ctx);
+    free(ctx->arrival_order);
+    ctx->arrival_order = order;
+    *owned = *map;
+    memset(map, 0, sizeof(*map));
+    ctx->mapped_input = owned;
+    ctx->rows_pending = true;
+    ctx->num_processes = n;
+    return true;
+}
+
+/* ========================================================================================*/
+/**
+ * Fills ctx->processes from the mapped workload the first time a consumer
+ * needs the rows (engines, clones, the file writer). Out of memory is fatal,
+ * as for the engines' other buffers.
+ */
+void materialize_process_rows(SchedulerContext *ctx)
+{
+    if (!ctx->rows_pending)
+    {
+        return;
+    }
+    const MappedWorkload *map = ctx->mapped_input;
+    int n = ctx->num_processes;
+    Process *rows = scheduler_alloc((size_t)n, sizeof(Process));
+    fill_mapped_rows(map, rows, n);
+
+    free(ctx->processes);
+    ctx->processes = rows;
+    ctx->capacity = (n > 0) ? n : 1;
+    ctx->rows_pending = false;
+}
+
+/* ========================================================================================*/
+/**
+ * Writes the input fields of the first n mapped rows into rows[] with the
+ * per-run state reset.
+ */
+void fill_mapped_rows(const MappedWorkload *map, Process *rows, int n)
+{
+    const int32_t *pid = map->columns[WORKLOAD_COLUMN_PID];
+    const int32_t *burst_time = map->columns[WORKLOAD_COLUMN_BURST_TIME];
+    const int32_t *priority = map->columns[WORKLOAD_COLUMN_PRIORITY];
+    const int32_t *arrival_time = map->columns[WORKLOAD_COLUMN_ARRIVAL_TIME];
+    for (int i = 0; i < n; i++)
+    {
+        Process *p = &rows[i];
+        memset(p, 0, sizeof(*p));
+        p->pid = pid[i];
+        p->burst_time = burst_time[i];
+        p->priority = priority[i];
+        p->arrival_time = arrival_time[i];
+        p->remaining_time = burst_time[i];
+        p->start_time = -1;
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Drops the mapped workload behind ctx, if any. The rows stay as they are.
+ */
+void release_mapped_input(SchedulerContext *ctx)
+{
+    if (ctx->mapped_input != NULL)
+    {
+        unmap_workload_file(ctx->mapped_input);
+        free(ctx->mapped_input);
+    }
+    ctx->mapped_input = NULL;
+    ctx->rows_pending = false;
+}
+
+/* ========================================================================================*/
+/* WRITING */
+/* ========================================================================================*/
+
+static uint64_t align_column(uint64_t offset)
+{
+    return (offset + WORKLOAD_COLUMN_ALIGNMENT - 1) / WORKLOAD_COLUMN_ALIGNMENT * WORKLOAD_COLUMN_ALIGNMENT;
+}
+
+/* ========================================================================================*/
+
+static int32_t column_value(const Process *p, int column)
+{
+    switch (column)
+    {
+    case WORKLOAD_COLUMN_PID:
+        return p->pid;
+    case WORKLOAD_COLUMN_BURST_TIME:
+        return p->burst_time;
+    case WORKLOAD_COLUMN_PRIORITY:
+        return p->priority;
+    default:
+        return p->arrival_time;
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Fills in a header for num_processes rows, laying the columns out one after
+ * the other at aligned offsets. Also used by writers that stream the columns.
+ */
+void init_workload_header(WorkloadFileHeader *header, uint64_t num_processes, uint32_t flags)
+{
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, WORKLOAD_MAGIC, WORKLOAD_MAGIC_SIZE);
+    header->version = WORKLOAD_FORMAT_VERSION;
+    header->byte_order = WORKLOAD_BYTE_ORDER_MARK;
+    header->flags = flags;
+    header->num_columns = WORKLOAD_NUM_COLUMNS;
+    header->num_processes = num_processes;
+
+    uint64_t offset = sizeof(*header);
+    for (int c = 0; c < WORKLOAD_NUM_COLUMNS; c++)
+    {
+        offset = align_column(offset);
+        header->column_offset[c] = offset;
+        offset += num_processes * sizeof(int32_t);
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Writes the workload in ctx to path. With sorted_by_arrival the rows are
+ * stored in arrival -> PID order, otherwise in input order.
+ */
+bool write_workload_file(const char *path, SchedulerContext *ctx, bool sorted_by_arrival)
+{
+    materialize_process_rows(ctx);
+    int n = ctx->num_processes;
+    const int *order = sorted_by_arrival ? get_arrival_order(ctx) : NULL;
+
+    WorkloadFileHeader header;
+    init_workload_header(&header, (uint64_t)n, sorted_by_arrival ? WORKLOAD_FLAG_SORTED_BY_ARRIVAL : 0);
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: Cannot create '%s': %s.\n", path, strerror(errno));
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    uint64_t written = sizeof(header);
+    int32_t *column = scheduler_alloc(n > 0 ? (size_t)n : 1, sizeof(int32_t));
+    static const char padding[WORKLOAD_COLUMN_ALIGNMENT];
+
+    for (int c = 0; ok && c < WORKLOAD_NUM_COLUMNS; c++)
+    {
+        size_t gap = (size_t)(header.column_offset[c] - written);
+        for (int i = 0; i < n; i++)
+        {
+            column[i] = column_value(&ctx->processes[order != NULL ? order[i] : i], c);
+        }
+        ok = fwrite(padding, 1, gap, file) == gap &&
+             fwrite(column, sizeof(int32_t), (size_t)n, file) == (size_t)n;
+        written = header.column_offset[c] + (uint64_t)n * sizeof(int32_t);
+    }
+    free(column);
+
+    if (fclose(file) != 0)
+    {
+        ok = false;
+    }
+    if (!ok)
+    {
+        fprintf(stderr, "Error: Failed to write '%s'.\n", path);
+    }
+    return ok;
+}
@@ -0,0 +1,86 @@
+/*
+ * ===============================================================================
+ * BINARY WORKLOAD FORMAT HEADER FILE
+ * ===============================================================================
+ *
+ * Versioned columnar file for the process input fields, so large traces are
+ * converted once and then memory-mapped instead of reparsed:
+ *
+ *   WorkloadFileHeader (64 bytes)
+ *   int32 pid[n]           | each column starts at column_offset[c], which is
+ *   int32 burst_time[n]    | a multiple of WORKLOAD_COLUMN_ALIGNMENT
+ *   int32 priority[n]      |
+ *   int32 arrival_time[n]  |
+ *
+ * Values are stored in the writer's native byte order; byte_order lets the
+ * loader reject files from a machine with the other order. With
+ * WORKLOAD_FLAG_SORTED_BY_ARRIVAL the rows are stored in arrival -> PID order
+ * and the loader can skip building the arrival index.
+ *
+ * A loaded mapping stays with its context: the engines' input columns are
+ * read from it (without a copy when the file is sorted), and the Process
+ * rows are only filled in for the consumers that need them, see
+ * materialize_process_rows().
+ *
+ * ===============================================================================
+ */
+
+#ifndef WORKLOAD_BINARY_H
+#define WORKLOAD_BINARY_H
+
+#include "CPU_scheduler.h"
+
+#define WORKLOAD_MAGIC "SCHEDWL"                 // 8 bytes including the terminator
+#define WORKLOAD_MAGIC_SIZE 8
+#define WORKLOAD_FORMAT_VERSION 1
+#define WORKLOAD_BYTE_ORDER_MARK 0x01020304u
+#define WORKLOAD_COLUMN_ALIGNMENT 64
+#define WORKLOAD_FLAG_SORTED_BY_ARRIVAL 0x1u
+
+/* ========================================================================================*/
+// Column identifiers (index into column_offset[])
+typedef enum
+{
+    WORKLOAD_COLUMN_PID,
+    WORKLOAD_COLUMN_BURST_TIME,
+    WORKLOAD_COLUMN_PRIORITY,
+    WORKLOAD_COLUMN_ARRIVAL_TIME,
+    WORKLOAD_NUM_COLUMNS
+} WorkloadColumn;
+
+/* ========================================================================================*/
+// On-disk file header
+typedef struct
+{
+    char magic[WORKLOAD_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t flags;
+    uint32_t num_columns;
+    uint64_t num_processes;
+    uint64_t column_offset[WORKLOAD_NUM_COLUMNS];
+} WorkloadFileHeader;
+
+/* ========================================================================================*/
+// A read-only mapping of a workload file
+typedef struct MappedWorkload
+{
+    void *base;
+    size_t length;
+    uint32_t flags;
+    int num_processes;
+    const int32_t *columns[WORKLOAD_NUM_COLUMNS];
+} MappedWorkload;
+
+/* ========================================================================================*/
+// Binary workload function prototypes
+bool is_workload_magic(const char *bytes, size_t length);
+bool map_workload_file(int fd, MappedWorkload *map);
+void unmap_workload_file(MappedWorkload *map);
+bool load_mapped_workload(MappedWorkload *map, SchedulerContext *ctx);
+void fill_mapped_rows(const MappedWorkload *map, Process *rows, int n);
+void release_mapped_input(SchedulerContext *ctx);
+void init_workload_header(WorkloadFileHeader *header, uint64_t num_processes, uint32_t flags);
+bool write_workload_file(const char *path, SchedulerContext *ctx, bool sorted_by_arrival);
+
+#endif // WORKLOAD_BINARY_H
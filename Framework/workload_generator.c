@@ -0,0 +1,547 @@
+/**
+ * ===============================================================================
+ * SYNTHETIC WORKLOAD GENERATOR
+ * ===============================================================================
+ * @file workload_generator.c
+ * @brief Seeded random workloads written as text or binary
+ *
+ * Rows are generated GENERATOR_CHUNK_ROWS at a time into four int32 columns.
+ * Text output formats a chunk into one buffer and writes it with fwrite();
+ * binary output writes each column slice straight to its final offset in the
+ * file, so neither path materializes the whole workload.
+ * ===============================================================================
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <unistd.h>
+#include "workload_generator.h"
+#include "workload_binary.h"
+
+#define GENERATOR_CHUNK_ROWS 65536
+#define TEXT_BUFFER_SIZE (1 << 20)
+#define MAX_ROW_LENGTH 48               // "P" + four int32 values, separators and the newline
+
+static const char TEXT_HEADER[] =
+    "Process     Burst Time     Priority    Arrival Time\n"
+    "======================================================\n";
+
+/* ========================================================================================*/
+// Structure to hold the generator state
+typedef struct
+{
+    const GeneratorConfig *config;
+    uint64_t state[4];                  // xoshiro256**
+    double clock;                       // Continuous arrival clock
+    bool busy_phase;                    // ARRIVAL_BURSTY
+    double phase_end;
+    double cumulative[GENERATOR_MAX_PRIORITIES];    // Normalized priority CDF
+    bool overflow;                      // An arrival time left the int range
+} Generator;
+
+/* ========================================================================================*/
+/* RANDOM NUMBERS */
+/* ========================================================================================*/
+
+static uint64_t splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/* ========================================================================================*/
+
+static uint64_t rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/* ========================================================================================*/
+
+static uint64_t next_random(Generator *g)
+{
+    uint64_t *s = g->state;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+/* ========================================================================================*/
+
+// Uniform in (0, 1), never 0 so it can go through log() and pow()
+static double next_uniform(Generator *g)
+{
+    return ((double)(next_random(g) >> 11) + 0.5) * 0x1.0p-53;
+}
+
+/* ========================================================================================*/
+
+static double next_exponential(Generator *g, double mean)
+{
+    return -log(next_uniform(g)) * mean;
+}
+
+/* ========================================================================================*/
+/* SAMPLING */
+/* ========================================================================================*/
+
+static void generator_init(Generator *g, const GeneratorConfig *config)
+{
+    memset(g, 0, sizeof(*g));
+    g->config = config;
+
+    uint64_t seed = config->seed;
+    for (int i = 0; i < 4; i++)
+    {
+        g->state[i] = splitmix64(&seed);
+    }
+
+    double total = 0.0;
+    for (int i = 0; i < config->num_priorities; i++)
+    {
+        total += config->priority_weights[i];
+    }
+    double sum = 0.0;
+    for (int i = 0; i < config->num_priorities; i++)
+    {
+        sum += config->priority_weights[i];
+        g->cumulative[i] = sum / total;
+    }
+    g->cumulative[config->num_priorities - 1] = 1.0;
+
+    if (config->arrival_model == ARRIVAL_BURSTY)
+    {
+        g->busy_phase = (next_random(g) & 1) != 0;
+        g->phase_end = next_exponential(g, config->phase_length);
+    }
+}
+
+/* ========================================================================================*/
+
+static int next_arrival(Generator *g)
+{
+    const GeneratorConfig *config = g->config;
+    if (config->arrival_model == ARRIVAL_POISSON)
+    {
+        g->clock += next_exponential(g, 1.0 / config->arrival_rate);
+    }
+    else
+    {
+        // Inter-arrival times are memoryless, so a gap that crosses the phase
+        // end is redrawn from the phase end at the new rate
+        for (;;)
+        {
+            double rate = g->busy_phase ? config->arrival_rate * config->burst_factor
+                                        : config->arrival_rate / config->burst_factor;
+            double time = g->clock + next_exponential(g, 1.0 / rate);
+            if (time < g->phase_end)
+            {
+                g->clock = time;
+                break;
+            }
+            g->clock = g->phase_end;
+            g->busy_phase = !g->busy_phase;
+            g->phase_end = g->clock + next_exponential(g, config->phase_length);
+        }
+    }
+
+    if (g->clock >= (double)INT_MAX)
+    {
+        g->overflow = true;
+        return INT_MAX;
+    }
+    return (int)g->clock;
+}
+
+/* ========================================================================================*/
+
+static int next_burst(Generator *g)
+{
+    const double *params = g->config->burst_params;
+    double burst;
+    switch (g->config->burst_model)
+    {
+    case BURST_EXPONENTIAL:
+        burst = next_exponential(g, params[0]);
+        break;
+    case BURST_PARETO:
+        burst = params[1] * pow(next_uniform(g), -1.0 / params[0]);
+        break;
+    default:
+        burst = next_exponential(g, (next_uniform(g) < params[2]) ? params[1] : params[0]);
+        break;
+    }
+
+    if (burst < 1.0)
+    {
+        return 1;
+    }
+    return (burst >= GENERATOR_MAX_BURST) ? GENERATOR_MAX_BURST : (int)(burst + 0.5);
+}
+
+/* ========================================================================================*/
+
+static int next_priority(Generator *g)
+{
+    double u = next_uniform(g);
+    int priority = 0;
+    while (u > g->cumulative[priority])
+    {
+        priority++;
+    }
+    return priority;
+}
+
+/* ========================================================================================*/
+
+// Fills rows first .. first + count - 1 of the workload
+static void generate_chunk(Generator *g, long long first, int count, int32_t *columns[WORKLOAD_NUM_COLUMNS])
+{
+    for (int i = 0; i < count; i++)
+    {
+        columns[WORKLOAD_COLUMN_PID][i] = (int32_t)(first + i + 1);
+        columns[WORKLOAD_COLUMN_ARRIVAL_TIME][i] = next_arrival(g);
+        columns[WORKLOAD_COLUMN_BURST_TIME][i] = next_burst(g);
+        columns[WORKLOAD_COLUMN_PRIORITY][i] = next_priority(g);
+    }
+}
+
+/* ========================================================================================*/
+/* OUTPUT */
+/* ========================================================================================*/
+
+static char *append_unsigned(char *out, uint32_t value)
+{
+    char digits[10];
+    int count = 0;
+    do
+    {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    while (count > 0)
+    {
+        *out++ = digits[--count];
+    }
+    return out;
+}
+
+/* ========================================================================================*/
+
+static bool write_text_chunk(FILE *output, char *buffer, int count, int32_t *columns[WORKLOAD_NUM_COLUMNS])
+{
+    char *out = buffer;
+    for (int i = 0; i < count; i++)
+    {
+        if (out - buffer > TEXT_BUFFER_SIZE - MAX_ROW_LENGTH)
+        {
+            if (fwrite(buffer, 1, (size_t)(out - buffer), output) != (size_t)(out - buffer))
+            {
+                return false;
+            }
+            out = buffer;
+        }
+        *out++ = 'P';
+        out = append_unsigned(out, (uint32_t)columns[WORKLOAD_COLUMN_PID][i]);
+        *out++ = ' ';
+        out = append_unsigned(out, (uint32_t)columns[WORKLOAD_COLUMN_BURST_TIME][i]);
+        *out++ = ' ';
+        out = append_unsigned(out, (uint32_t)columns[WORKLOAD_COLUMN_PRIORITY][i]);
+        *out++ = ' ';
+        out = append_unsigned(out, (uint32_t)columns[WORKLOAD_COLUMN_ARRIVAL_TIME][i]);
+        *out++ = '\n';
+    }
+    return fwrite(buffer, 1, (size_t)(out - buffer), output) == (size_t)(out - buffer);
+}
+
+/* ========================================================================================*/
+
+static bool write_all_at(int fd, const void *data, size_t length, uint64_t offset)
+{
+    const char *bytes = data;
+    while (length > 0)
+    {
+        ssize_t written = pwrite(fd, bytes, length, (off_t)offset);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        length -= (size_t)written;
+        offset += (uint64_t)written;
+    }
+    return true;
+}
+
+/* ========================================================================================*/
+/* CONFIGURATION */
+/* ========================================================================================*/
+
+/**
+ * Default models: poisson:0.5, exp:5 and five equally likely priorities, seed 1.
+ */
+void generator_config_init(GeneratorConfig *config)
+{
+    memset(config, 0, sizeof(*config));
+    config->seed = 1;
+    config->arrival_model = ARRIVAL_POISSON;
+    config->arrival_rate = 0.5;
+    config->burst_model = BURST_EXPONENTIAL;
+    config->burst_params[0] = 5.0;
+    config->num_priorities = 5;
+    for (int i = 0; i < config->num_priorities; i++)
+    {
+        config->priority_weights[i] = 1.0;
+    }
+}
+
+/* ========================================================================================*/
+
+bool parse_arrival_model(const char *spec, GeneratorConfig *config)
+{
+    char extra;
+    double rate, factor, phase;
+    if (sscanf(spec, "poisson:%lf%c", &rate, &extra) == 1 && rate > 0.0)
+    {
+        config->arrival_model = ARRIVAL_POISSON;
+        config->arrival_rate = rate;
+        return true;
+    }
+    if (sscanf(spec, "bursty:%lf:%lf:%lf%c", &rate, &factor, &phase, &extra) == 3 && rate > 0.0 &&
+        factor >= 1.0 && phase > 0.0)
+    {
+        config->arrival_model = ARRIVAL_BURSTY;
+        config->arrival_rate = rate;
+        config->burst_factor = factor;
+        config->phase_length = phase;
+        return true;
+    }
+    return false;
+}
+
+/* ========================================================================================*/
+
+bool parse_burst_model(const char *spec, GeneratorConfig *config)
+{
+    char extra;
+    double a, b, c;
+    if (sscanf(spec, "exp:%lf%c", &a, &extra) == 1 && a > 0.0)
+    {
+        config->burst_model = BURST_EXPONENTIAL;
+        config->burst_params[0] = a;
+        return true;
+    }
+    if (sscanf(spec, "pareto:%lf:%lf%c", &a, &b, &extra) == 2 && a > 0.0 && b > 0.0)
+    {
+        config->burst_model = BURST_PARETO;
+        config->burst_params[0] = a;
+        config->burst_params[1] = b;
+        return true;
+    }
+    if (sscanf(spec, "bimodal:%lf:%lf:%lf%c", &a, &b, &c, &extra) == 3 && a > 0.0 && b > 0.0 &&
+        c >= 0.0 && c <= 1.0)
+    {
+        config->burst_model = BURST_BIMODAL;
+        config->burst_params[0] = a;
+        config->burst_params[1] = b;
+        config->burst_params[2] = c;
+        return true;
+    }
+    return false;
+}
+
+/* ========================================================================================*/
+
+// Comma-separated weights of priorities 0, 1, ...; at least one must be positive
+bool parse_priority_weights(const char *spec, GeneratorConfig *config)
+{
+    double weights[GENERATOR_MAX_PRIORITIES];
+    double total = 0.0;
+    int count = 0;
+    const char *p = spec;
+
+    for (;;)
+    {
+        char *end = NULL;
+        double weight = strtod(p, &end);
+        if (end == p || !(weight >= 0.0) || count == GENERATOR_MAX_PRIORITIES)
+        {
+            return false;
+        }
+        weights[count++] = weight;
+        total += weight;
+        if (*end == '\0')
+        {
+            break;
+        }
+        if (*end != ',')
+        {
+            return false;
+        }
+        p = end + 1;
+    }
+    if (!(total > 0.0))
+    {
+        return false;
+    }
+
+    config->num_priorities = count;
+    memcpy(config->priority_weights, weights, (size_t)count * sizeof(double));
+    return true;
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+/**
+ * Generates config->num_processes rows straight into ctx, as if a generated
+ * binary file had been loaded (including the identity arrival order). Returns
+ * false on allocation failure or if the arrival times overflow.
+ */
+bool generate_processes(const GeneratorConfig *config, SchedulerContext *ctx)
+{
+    int n = (int)config->num_processes;
+    free(ctx->arrival_order);
+    ctx->arrival_order = NULL;
+    ctx->num_processes = 0;
+    if (!reserve_process_capacity(ctx, n > 0 ? n : 1))
+    {
+        return false;
+    }
+
+    Generator g;
+    generator_init(&g, config);
+    int32_t *storage = scheduler_alloc((size_t)WORKLOAD_NUM_COLUMNS * GENERATOR_CHUNK_ROWS, sizeof(int32_t));
+    int32_t *columns[WORKLOAD_NUM_COLUMNS];
+    for (int c = 0; c < WORKLOAD_NUM_COLUMNS; c++)
+    {
+        columns[c] = storage + (size_t)c * GENERATOR_CHUNK_ROWS;
+    }
+
+    for (int first = 0; first < n; first += GENERATOR_CHUNK_ROWS)
+    {
+        int count = min_value(n - first, GENERATOR_CHUNK_ROWS);
+        generate_chunk(&g, first, count, columns);
+        for (int i = 0; i < count; i++)
+        {
+            Process *p = &ctx->processes[first + i];
+            memset(p, 0, sizeof(*p));
+            p->pid = columns[WORKLOAD_COLUMN_PID][i];
+            p->burst_time = columns[WORKLOAD_COLUMN_BURST_TIME][i];
+            p->priority = columns[WORKLOAD_COLUMN_PRIORITY][i];
+            p->arrival_time = columns[WORKLOAD_COLUMN_ARRIVAL_TIME][i];
+            p->remaining_time = p->burst_time;
+        }
+    }
+    free(storage);
+    if (g.overflow)
+    {
+        return false;
+    }
+
+    ctx->num_processes = n;
+    if (n > 0)
+    {
+        ctx->arrival_order = scheduler_alloc((size_t)n, sizeof(int));
+        for (int i = 0; i < n; i++)
+        {
+            ctx->arrival_order[i] = i;
+        }
+    }
+    return true;
+}
+
+/* ========================================================================================*/
+/**
+ * Generates config->num_processes rows and writes them in the text format to
+ * text_output, or in the binary format to binary_path if it is not NULL.
+ * Returns false (after printing why) on a write error or if the arrival times
+ * do not fit the input format.
+ */
+bool generate_workload(const GeneratorConfig *config, FILE *text_output, const char *binary_path)
+{
+    Generator g;
+    generator_init(&g, config);
+
+    int32_t *storage = scheduler_alloc((size_t)WORKLOAD_NUM_COLUMNS * GENERATOR_CHUNK_ROWS, sizeof(int32_t));
+    int32_t *columns[WORKLOAD_NUM_COLUMNS];
+    for (int c = 0; c < WORKLOAD_NUM_COLUMNS; c++)
+    {
+        columns[c] = storage + (size_t)c * GENERATOR_CHUNK_ROWS;
+    }
+
+    bool ok = true;
+    long long n = config->num_processes;
+    if (binary_path == NULL)
+    {
+        char *buffer = scheduler_alloc(TEXT_BUFFER_SIZE, 1);
+        ok = fputs(TEXT_HEADER, text_output) >= 0;
+        for (long long first = 0; ok && first < n && !g.overflow; first += GENERATOR_CHUNK_ROWS)
+        {
+            int count = (int)((n - first < GENERATOR_CHUNK_ROWS) ? n - first : GENERATOR_CHUNK_ROWS);
+            generate_chunk(&g, first, count, columns);
+            ok = write_text_chunk(text_output, buffer, count, columns);
+        }
+        ok = (fflush(text_output) == 0) && ok;
+        free(buffer);
+        if (!ok)
+        {
+            fprintf(stderr, "Error: Failed to write the generated workload.\n");
+        }
+    }
+    else
+    {
+        WorkloadFileHeader header;
+        init_workload_header(&header, (uint64_t)n, WORKLOAD_FLAG_SORTED_BY_ARRIVAL);
+        uint64_t file_size = header.column_offset[WORKLOAD_NUM_COLUMNS - 1] + (uint64_t)n * sizeof(int32_t);
+
+        int fd = open(binary_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            fprintf(stderr, "Error: Cannot create '%s': %s.\n", binary_path, strerror(errno));
+            free(storage);
+            return false;
+        }
+
+        // The gaps between the columns are left as holes, which read as zero padding
+        ok = ftruncate(fd, (off_t)file_size) == 0 && write_all_at(fd, &header, sizeof(header), 0);
+        for (long long first = 0; ok && first < n && !g.overflow; first += GENERATOR_CHUNK_ROWS)
+        {
+            int count = (int)((n - first < GENERATOR_CHUNK_ROWS) ? n - first : GENERATOR_CHUNK_ROWS);
+            generate_chunk(&g, first, count, columns);
+            for (int c = 0; ok && c < WORKLOAD_NUM_COLUMNS; c++)
+            {
+                ok = write_all_at(fd, columns[c], (size_t)count * sizeof(int32_t),
+                                  header.column_offset[c] + (uint64_t)first * sizeof(int32_t));
+            }
+        }
+        ok = (close(fd) == 0) && ok;
+        if (!ok)
+        {
+            fprintf(stderr, "Error: Failed to write '%s'.\n", binary_path);
+        }
+    }
+    free(storage);
+
+    if (ok && g.overflow)
+    {
+        fprintf(stderr, "Error: Arrival times exceed the input range; use a higher arrival rate.\n");
+        ok = false;
+    }
+    return ok;
+}
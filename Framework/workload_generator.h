@@ -0,0 +1,78 @@
+/*
+ * ===============================================================================
+ * SYNTHETIC WORKLOAD GENERATOR HEADER FILE
+ * ===============================================================================
+ *
+ * Writes reproducible workloads of any size in the text input format or the
+ * binary format (see workload_binary.h). The same seed and models always give
+ * the same rows; the generator is xoshiro256** seeded through splitmix64.
+ *
+ * Arrival models (arrival times are the floor of a continuous process):
+ * - poisson:RATE                 steady load, RATE arrivals per time unit
+ * - bursty:RATE:FACTOR:PHASE     alternating busy / quiet phases with a mean
+ *                                length of PHASE time units and RATE * FACTOR
+ *                                resp. RATE / FACTOR arrivals per time unit
+ *
+ * Burst models (rounded to an integer in 1..GENERATOR_MAX_BURST):
+ * - exp:MEAN                     exponential
+ * - pareto:ALPHA:MIN             heavy-tailed, P(X > x) = (MIN / x)^ALPHA
+ * - bimodal:SHORT:LONG:FRACTION  exponential around SHORT, or around LONG for
+ *                                FRACTION of the jobs
+ *
+ * Priorities are drawn from 0..num_priorities-1 with the given weights.
+ *
+ * Rows come out in arrival order with increasing PIDs, so binary files carry
+ * WORKLOAD_FLAG_SORTED_BY_ARRIVAL. Rows are produced and written in chunks,
+ * so memory use does not depend on the workload size.
+ *
+ * ===============================================================================
+ */
+
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include "CPU_scheduler.h"
+
+#define GENERATOR_MAX_PRIORITIES 32
+#define GENERATOR_MAX_BURST (1 << 20)       // Keeps completion times of big workloads in int range
+
+/* ========================================================================================*/
+// Distribution families
+typedef enum
+{
+    ARRIVAL_POISSON,
+    ARRIVAL_BURSTY
+} ArrivalModel;
+
+typedef enum
+{
+    BURST_EXPONENTIAL,
+    BURST_PARETO,
+    BURST_BIMODAL
+} BurstModel;
+
+// Structure to hold the generator settings
+typedef struct
+{
+    long long num_processes;
+    uint64_t seed;
+    ArrivalModel arrival_model;
+    double arrival_rate;
+    double burst_factor;        // ARRIVAL_BURSTY: rate multiplier of the busy phase
+    double phase_length;        // ARRIVAL_BURSTY: mean phase length
+    BurstModel burst_model;
+    double burst_params[3];     // MEAN | ALPHA, MIN | SHORT, LONG, FRACTION
+    int num_priorities;
+    double priority_weights[GENERATOR_MAX_PRIORITIES];
+} GeneratorConfig;
+
+/* ========================================================================================*/
+// Generator function prototypes
+void generator_config_init(GeneratorConfig *config);
+bool parse_arrival_model(const char *spec, GeneratorConfig *config);
+bool parse_burst_model(const char *spec, GeneratorConfig *config);
+bool parse_priority_weights(const char *spec, GeneratorConfig *config);
+bool generate_workload(const GeneratorConfig *config, FILE *text_output, const char *binary_path);
+bool generate_processes(const GeneratorConfig *config, SchedulerContext *ctx);
+
+#endif // WORKLOAD_GENERATOR_H
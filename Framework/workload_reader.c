@@ -0,0 +1,283 @@
+/**
+ * ===============================================================================
+ * WORKLOAD TEXT READER
+ * ===============================================================================
+ * @file workload_reader.c
+ * @brief Block-buffered, hand-tokenized parser for process rows
+ *
+ * Replaces the per-line fgets + sscanf parsing: input is read with read() in
+ * READER_BLOCK_SIZE chunks and each row is tokenized in a single pass.
+ * ===============================================================================
+ */
+
+#include <errno.h>
+#include <unistd.h>
+#include "workload_reader.h"
+
+// The header and the separator line that precede the process rows
+#define HEADER_LINES 2
+
+/* ========================================================================================*/
+/* BUFFER MANAGEMENT */
+/* ========================================================================================*/
+
+void process_reader_init(ProcessReader *reader, int fd)
+{
+    reader->fd = fd;
+    reader->capacity = READER_BLOCK_SIZE;
+    reader->buffer = scheduler_alloc(reader->capacity, 1);
+    reader->start = 0;
+    reader->end = 0;
+    reader->eof = false;
+    reader->line_number = 0;
+}
+
+/* ========================================================================================*/
+
+void process_reader_free(ProcessReader *reader)
+{
+    free(reader->buffer);
+    reader->buffer = NULL;
+    reader->capacity = 0;
+}
+
+/* ========================================================================================*/
+/**
+ * Moves the unparsed tail to the front of the buffer (growing it when a single
+ * line fills the whole buffer) and reads the next block.
+ */
+static bool refill(ProcessReader *reader)
+{
+    size_t pending = reader->end - reader->start;
+    if (reader->start > 0)
+    {
+        memmove(reader->buffer, reader->buffer + reader->start, pending);
+        reader->start = 0;
+        reader->end = pending;
+    }
+    if (reader->end == reader->capacity)
+    {
+        char *grown = realloc(reader->buffer, reader->capacity * 2);
+        if (grown == NULL)
+        {
+            fprintf(stderr, "Error: Out of memory while reading line %ld.\n", reader->line_number + 1);
+            return false;
+        }
+        reader->buffer = grown;
+        reader->capacity *= 2;
+    }
+
+    for (;;)
+    {
+        ssize_t got = read(reader->fd, reader->buffer + reader->end, reader->capacity - reader->end);
+        if (got > 0)
+        {
+            reader->end += (size_t)got;
+            return true;
+        }
+        if (got == 0)
+        {
+            reader->eof = true;
+            return true;
+        }
+        if (errno != EINTR)
+        {
+            fprintf(stderr, "Error: Failed to read input: %s.\n", strerror(errno));
+            return false;
+        }
+    }
+}
+
+/* ========================================================================================*/
+/**
+ * Returns the next line in [*line, *line + *length) without its newline.
+ * Returns false at end of input; *failed is set on an I/O error.
+ */
+static bool next_line(ProcessReader *reader, const char **line, size_t *length, bool *failed)
+{
+    for (;;)
+    {
+        char *begin = reader->buffer + reader->start;
+        char *newline = memchr(begin, '\n', reader->end - reader->start);
+        if (newline != NULL)
+        {
+            *line = begin;
+            *length = (size_t)(newline - begin);
+            reader->start += *length + 1;
+            reader->line_number++;
+            return true;
+        }
+
+        if (reader->eof)
+        {
+            if (reader->start == reader->end)
+            {
+                return false;
+            }
+            // Last line without a trailing newline
+            *line = begin;
+            *length = reader->end - reader->start;
+            reader->start = reader->end;
+            reader->line_number++;
+            return true;
+        }
+
+        if (!refill(reader))
+        {
+            *failed = true;
+            return false;
+        }
+    }
+}
+
+/* ========================================================================================*/
+/* TOKENIZING */
+/* ========================================================================================*/
+
+static bool is_blank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/* ========================================================================================*/
+/**
+ * Blank lines and separator lines ('=' / '-' and whitespace only) carry no row.
+ */
+static bool is_skippable_line(const char *line, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        if (!is_blank(line[i]) && line[i] != '=' && line[i] != '-')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* ========================================================================================*/
+/**
+ * Parses one whitespace-delimited signed integer starting at *cursor.
+ */
+static bool parse_field(const char **cursor, const char *end, int *out)
+{
+    const char *p = *cursor;
+    while (p < end && is_blank(*p))
+    {
+        p++;
+    }
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    const char *digits = p;
+    long long value = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        value = value * 10 + (*p - '0');
+        if (value > (long long)INT_MAX + 1)
+        {
+            return false;
+        }
+        p++;
+    }
+
+    if (p == digits || (p < end && !is_blank(*p)))
+    {
+        return false;
+    }
+    if (negative)
+    {
+        value = -value;
+    }
+    if (value > INT_MAX || value < INT_MIN)
+    {
+        return false;
+    }
+
+    *out = (int)value;
+    *cursor = p;
+    return true;
+}
+
+/* ========================================================================================*/
+
+static bool parse_row(const char *line, size_t length, Process *out)
+{
+    const char *cursor = line;
+    const char *end = line + length;
+
+    while (cursor < end && is_blank(*cursor))
+    {
+        cursor++;
+    }
+    // Extract numeric part from 'P1' or read directly if it's just '1'
+    if (cursor < end && *cursor == 'P')
+    {
+        cursor++;
+    }
+
+    int pid, burst_time, priority, arrival_time;
+    if (!parse_field(&cursor, end, &pid) ||
+        !parse_field(&cursor, end, &burst_time) ||
+        !parse_field(&cursor, end, &priority) ||
+        !parse_field(&cursor, end, &arrival_time))
+    {
+        return false;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->pid = pid;
+    out->priority = priority;
+    out->burst_time = burst_time;
+    out->arrival_time = arrival_time;
+    out->remaining_time = burst_time;
+    return true;
+}
+
+/* ========================================================================================*/
+/* PUBLIC INTERFACE */
+/* ========================================================================================*/
+
+ReaderStatus process_reader_next(ProcessReader *reader, Process *out)
+{
+    const char *line;
+    size_t length;
+    bool failed = false;
+
+    while (next_line(reader, &line, &length, &failed))
+    {
+        // Skip the first two lines (header and separator)
+        if (reader->line_number <= HEADER_LINES)
+        {
+            continue;
+        }
+
+        // Only lines that start like a separator need the full skip check
+        size_t first = 0;
+        while (first < length && is_blank(line[first]))
+        {
+            first++;
+        }
+        if (first == length ||
+            ((line[first] == '=' || line[first] == '-') && is_skippable_line(line + first, length - first)))
+        {
+            continue;
+        }
+
+        if (!parse_row(line, length, out))
+        {
+            fprintf(stderr, "Error: Malformed process row at line %ld "
+                            "(expected 'PID Burst_Time Priority Arrival_Time').\n",
+                    reader->line_number);
+            return READER_ERROR;
+        }
+        return READER_ROW;
+    }
+
+    return failed ? READER_ERROR : READER_END;
+}
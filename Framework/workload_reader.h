@@ -0,0 +1,57 @@
+/*
+ * ===============================================================================
+ * WORKLOAD TEXT READER HEADER FILE
+ * ===============================================================================
+ *
+ * Streaming parser for the text workload format:
+ *
+ *   Process     Burst Time     Priority    Arrival Time     <- header (skipped)
+ *   ===========================================             <- separator (skipped)
+ *   P1          8              1           0
+ *   2           4              0           1                <- 'P' prefix optional
+ *
+ * Input is read in large blocks and integers are tokenized by hand. Blank and
+ * separator-only lines ('=', '-', whitespace) are skipped; any other row that
+ * is not "PID Burst Priority Arrival" is reported with its line number.
+ * Rows are pulled one at a time, so callers can also consume them online.
+ *
+ * ===============================================================================
+ */
+
+#ifndef WORKLOAD_READER_H
+#define WORKLOAD_READER_H
+
+#include "CPU_scheduler.h"
+
+// Size of one read() from the input
+#define READER_BLOCK_SIZE (1 << 20)
+
+/* ========================================================================================*/
+// Result of pulling one row
+typedef enum
+{
+    READER_ROW,     // *out holds the next process
+    READER_END,     // No more rows
+    READER_ERROR    // Malformed row or I/O error (already reported on stderr)
+} ReaderStatus;
+
+/* ========================================================================================*/
+// Structure to hold the reader state
+typedef struct
+{
+    int fd;                 // Input file descriptor
+    char *buffer;           // Unparsed input is buffer[start, end)
+    size_t capacity;
+    size_t start;
+    size_t end;
+    bool eof;
+    long line_number;       // Line number of the last line consumed
+} ProcessReader;
+
+/* ========================================================================================*/
+// Reader function prototypes
+void process_reader_init(ProcessReader *reader, int fd);
+void process_reader_free(ProcessReader *reader);
+ReaderStatus process_reader_next(ProcessReader *reader, Process *out);
+
+#endif // WORKLOAD_READER_H
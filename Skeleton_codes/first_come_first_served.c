@@ -28,11 +28,11 @@
  * ALGORITHM STEPS:
  * ----------------
  * 1. Reset all process states (use reset_process_states function)
- * 2. Sort processes by arrival time (apply tie-breaking rules)
- *    HINT: Create a LOCAL copy of processes array for sorting
- *          DO NOT modify the global ctx->processes array order
+ * 2. Get the arrival order (use get_arrival_order function)
+ *    It is sorted with the tie-breaking rules and computed once per workload
+ *    DO NOT modify the global ctx->processes array order
  * 3. Initialize current_time = 0
- * 4. For each process in sorted order:
+ * 4. For each process in arrival order:
  *    a. If CPU is idle (current_time < arrival_time), jump to arrival_time
  *    b. Execute the process: current_time += burst_time
  *    c. Record completion_time for this process
@@ -40,14 +40,14 @@
  * 
  * IMPLEMENTATION HINTS:
  * ---------------------
- * - Use bubble sort or selection sort for sorting processes
+ * - The arrival index is shared by all algorithms; never sort processes yourself
  * - Remember to handle CPU idle time between process arrivals
  * - Store completion_time in the ORIGINAL ctx->processes array
  * - The display_results function will calculate turnaround and waiting times
  * 
  * COMMON PITFALLS TO AVOID:
  * -------------------------
- * - Don't modify the global processes array order (use local copy)
+ * - Don't modify the global processes array order (use the arrival index)
  * - Don't calculate waiting_time or turnaround_time directly
  * - Don't forget to handle CPU idle periods
  * - Ensure tie-breaking follows: arrival_time → pid
@@ -56,6 +56,8 @@
  */
 
 #include "CPU_scheduler.h"
+#include "sched_stats.h"
+#include "trace_recorder.h"
 
 /* ========================================================================================*/
 /**
@@ -72,70 +74,37 @@ void first_come_first_served(SchedulerContext *ctx)
     // Step 1: Reset all process states to initial values
     reset_process_states(ctx);
 
-    // Step 2: Create a LOCAL copy of processes for sorting
-    // IMPORTANT: Do NOT modify ctx->processes array order directly
-    Process local_processes[MAX_PROCESSES];
-    // TODO: Copy all processes from ctx->processes to local_processes
-    for (int i = 0; i < ctx->num_processes; i++){
-        local_processes[i] = ctx->processes[i];
-    }
-    
-    // Step 3: Sort LOCAL copy by arrival time, then by PID for tie-breaking
-    // TODO: Implement sorting logic
-    // HINT: Use nested loops for bubble sort or selection sort  
-    for (int i = 0; i <ctx->num_processes - 1; i++){
-        for(int j = i + 1; j < ctx->num_processes; j++){
-            int swap = 0;
-
-            if (local_processes[j].arrival_time < local_processes[i].arrival_time) {
-                swap = 1;
-            }
-            // PID if arrival_time is equal
-            else if (local_processes[j].arrival_time == local_processes[i].arrival_time &&
-                     local_processes[j].pid < local_processes[i].pid) {
-                swap = 1;
-            }
-
-            if (swap) {
-                Process temp = local_processes[i];
-                local_processes[i] = local_processes[j];
-                local_processes[j] = temp;
-            }
-        }
-    }
+    // Step 2: Walk the shared arrival index (arrival_time → pid)
+    // IMPORTANT: ctx->processes keeps its original order
+    const int *arrival_order = get_arrival_order(ctx);
 
-    // Step 4: Execute processes in FCFS order
-    int current_time = 0;
+    // Step 3: Execute processes in FCFS order
+    long long current_time = 0;
 
     for (int i = 0; i < ctx->num_processes; i++)
     {
-        // TODO: Handle CPU idle time if needed        
-        Process  *p = &local_processes[i];
+        STATS_COUNT(STAT_LOOP_ITERATIONS);
+        Process *p = &ctx->processes[arrival_order[i]];
+
+        // Handle CPU idle time if needed
         if (current_time < p->arrival_time) {
+            STATS_COUNT(STAT_IDLE_JUMPS);
             current_time = p->arrival_time;
         }
 
-        // TODO: Calculate completion time for this process       
-        int completion_time = current_time + p->burst_time;
-
-        // TODO: Find the corresponding process in the GLOBAL array (ctx->processes)
-        //       and update its completion_time
-        // HINT: Search by PID to find the correct process
-        for (int g = 0; g < ctx->num_processes; g++) {
-            if (ctx->processes[g].pid == p->pid) {
-                ctx->processes[g].completion_time = completion_time;
-                // if your struct tracks start_time / waiting_time you could set them here too
-                break;
-            }
-        }
-
-        // TODO: Move current_time forward
-        current_time = completion_time;
-        
+        // Run to completion (after the switch to it) and record it in the GLOBAL array
+        current_time += charge_context_switch(ctx, false);
+        p->start_time = current_time;
+        TRACE_POINT(ctx, TRACE_DISPATCH, p->pid, current_time);
+        STATS_COUNT(STAT_DISPATCHES);
+        current_time += p->burst_time;
+        p->completion_time = current_time;
+        p->is_completed = true;
+        TRACE_POINT(ctx, TRACE_COMPLETE, p->pid, current_time);
     }
 
-    // Step 5: Display results (this function is already implemented)
-    display_results(ctx, "First-Come-First-Served (FCFS)");
+    // Step 4: Display results (this function is already implemented)
+    display_results(ctx, SCHEDULER_ALGORITHMS[ALGORITHM_FCFS].title);
 }
 
 /* ========================================================================================*/
@@ -148,7 +117,7 @@ void first_come_first_served(SchedulerContext *ctx)
  * 
  * DEBUGGING TIPS:
  * ---------------
- * - Print the sorted order to verify correct sorting
+ * - Print the arrival order to verify correct tie-breaking
  * - Print current_time and completion_time for each process
  * - Verify that completion times match expected values
  * - Check if CPU idle time is handled correctly
@@ -55,9 +55,9 @@
  * 
  * IMPLEMENTATION HINTS:
  * ---------------------
- * - Use a loop to search for the process with minimum priority number
+ * - Keep arrived processes in a min-heap (see ready_heap.h) instead of rescanning
  * - Remember: Lower number = Higher priority (Priority 1 > Priority 5)
- * - Check if process has arrived and is not completed
+ * - Push processes as they arrive and pop the root to select the next one
  * - Apply tie-breaking carefully when priorities are equal
  * - Handle CPU idle time when no process is ready
  * 
@@ -73,6 +73,11 @@
  */
 
 #include "CPU_scheduler.h"
+#include "ready_heap.h"
+#include "ready_scan.h"
+#include "scheduler_scratch.h"
+#include "sched_stats.h"
+#include "trace_recorder.h"
 
 /* ========================================================================================*/
 /**
@@ -84,6 +89,10 @@
  * At each scheduling decision, it selects the process with the highest priority
  * (lowest priority number) among all arrived processes. The selected process
  * runs to completion without preemption.
+ *
+ * Arrived processes are kept in a min-heap ordered by priority → arrival_time → pid,
+ * fed from a cursor over the rank-ordered columns (see process_columns.h), so each
+ * decision costs O(log n) and sifting never touches the Process records.
  */
 void priority_non_preemptive(SchedulerContext *ctx)
 {
@@ -91,97 +100,74 @@ void priority_non_preemptive(SchedulerContext *ctx)
     reset_process_states(ctx);
 
     // Step 2: Initialize variables
+    int n = ctx->num_processes;
     int completed = 0;                           // Count of completed processes
-    int current_time = 0;                        // Current time in the simulation
-    bool is_completed[MAX_PROCESSES] = {false};  // Track which processes are completed
+    long long current_time = 0;                  // Current time in the simulation
+    int next_arrival = 0;                        // Cursor into the arrival ranks
 
-    // Step 3: Main scheduling loop
-    while (completed < ctx->num_processes)
+    // Kernels work on rank-ordered columns (see process_columns.h)
+    ProcessColumns local_columns;
+    ProcessColumns *cols = acquire_process_columns(ctx, &local_columns);
+
+    // Small workloads are scheduled by scanning the columns (see ready_scan.h)
+    bool use_heap = (n > READY_SCAN_MAX_PROCESSES);
+    int first_incomplete = 0;                    // Ranks below it are all complete
+    ReadyHeap ready;
+    if (use_heap)
     {
-        int best_idx = -1;  // Index of the process with highest priority (lowest priority number)
+        acquire_ready_heap(ctx, &ready, n);
+    }
 
-        // Step 4: Select the process with highest priority (lowest priority number) that has arrived
-        // TODO: Loop through all processes
-        for (int i = 0; i < ctx->num_processes; i++)
+    // Step 3: Main scheduling loop
+    while (completed < n)
+    {
+        STATS_COUNT(STAT_LOOP_ITERATIONS);
+        // Step 4: Admit every process that has arrived by current_time
+        while (next_arrival < n && cols->arrival_time[next_arrival] <= current_time)
         {
-            Process *p = &ctx->processes[i];
-
-            // TODO: Check if process has arrived and is not completed   
-            if(!is_completed[i] && p->arrival_time <= current_time){
-                if(best_idx == -1){
-                    best_idx = i;
-                }else{
-                    Process *best = &ctx->processes[best_idx];
-          
-            // TODO: Apply tie-breaking logic to select the best process
-                // TIE-BREAKING ORDER: priority (lower is better) → arrival_time → pid
-                 if (p->priority < best->priority)
-                    {
-                        best_idx = i;
-                    }
-                    else if (p->priority == best->priority)
-                    {
-                        if (p->arrival_time < best->arrival_time)
-                        {
-                            best_idx = i;
-                        }
-                        else if (p->arrival_time == best->arrival_time)
-                        {
-                            if (p->pid < best->pid)
-                            {
-                                best_idx = i;
-                            }
-                        }
-                    }
-                  }
+            if (use_heap)
+            {
+                ready_heap_push(&ready, next_arrival, cols->priority[next_arrival], next_arrival);
             }
+            next_arrival++;
         }
 
-        // Step 5: Handle the selected process or CPU idle time
-        if (best_idx == -1)
+        // Step 5: Select the next process or handle CPU idle time
+        while (first_incomplete < next_arrival && cols->remaining_time[first_incomplete] == 0)
         {
-            // No process is ready - CPU idle, jump to next arrival
-            // TODO: Find the next arrival time among incomplete processes
-            // HINT: Loop through all processes to find minimum arrival_time > current_time
-            int next_arrival = INT_MAX;
-             for (int i = 0; i < ctx->num_processes; i++)
-            {
-                if (!is_completed[i] && ctx->processes[i].arrival_time > current_time)
-                {
-                    if (ctx->processes[i].arrival_time < next_arrival)
-                    {
-                        next_arrival = ctx->processes[i].arrival_time;
-                    }
-                }
-            }
-            
-            
-            // TODO: Jump current_time to next_arrival
-             if (next_arrival != INT_MAX)
-            {
-                current_time = next_arrival;
-            }
+            first_incomplete++;
         }
-        else
+        int rank = use_heap ? ready_heap_pop(&ready)
+                            : ready_scan_argmin(cols->priority, cols->remaining_time, first_incomplete, next_arrival);
+        if (rank < 0)
         {
-            // Execute the selected process to completion (non-preemptive)
-            // TODO: Update current_time by adding burst_time of selected process
-            current_time += ctx->processes[best_idx].burst_time;
-            
-            // TODO: Record the completion_time for this process
-            // HINT: ctx->processes[best_idx].completion_time = current_time;
-            ctx->processes[best_idx].completion_time = current_time;
-            
-            // TODO: Mark this process as completed
-            is_completed[best_idx] = true;
-            
-            // TODO: Increment the completed counter
-            completed++;
+            // No process is ready - CPU idle, jump to the next arrival
+            STATS_COUNT(STAT_IDLE_JUMPS);
+            current_time = cols->arrival_time[next_arrival];
+            continue;
         }
+
+        // Execute the selected process to completion (non-preemptive)
+        current_time += charge_context_switch(ctx, false);
+        cols->start_time[rank] = current_time;
+        TRACE_POINT(ctx, TRACE_DISPATCH, ctx->processes[cols->order[rank]].pid, current_time);
+        STATS_COUNT(STAT_DISPATCHES);
+        current_time += cols->remaining_time[rank];
+        cols->remaining_time[rank] = 0;
+        cols->completion_time[rank] = current_time;
+        completed++;
+        TRACE_POINT(ctx, TRACE_COMPLETE, ctx->processes[cols->order[rank]].pid, current_time);
+    }
+
+    if (use_heap)
+    {
+        release_ready_heap(ctx, &ready);
     }
+    process_columns_store(cols, ctx);
+    release_process_columns(ctx, cols);
 
     // Step 6: Display results
-    display_results(ctx, "PRIORITY_NON_PREEMPTIVE");
+    display_results(ctx, SCHEDULER_ALGORITHMS[ALGORITHM_PRIORITY_NP].title);
 }
 
 /* ========================================================================================*/
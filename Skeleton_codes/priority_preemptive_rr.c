@@ -45,8 +45,8 @@
  * 1. Reset all process states
  * 2. Initialize current_time = 0, completed = 0
  * 3. Main scheduling loop (while completed < num_processes):
- *    a. Find the highest priority (minimum priority number) among arrived processes
- *    b. Collect all processes with that highest priority into ready_processes array
+ *    a. Admit arrived processes into their per-priority FIFO bucket
+ *    b. Find the highest non-empty priority level (find-first-set on the bitmap)
  *    c. If no processes ready:
  *       - CPU is idle, jump to next arrival
  *    d. If processes ready:
@@ -61,13 +61,13 @@
  * PREEMPTION RULES:
  * -----------------
  * - Preemption occurs when a process with HIGHER priority (lower number) arrives
- * - Preemption is checked during execution (time unit by time unit)
+ * - Preemption is checked against the next pending arrivals within the slice
  * - When preempted, the current process is suspended until its priority is highest again
  * 
  * IMPLEMENTATION HINTS:
  * ---------------------
- * - Execute time unit by time unit to check for preemptions
- * - Maintain a list of processes at the current highest priority level
+ * - Stop a slice early at the first higher priority arrival inside it
+ * - Maintain one FIFO list per priority level (see priority_buckets.h)
  * - Use Round Robin rotation only among processes with same priority
  * - After executing one process, re-evaluate priorities (new arrivals may change highest)
  * - Use min_value() helper function for calculating execution time
@@ -84,6 +84,9 @@
  */
 
 #include "CPU_scheduler.h"
+#include "scheduler_scratch.h"
+#include "sched_stats.h"
+#include "trace_recorder.h"
 
 /* ========================================================================================*/
 /**
@@ -94,6 +97,12 @@
  * 
  * This function implements priority-based preemptive scheduling with Round Robin
  * used for tie-breaking when multiple processes have the same priority.
+ *
+ * Arrived processes live in per-priority FIFO buckets (see priority_buckets.h), kept
+ * in arrival → pid order. Each RR cycle visits the members of the highest non-empty
+ * level that were present when the cycle started; processes of the same priority
+ * arriving mid-cycle join the next cycle. A slice runs until the quantum expires, the
+ * process completes, or the next pending arrival has a higher priority.
  */
 void priority_preemptive_rr(SchedulerContext *ctx, int time_quantum)
 {
@@ -103,103 +112,98 @@ void priority_preemptive_rr(SchedulerContext *ctx, int time_quantum)
 
     reset_process_states(ctx);
 
-    int current_time = 0;
+    long long current_time = 0;
     int completed = 0;
     int n = ctx->num_processes;
+    int next_arrival = 0;
+    int last_run = -1;                           // Rank that held the CPU last
+    int *level = NULL;
 
-    for (int i = 0; i < n; i++) {
-        ctx->processes[i].remaining_time = ctx->processes[i].burst_time;
-    }
+    // Buckets hold arrival ranks; level[] is indexed by rank as well
+    ProcessColumns local_columns;
+    ProcessColumns *cols = acquire_process_columns(ctx, &local_columns);
+    const int *arrival = cols->arrival_time;
+    int *remaining = cols->remaining_time;
+    PriorityBuckets local_buckets;
+    PriorityBuckets *ready = acquire_priority_buckets(ctx, cols, &local_buckets, &level);
 
     while (completed < n) {
 
-        int highest_priority = INT_MAX;
-        int ready_processes[MAX_PROCESSES];
-        int ready_count = 0;
-
-        for (int i = 0; i < n; i++) {
-            Process *p = &ctx->processes[i];
-            if (p->arrival_time <= current_time && p->remaining_time > 0) {
-                if (p->priority < highest_priority) {
-                    highest_priority = p->priority;
-                    ready_count = 0;
-                    ready_processes[ready_count++] = i;
-                } else if (p->priority == highest_priority) {
-                    ready_processes[ready_count++] = i;
-                }
-            }
+        // Admit everything that has arrived by now into its priority bucket
+        while (next_arrival < n && arrival[next_arrival] <= current_time) {
+            priority_buckets_push_back(ready, level[next_arrival], next_arrival);
+            next_arrival++;
         }
 
-        if (ready_count == 0) {
-            int next_arrival = INT_MAX;
-            for (int i = 0; i < n; i++) {
-                Process *p = &ctx->processes[i];
-                if (p->remaining_time > 0 &&
-                    p->arrival_time > current_time &&
-                    p->arrival_time < next_arrival) {
-                    next_arrival = p->arrival_time;
-                }
-            }
-
-            if (next_arrival == INT_MAX) {
-                break;
-            }
-
-            current_time = next_arrival;
+        int highest_level = priority_buckets_first_level(ready);
+        if (highest_level == -1) {
+            STATS_COUNT(STAT_LOOP_ITERATIONS);
+            STATS_COUNT(STAT_IDLE_JUMPS);
+            current_time = arrival[next_arrival];
             continue;
         }
 
+        // One RR cycle over the members present at the start of the cycle
+        int rank = ready->head[highest_level];
+        int cycle_end = ready->tail[highest_level];
         bool higher_priority_arrived = false;
 
-        for (int r = 0; r < ready_count && completed < n; r++) {
-            int idx = ready_processes[r];
-            Process *p = &ctx->processes[idx];
+        while (!higher_priority_arrived) {
+            STATS_COUNT(STAT_LOOP_ITERATIONS);    // One event per slice, not per cycle
+            int following = ready->next[rank];
+            bool last_in_cycle = (rank == cycle_end);
 
-            if (p->remaining_time <= 0) {
-                continue;
+            // A process that gets consecutive slices is not switched again
+            if (rank != last_run) {
+                current_time += charge_context_switch(ctx, cols->start_time[rank] >= 0);
+                last_run = rank;
             }
-            int time_to_execute = (p->remaining_time < time_quantum)
-                                  ? p->remaining_time
-                                  : time_quantum;
-
-            for (int t = 0; t < time_to_execute; t++) {
-                current_time += 1;
-                p->remaining_time -= 1;
 
-                if (p->remaining_time == 0) {
-                    p->completion_time = current_time;
-                    completed++;
-                }
-
-                for (int j = 0; j < n; j++) {
-                    Process *q = &ctx->processes[j];
-                    if (q->arrival_time == current_time &&
-                        q->remaining_time > 0 &&
-                        q->priority < highest_priority) {
-                      
-                        higher_priority_arrived = true;
-                        break;
-                    }
-                }
+            int time_to_execute = min_value(remaining[rank], time_quantum);
+            long long slice_end = current_time + time_to_execute;
 
-                if (higher_priority_arrived) {
-                    break; 
+            // Only the next pending arrivals can preempt; admit lower/equal ones on the way.
+            // A higher priority arrival during the switch preempts before any work is done.
+            while (next_arrival < n && arrival[next_arrival] <= slice_end) {
+                if (level[next_arrival] < highest_level) {
+                    slice_end = (arrival[next_arrival] > current_time) ? arrival[next_arrival] : current_time;
+                    higher_priority_arrived = true;
+                    break;
                 }
+                priority_buckets_push_back(ready, level[next_arrival], next_arrival);
+                next_arrival++;
+            }
 
-                if (p->remaining_time == 0) {
-                    break; 
-                }
+            if (cols->start_time[rank] < 0 && slice_end > current_time) {
+                cols->start_time[rank] = current_time;
             }
+            TRACE_POINT(ctx, TRACE_DISPATCH, ctx->processes[cols->order[rank]].pid, current_time);
+            STATS_COUNT(STAT_DISPATCHES);
+            remaining[rank] -= (int)(slice_end - current_time);
+            current_time = slice_end;
 
+            if (remaining[rank] == 0) {
+                cols->completion_time[rank] = current_time;
+                priority_buckets_remove(ready, highest_level, rank);
+                completed++;
+                TRACE_POINT(ctx, TRACE_COMPLETE, ctx->processes[cols->order[rank]].pid, current_time);
+            } else {
+                TRACE_POINT(ctx, TRACE_PREEMPT, ctx->processes[cols->order[rank]].pid, current_time);
+                STATS_COUNT(STAT_PREEMPTIONS);
+            }
 
-            if (higher_priority_arrived) {
+            if (last_in_cycle) {
                 break;
             }
+            rank = following;
         }
-    
     }
 
-    display_results(ctx, "PRIORITY_PREEMPTIVE_WITH_RR");
+    release_priority_buckets(ctx, ready, level);
+    process_columns_store(cols, ctx);
+    release_process_columns(ctx, cols);
+
+    display_results(ctx, SCHEDULER_ALGORITHMS[ALGORITHM_PRIORITY_RR].title);
 }
 
 /* ========================================================================================*/
@@ -30,7 +30,7 @@
  * ALGORITHM STEPS:
  * ----------------
  * 1. Reset all process states
- * 2. Sort processes by arrival time (then by PID for tie-breaking)
+ * 2. Get the rank-ordered columns (arrival time, then PID) with acquire_process_columns
  * 3. Initialize ready queue (circular queue) and tracking arrays
  * 4. Enqueue all processes that arrive at time 0
  * 5. Main scheduling loop (while not all processes completed):
@@ -55,9 +55,9 @@
  *
  * IMPLEMENTATION HINTS:
  * ---------------------
- * - Implement a circular queue with enqueue/dequeue operations
- * - Use a boolean array to track which processes are already in the queue
- * - Track remaining_time for each process separately
+ * - Use the growable ring buffer queue (see ring_queue.h)
+ * - Admit arrivals through a cursor into the arrival order (each exactly once)
+ * - Track remaining_time in each process's remaining_time field
  * - Handle CPU idle time when queue becomes empty
  * - Execute process time unit by time unit OR for entire quantum at once
  *
@@ -67,81 +67,29 @@
  * - Remember to check for new arrivals AFTER executing each time slice
  * - Re-enqueue preempted process AFTER adding newly arrived processes
  * - Don't forget to handle CPU idle periods
- * - Ensure processes are sorted before starting
+ * - Walk processes in arrival order without reordering ctx->processes
  *
  * ===============================================================================
  */
 
 #include "CPU_scheduler.h"
+#include "scheduler_scratch.h"
+#include "sched_stats.h"
+#include "trace_recorder.h"
 
-#define QUEUE_MAX 1000  // Maximum size for circular queue
-
-/* ===============================================================================
- * CIRCULAR QUEUE IMPLEMENTATION
- * ===============================================================================
- * A circular queue is needed to manage the ready queue in Round Robin.
- * This provides FIFO (First-In-First-Out) behavior with efficient wrap-around.
- */
-/*
- * ROUND ROBIN (RR) SCHEDULING ALGORITHM
+/* ========================================================================================*/
+/**
+ * @brief Round Robin (RR) Scheduling Algorithm
+ *
+ * @param ctx Pointer to the scheduler context containing all process information
+ * @param time_quantum Time slice each process gets per turn
+ *
+ * The ready queue is a growable ring buffer (see ring_queue.h), reused from
+ * ctx->scratch when one is attached. New arrivals are
+ * admitted through a monotonic cursor over the rank-ordered columns (see
+ * process_columns.h), so each process is enqueued on arrival exactly once and a
+ * slice costs O(new arrivals) instead of a scan over all processes.
  */
-
-#include "CPU_scheduler.h"
-#include <limits.h>
-#include <stdbool.h>
-
-#define QUEUE_MAX 1000  // Maximum size for circular queue
-
-/* =========================================================================
- * CIRCULAR QUEUE
- * ========================================================================= */
-typedef struct {
-    int items[QUEUE_MAX];
-    int front, rear;
-} Queue;
-
-static void init_queue(Queue *q) {
-    q->front = -1;
-    q->rear  = -1;
-}
-
-static bool is_empty(Queue *q) {
-    return (q->front == -1);
-}
-
-static void enqueue(Queue *q, int pid) {
-    if ((q->rear + 1) % QUEUE_MAX == q->front) {
-        return;
-    }
-
-    if (is_empty(q)) {
-        q->front = q->rear = 0;
-        q->items[q->rear] = pid;
-    } else {
-        q->rear = (q->rear + 1) % QUEUE_MAX;
-        q->items[q->rear] = pid;
-    }
-}
-
-static int dequeue(Queue *q) {
-    if (is_empty(q)) {
-        return -1;
-    }
-
-    int item = q->items[q->front];
-
-    if (q->front == q->rear) {
-        q->front = q->rear = -1;
-    } else {
-        q->front = (q->front + 1) % QUEUE_MAX;
-    }
-
-    return item;
-}
-
-/* =========================================================================
- * ROUND ROBIN
- * ========================================================================= */
 void round_robin(SchedulerContext *ctx, int time_quantum)
 {
     if (time_quantum <= 0 || ctx->num_processes <= 0)
@@ -149,108 +97,67 @@ void round_robin(SchedulerContext *ctx, int time_quantum)
     reset_process_states(ctx);
 
     int n = ctx->num_processes;
-    int time = 0;
+    long long time = 0;
     int completed = 0;
+    int next_arrival = 0;
 
-    int remaining_time[MAX_PROCESSES];
-    bool is_completed[MAX_PROCESSES]   = {false};
-    bool in_ready_queue[MAX_PROCESSES] = {false};
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = 0; j < n - 1 - i; j++) {
-            Process *a = &ctx->processes[j];
-            Process *b = &ctx->processes[j + 1];
-            bool swap = false;
+    ProcessColumns local_columns;
+    ProcessColumns *cols = acquire_process_columns(ctx, &local_columns);
 
-            if (a->arrival_time > b->arrival_time) {
-                swap = true;
-            } else if (a->arrival_time == b->arrival_time &&
-                       a->pid > b->pid) {
-                swap = true;
-            }
-
-            if (swap) {
-                Process tmp = *a;
-                *a = *b;
-                *b = tmp;
-            }
-        }
-    }
-
-    for (int i = 0; i < n; i++) {
-        remaining_time[i] = ctx->processes[i].burst_time;
-    }
-
-    Queue q;
-    init_queue(&q);
-
-    for (int i = 0; i < n; i++) {
-        if (ctx->processes[i].arrival_time == 0) {
-            enqueue(&q, i);
-            in_ready_queue[i] = true;
-        }
-    }
+    RingQueue local_queue;
+    RingQueue *q = acquire_ready_queue(ctx, &local_queue);
+    int last_run = -1;                           // Rank that held the CPU last
 
     while (completed < n) {
+        STATS_COUNT(STAT_LOOP_ITERATIONS);
 
-        if (is_empty(&q)) {
-            int next_arrival_time = INT_MAX;
-
-            for (int i = 0; i < n; i++) {
-                if (!is_completed[i] &&
-                    ctx->processes[i].arrival_time > time &&
-                    ctx->processes[i].arrival_time < next_arrival_time) {
-                    next_arrival_time = ctx->processes[i].arrival_time;
-                }
-            }
-
-            if (next_arrival_time != INT_MAX) {
-                time = next_arrival_time;
-                for (int i = 0; i < n; i++) {
-                    if (!is_completed[i] &&
-                        ctx->processes[i].arrival_time == time &&
-                        !in_ready_queue[i]) {
-                        enqueue(&q, i);
-                        in_ready_queue[i] = true;
-                    }
-                }
-                continue;
-            } else {
-                break;
-            }
+        // Admit every process that has arrived by now (ranks are arrival_time → pid order)
+        while (next_arrival < n && cols->arrival_time[next_arrival] <= time) {
+            ring_queue_push(q, next_arrival++);
         }
 
-        int idx = dequeue(&q);
-        in_ready_queue[idx] = false;
+        if (ring_queue_is_empty(q)) {
+            // CPU idle: jump to the next arrival
+            STATS_COUNT(STAT_IDLE_JUMPS);
+            time = cols->arrival_time[next_arrival];
+            continue;
+        }
 
-        Process *p = &ctx->processes[idx];
-        int exec_time = (remaining_time[idx] < time_quantum)
-                        ? remaining_time[idx]
-                        : time_quantum;
+        int rank = ring_queue_pop(q);
+        int exec_time = min_value(cols->remaining_time[rank], time_quantum);
 
-        int start_time = time;
+        // A process that gets consecutive slices is not switched again
+        if (rank != last_run) {
+            time += charge_context_switch(ctx, cols->start_time[rank] >= 0);
+            last_run = rank;
+        }
+        if (cols->start_time[rank] < 0) {
+            cols->start_time[rank] = time;
+        }
+        TRACE_POINT(ctx, TRACE_DISPATCH, ctx->processes[cols->order[rank]].pid, time);
+        STATS_COUNT(STAT_DISPATCHES);
         time += exec_time;
-        remaining_time[idx] -= exec_time;
+        cols->remaining_time[rank] -= exec_time;
 
-        for (int i = 0; i < n; i++) {
-            if (!is_completed[i] &&
-                !in_ready_queue[i] &&
-                ctx->processes[i].arrival_time > start_time &&
-                ctx->processes[i].arrival_time <= time) {
-                enqueue(&q, i);
-                in_ready_queue[i] = true;
-            }
+        // Processes that arrived during the switch or slice go ahead of the preempted one
+        while (next_arrival < n && cols->arrival_time[next_arrival] <= time) {
+            ring_queue_push(q, next_arrival++);
         }
 
-        if (remaining_time[idx] == 0) {
-            is_completed[idx] = true;
+        if (cols->remaining_time[rank] == 0) {
             completed++;
-            p->completion_time = time;
+            cols->completion_time[rank] = time;
+            TRACE_POINT(ctx, TRACE_COMPLETE, ctx->processes[cols->order[rank]].pid, time);
         } else {
-            enqueue(&q, idx);
-            in_ready_queue[idx] = true;
+            ring_queue_push(q, rank);
+            TRACE_POINT(ctx, TRACE_PREEMPT, ctx->processes[cols->order[rank]].pid, time);
+            STATS_COUNT(STAT_PREEMPTIONS);
         }
     }
-    display_results(ctx, "Round-Robin (RR)");
+    process_columns_store(cols, ctx);
+    release_process_columns(ctx, cols);
+    release_ready_queue(ctx, q);
+    display_results(ctx, SCHEDULER_ALGORITHMS[ALGORITHM_RR].title);
 }
 
 
@@ -15,7 +15,7 @@
  * - Preemptive: Processes can be interrupted when a shorter job arrives
  * - Optimal for minimizing average waiting time
  * - Can cause starvation for longer processes
- * - Executes in time units (check for preemption at each unit)
+ * - Event-driven: preemption can only happen when a new process arrives
  * - More responsive than non-preemptive SJF
  * 
  * TIE-BREAKING RULE:
@@ -42,9 +42,9 @@
  *       - CPU is idle
  *       - Jump to next arrival time
  *    c. If process found:
- *       - Execute for 1 time unit (preemptive scheduling)
- *       - Decrement remaining_time
- *       - Increment current_time
+ *       - Execute until it completes or the next process arrives,
+ *         whichever comes first (the only points where it can be preempted)
+ *       - Decrease remaining_time and advance current_time by that amount
  *       - If remaining_time becomes 0:
  *         * Record completion_time
  *         * Increment completed counter
@@ -53,20 +53,20 @@
  * KEY DIFFERENCE FROM SJF:
  * ------------------------
  * - SJF: Non-preemptive, execute entire burst_time at once
- * - SRT: Preemptive, execute 1 time unit, then re-evaluate
+ * - SRT: Preemptive, execute until the next arrival, then re-evaluate
  * - SRT allows newly arrived shorter processes to preempt current process
  * 
  * IMPLEMENTATION HINTS:
  * ---------------------
- * - Execute processes one time unit at a time (not entire burst)
+ * - Jump from event to event: min(next arrival, current job completion)
  * - Use remaining_time (not burst_time) for comparison
- * - At each time unit, check all arrived processes for shortest remaining time
- * - Update remaining_time after each time unit of execution
+ * - At each event, take the heap root (see ready_heap.h) as the shortest job
+ * - Update remaining_time by the length of each execution interval
  * - Record completion_time only when remaining_time becomes 0
  * 
  * COMMON PITFALLS TO AVOID:
  * -------------------------
- * - Don't execute entire remaining_time at once (must be 1 unit at a time)
+ * - Don't run past the next arrival time (it may preempt the current job)
  * - Don't forget to check remaining_time (not burst_time) for selection
  * - Apply all three tie-breaking criteria correctly
  * - Don't calculate waiting_time directly
@@ -76,6 +76,11 @@
  */
 
 #include "CPU_scheduler.h"
+#include "ready_heap.h"
+#include "ready_scan.h"
+#include "scheduler_scratch.h"
+#include "sched_stats.h"
+#include "trace_recorder.h"
 
 /* ========================================================================================*/
 /**
@@ -83,77 +88,108 @@
  * 
  * @param ctx Pointer to the scheduler context containing all process information
  * 
- * This function implements the SRT scheduling algorithm. At each time unit,
+ * This function implements the SRT scheduling algorithm. At each event,
  * it selects the process with the shortest remaining execution time among
  * all arrived processes. Processes can be preempted when a shorter job arrives.
+ *
+ * Arrived processes are kept in a min-heap ordered by remaining_time → arrival_time → pid.
+ * Running the root only lowers its own key, so it stays at the root until it
+ * completes or a new arrival is pushed. The engine therefore advances
+ * current_time straight to min(next arrival, completion of the running job),
+ * which gives the same schedule as stepping one time unit at a time. The loop runs on
+ * the rank-ordered columns (see process_columns.h).
  */
-#include <limits.h>
-#include <stdbool.h>
-
 void shortest_remaining_time_first(SchedulerContext *ctx)
 {
     reset_process_states(ctx);
 
     int n = ctx->num_processes;
-    int current_time = 0;
+    long long current_time = 0;
     int completed = 0;
+    int next_arrival = 0;
 
-    for (int i = 0; i < n; i++) {
-        ctx->processes[i].remaining_time = ctx->processes[i].burst_time;
-    }
+    ProcessColumns local_columns;
+    ProcessColumns *cols = acquire_process_columns(ctx, &local_columns);
+    int *remaining = cols->remaining_time;
 
+    // Small workloads are scheduled by scanning the columns (see ready_scan.h)
+    bool use_heap = (n > READY_SCAN_MAX_PROCESSES);
+    int first_incomplete = 0;                    // Ranks below it are all complete
+    int running = -1;                            // Rank holding the CPU, -1 when idle
+    ReadyHeap ready;
+    if (use_heap) {
+        acquire_ready_heap(ctx, &ready, n);
+    }
 
     while (completed < n) {
-        int shortest = -1;
-        int min_remaining_time = INT_MAX;
+        STATS_COUNT(STAT_LOOP_ITERATIONS);
+        while (next_arrival < n && cols->arrival_time[next_arrival] <= current_time) {
+            if (use_heap) {
+                ready_heap_push(&ready, next_arrival, remaining[next_arrival], next_arrival);
+            }
+            next_arrival++;
+        }
 
-        for (int i = 0; i < n; i++) {
-            Process *p = &ctx->processes[i];
+        while (first_incomplete < next_arrival && remaining[first_incomplete] == 0) {
+            first_incomplete++;
+        }
+        int shortest = use_heap ? ready_heap_peek(&ready)
+                                : ready_scan_argmin(remaining, remaining, first_incomplete, next_arrival);
+        if (shortest < 0) {
+            STATS_COUNT(STAT_IDLE_JUMPS);
+            current_time = cols->arrival_time[next_arrival];
+            continue;
+        }
 
-            if (p->arrival_time <= current_time && p->remaining_time > 0) {
-                if (p->remaining_time < min_remaining_time) {
-                    min_remaining_time = p->remaining_time;
-                    shortest = i;
-                } else if (p->remaining_time == min_remaining_time) {
-                    Process *best = &ctx->processes[shortest];
-                    if (p->arrival_time < best->arrival_time) {
-                        shortest = i;
-                    } else if (p->arrival_time == best->arrival_time) {
-                        if (p->pid < best->pid) {
-                            shortest = i;
-                        }
-                    }
-                }
+        if (shortest != running) {
+            // A job that keeps the CPU across an arrival is not switched to again
+            if (running >= 0) {
+                TRACE_POINT(ctx, TRACE_PREEMPT, ctx->processes[cols->order[running]].pid, current_time);
+                STATS_COUNT(STAT_PREEMPTIONS);
             }
+            current_time += charge_context_switch(ctx, cols->start_time[shortest] >= 0);
+            TRACE_POINT(ctx, TRACE_DISPATCH, ctx->processes[cols->order[shortest]].pid, current_time);
+            STATS_COUNT(STAT_DISPATCHES);
+            running = shortest;
         }
-        if (shortest == -1) {
-            int next_arrival = INT_MAX;
-            for (int i = 0; i < n; i++) {
-                if (ctx->processes[i].remaining_time > 0 &&
-                    ctx->processes[i].arrival_time > current_time &&
-                    ctx->processes[i].arrival_time < next_arrival) {
-                    next_arrival = ctx->processes[i].arrival_time;
-                }
-            }
 
-            if (next_arrival != INT_MAX) {
-                current_time = next_arrival;
-                continue;
-            } else {
-                break;
+        // Run the shortest job until it finishes or the next arrival can preempt it;
+        // an arrival during the switch re-evaluates the choice before any work is done
+        int run_time = remaining[shortest];
+        if (next_arrival < n) {
+            long long until_arrival = cols->arrival_time[next_arrival] - current_time;
+            if (until_arrival < run_time) {
+                run_time = (until_arrival > 0) ? (int)until_arrival : 0;
             }
         }
 
-        ctx->processes[shortest].remaining_time--;
-        current_time++;
+        if (cols->start_time[shortest] < 0 && run_time > 0) {
+            cols->start_time[shortest] = current_time;
+        }
+        remaining[shortest] -= run_time;
+        current_time += run_time;
 
-        if (ctx->processes[shortest].remaining_time == 0) {
-            ctx->processes[shortest].completion_time = current_time;
+        if (remaining[shortest] == 0) {
+            if (use_heap) {
+                ready_heap_pop(&ready);
+            }
+            cols->completion_time[shortest] = current_time;
             completed++;
+            TRACE_POINT(ctx, TRACE_COMPLETE, ctx->processes[cols->order[shortest]].pid, current_time);
+            running = -1;
+        } else if (use_heap) {
+            // Lowering the root's key keeps it at the root, so this is O(1)
+            ready_heap_update(&ready, shortest, remaining[shortest]);
         }
     }
 
-    display_results(ctx, "Shortest-Remaining_Time-First (SRTF)");
+    if (use_heap) {
+        release_ready_heap(ctx, &ready);
+    }
+    process_columns_store(cols, ctx);
+    release_process_columns(ctx, cols);
+
+    display_results(ctx, SCHEDULER_ALGORITHMS[ALGORITHM_SRTF].title);
 }
 
 
@@ -187,7 +223,7 @@ void shortest_remaining_time_first(SchedulerContext *ctx)
  * 
  * DEBUGGING TIPS:
  * ---------------
- * - Print which process executes at each time unit
+ * - Print which process executes in each interval between events
  * - Track remaining_time for each process at every step
  * - Verify preemptions occur when shorter process arrives
  * - Check that processes are compared by remaining_time (not burst_time)
@@ -196,7 +232,7 @@ void shortest_remaining_time_first(SchedulerContext *ctx)
  * 
  * COMMON MISTAKES:
  * ----------------
- * - Executing more than 1 time unit (must execute exactly 1 unit for preemption)
+ * - Running past the next arrival (a shorter job may need to preempt there)
  * - Using burst_time instead of remaining_time for comparison
  * - Not applying tie-breaking rules in correct order
  * - Recording completion_time before remaining_time becomes 0